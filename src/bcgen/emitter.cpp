@@ -20,6 +20,15 @@ namespace Minuet::Codegen {
     using Runtime::Code::Chunk;
     using Runtime::Code::Program;
 
+    /// NOTE: A loop or if-else check whose condition was folded became a plain `jump` or `nop`, so only a remaining branch takes its target as `args[1]`.
+    static void patch_check_target(Instruction& check, int16_t target_ip) noexcept {
+        if (check.op == Opcode::jump) {
+            check.args[0] = target_ip;
+        } else if (check.op != Opcode::nop) {
+            check.args[1] = target_ip;
+        }
+    }
+
     Emitter::Emitter()
     : m_result_chunks {}, m_active_ifs {}, m_active_loops {}, m_next_fun_id {0} {}
 
@@ -136,6 +145,8 @@ namespace Minuet::Codegen {
                 case Op::mul: return Opcode::mul;
                 case Op::div: return Opcode::div;
                 case Op::mod: return Opcode::mod;
+                case Op::shr: return Opcode::shr;
+                case Op::bit_and: return Opcode::bit_and;
                 case Op::add: return Opcode::add;
                 case Op::sub: return Opcode::sub;
                 case Op::equ: return Opcode::equ;
@@ -204,14 +215,23 @@ namespace Minuet::Codegen {
 
             const auto& [break_ips, continuing_ips, loop_begin, loop_check_ip, loop_end] = m_active_loops.back();
 
-            m_result_chunks.back()[loop_check_ip].args[1] = loop_end;
+            /// NOTE: Both `jump_else` and `iter_next_or_jump` take the loop's exit target as `args[1]`.
+            patch_check_target(m_result_chunks.back()[loop_check_ip], loop_end);
 
             for (const auto& brk_jump_ip : break_ips) {
                 m_result_chunks.back()[brk_jump_ip].args[0] = loop_end;
             }
 
+            /// NOTE: continuing jumps are the loop's back-edges, so they're marked as GC safepoints too.
             for (const auto& cnt_jump_ip : continuing_ips) {
-                m_result_chunks.back()[cnt_jump_ip].args[0] = loop_begin;
+                auto& cnt_jump = m_result_chunks.back()[cnt_jump_ip];
+
+                cnt_jump.args[0] = loop_begin;
+                cnt_jump.args[1] = Runtime::Code::jump_safepoint_flag;
+                cnt_jump.metadata = Utils::encode_metadata(
+                    Utils::PseudoArg {.value = cnt_jump.args[0], .tag = ArgMode::immediate},
+                    Utils::PseudoArg {.value = cnt_jump.args[1], .tag = ArgMode::immediate}
+                );
             }
 
             m_active_loops.pop_back(); // NOTE: the most recent active loop ref dangles, but it's OK because its usage has certainly finished here.
@@ -241,10 +261,10 @@ namespace Minuet::Codegen {
             const auto [ie_check_ip, ie_alt_ip, ie_end_ip] = m_active_ifs.back();
 
             if (ie_alt_ip != -1) {
-                m_result_chunks.back()[ie_check_ip].args[1] = ie_alt_ip + 1;
+                patch_check_target(m_result_chunks.back()[ie_check_ip], ie_alt_ip + 1);
                 m_result_chunks.back()[ie_alt_ip].args[0] = ie_end_ip;
             } else {
-                m_result_chunks.back()[ie_check_ip].args[1] = ie_end_ip;
+                patch_check_target(m_result_chunks.back()[ie_check_ip], ie_end_ip);
             }
 
             m_active_ifs.pop_back();
@@ -269,6 +289,7 @@ namespace Minuet::Codegen {
         const auto opcode_opt = ([](Op ir_op) noexcept -> std::optional<Opcode> {
             switch (ir_op) {
                 case Op::make_seq: return Opcode::make_seq;
+                case Op::make_dict: return Opcode::make_dict;
                 case Op::frz_seq_obj: return Opcode::frz_seq_obj;
                 case Op::jump: return Opcode::jump;
                 case Op::ret: return Opcode::ret;
@@ -308,10 +329,10 @@ namespace Minuet::Codegen {
         const auto opcode_opt = ([](Op ir_op) noexcept -> std::optional<Opcode> {
             switch (ir_op) {
                 case Op::make_str: return Opcode::make_str;
+                case Op::load_obj: return Opcode::load_obj;
+                case Op::iter_init: return Opcode::iter_init;
                 case Op::jump_if: return Opcode::jump_if;
                 case Op::jump_else: return Opcode::jump_else;
-                case Op::call: return Opcode::call;
-                case Op::native_call: return Opcode::native_call;
                 default: return {};
             }
         })(op);
@@ -350,6 +371,13 @@ namespace Minuet::Codegen {
             switch (op) {
             case Op::seq_obj_push: return Opcode::seq_obj_push;
             case Op::seq_obj_get: return Opcode::seq_obj_get;
+            case Op::seq_obj_get_unchecked: return Opcode::seq_obj_get_unchecked;
+            case Op::seq_obj_set: return Opcode::seq_obj_set;
+            case Op::dict_get: return Opcode::dict_get;
+            case Op::dict_set: return Opcode::dict_set;
+            case Op::iter_next_or_jump: return Opcode::iter_next_or_jump;
+            case Op::call: return Opcode::call;
+            case Op::native_call: return Opcode::native_call;
             default: return {};
             }
         })(op);
@@ -1,11 +1,22 @@
+#include <array>
 #include <set>
 #include <stack>
 #include <chrono>
 #include <memory>
 #include <iostream>
+#include <utility>
+#include <string_view>
 
 #include "semantics/analyzer.hpp"
 #include "ir/convert_ast.hpp"
+#include "ir/bounds_elision.hpp"
+#include "ir/inlining.hpp"
+#include "ir/ssa.hpp"
+#include "ir/const_propagation.hpp"
+#include "ir/copy_propagation.hpp"
+#include "ir/loop_invariants.hpp"
+#include "ir/strength_reduction.hpp"
+#include "ir/register_allocation.hpp"
 #include "bcgen/emitter.hpp"
 #include "runtime/vm.hpp"
 #include "driver/sources.hpp"
@@ -27,12 +38,38 @@ namespace Minuet::Driver {
     using Sources::read_source;
 
     static constexpr auto normal_vm_config = EngineConfig {
+        .heap_config = Runtime::HeapStorage::default_config(),
+        .heap_snapshot_path = {},
         .reg_buffer_limit = 8192,
         .call_frame_max = 512,
     };
 
+    /// NOTE: Callees with more steps than this (not counting markers) are never inlined, so that callers don't bloat.
+    static constexpr auto inline_step_budget = 24;
+
+    /// NOTE: These natives never remove any sequence's items, so loops calling them can still have their element accesses proven in-bounds. Any native missing here is conservatively assumed to shrink sequences.
+    static constexpr std::array<std::string_view, 32> length_keeping_natives = {
+        "print", "prompt_int", "prompt_float", "readln",
+        "len_of", "list_push_back", "list_concat", "list_sort", "list_sort_desc",
+        "int_array", "float_array", "arr_sum", "arr_min", "arr_max", "arr_dot", "arr_scale", "arr_add",
+        "dict_has", "dict_del", "dict_keys",
+        "strlen", "strcat", "substr", "str_find", "str_count", "str_split", "str_replace", "intern",
+        "stoi", "stof", "get_argv", "dump_heap",
+    };
+
+    /// NOTE: These natives only read their arguments and give a plain value, so a loop which changes neither may call them once before it instead. Any native missing here is conservatively assumed to have effects.
+    static constexpr std::array<std::string_view, 11> pure_natives = {
+        "len_of", "strlen", "dict_has", "str_find", "str_count",
+        "arr_sum", "arr_min", "arr_max", "arr_dot", "stoi", "stof",
+    };
+
+    /// NOTE: These natives aren't pure, but never change an existing heap object either, so they don't keep pure calls in the same loop from moving.
+    static constexpr std::array<std::string_view, 6> reading_natives = {
+        "print", "prompt_int", "prompt_float", "readln", "get_argv", "dump_heap",
+    };
+
     Driver::Driver()
-    : m_lexer {}, m_src_map {}, m_native_procs {}, m_native_proc_ids {}, m_ir_printer {}, m_disassembler {} {
+    : m_lexer {}, m_src_map {}, m_native_procs {}, m_native_proc_ids {}, m_ir_printer {}, m_disassembler {}, m_heap_snapshot_path {}, m_heap_config {normal_vm_config.heap_config}, m_opt_level {max_opt_level} {
         m_lexer.add_lexical_item({.text = "true", .tag = TokenType::literal_true});
         m_lexer.add_lexical_item({.text = "false", .tag = TokenType::literal_false});
         m_lexer.add_lexical_item({.text = "fn", .tag = TokenType::keyword_fn});
@@ -49,6 +86,8 @@ namespace Minuet::Driver {
         m_lexer.add_lexical_item({.text = "return", .tag = TokenType::keyword_return});
         m_lexer.add_lexical_item({.text = "while", .tag = TokenType::keyword_while});
         m_lexer.add_lexical_item({.text = "break", .tag = TokenType::keyword_break});
+        m_lexer.add_lexical_item({.text = "for", .tag = TokenType::keyword_for});
+        m_lexer.add_lexical_item({.text = "in", .tag = TokenType::keyword_in});
         m_lexer.add_lexical_item({.text = "*", .tag = TokenType::oper_times});
         m_lexer.add_lexical_item({.text = "/", .tag = TokenType::oper_slash});
         m_lexer.add_lexical_item({.text = "%", .tag = TokenType::oper_modulo});
@@ -141,14 +180,97 @@ namespace Minuet::Driver {
         return ir_generator(ast, m_src_map);
     }
 
-    auto Driver::apply_ir_passes([[maybe_unused]] IR::CFG::FullIR& ir) -> bool {
-        // IR::Pass::MovTrimmer opt_movs_pass;
+    auto Driver::apply_ir_passes(IR::CFG::FullIR& ir) -> bool {
+        if (m_opt_level < 1) {
+            return true;
+        }
+
+        /// NOTE: Inlining goes first so that the later passes see through the substituted calls. A callee defined before its caller was already inlined into, so chains of small functions collapse too.
+        if (m_opt_level >= 2) {
+            IR::Pass::Inliner inlining_pass {ir.cfg_list, inline_step_budget};
+
+            for (auto& cfg : ir.cfg_list) {
+                if (!inlining_pass.apply(cfg)) {
+                    return false;
+                }
+            }
+        }
+
+        IR::Pass::SSAConstruction ssa_pass;
+
+        /// NOTE: A CFG whose flow can't be traced is just left as is, since SSA only enables the optimizations.
+        for (auto& cfg : ir.cfg_list) {
+            if (auto ssa_opt = ssa_pass.apply(cfg); ssa_opt) {
+                IR::Pass::ConstPropagator const_pass {ssa_opt.value(), ir.constants};
+                IR::Pass::CopyPropagator copy_pass {ssa_opt.value()};
+                IR::Pass::SSADestruction leaving_pass {ssa_opt.value()};
+
+                if (!const_pass.apply(cfg) || !copy_pass.apply(cfg) || !leaving_pass.apply(cfg)) {
+                    return false;
+                }
+            }
+        }
+
+        /// NOTE: Without `len_of`, no loop bound can be proven, so there are no sequence accesses to unguard.
+        if (const auto len_of_it = m_native_proc_ids.find("len_of"); len_of_it != m_native_proc_ids.end()) {
+            std::set<int> keeping_native_ids;
+
+            for (const auto native_name : length_keeping_natives) {
+                if (const auto native_it = m_native_proc_ids.find(std::string {native_name}); native_it != m_native_proc_ids.end()) {
+                    keeping_native_ids.insert(native_it->second);
+                }
+            }
+
+            IR::Pass::BoundsCheckElider bounds_pass {ir.constants, len_of_it->second, std::move(keeping_native_ids)};
+
+            for (auto& cfg : ir.cfg_list) {
+                if (!bounds_pass.apply(cfg)) {
+                    return false;
+                }
+            }
+        }
+
+        std::set<int> pure_native_ids;
+        std::set<int> reading_native_ids;
 
-        // for (const auto& cfg : ir.cfg_list) {
-        //     if (!opt_movs_pass.apply(cfg)) {
-        //         return false;
-        //     }
-        // }
+        for (const auto native_name : pure_natives) {
+            if (const auto native_it = m_native_proc_ids.find(std::string {native_name}); native_it != m_native_proc_ids.end()) {
+                pure_native_ids.insert(native_it->second);
+            }
+        }
+
+        for (const auto native_name : reading_natives) {
+            if (const auto native_it = m_native_proc_ids.find(std::string {native_name}); native_it != m_native_proc_ids.end()) {
+                reading_native_ids.insert(native_it->second);
+            }
+        }
+
+        /// NOTE: Invariants only move out of loops after bounds checks are elided, since those proofs match the `len_of` call within each loop check.
+        IR::Pass::LoopInvariantMover licm_pass {std::move(pure_native_ids), std::move(reading_native_ids)};
+
+        for (auto& cfg : ir.cfg_list) {
+            if (!licm_pass.apply(cfg)) {
+                return false;
+            }
+        }
+
+        /// NOTE: Counter arithmetic is reduced after invariants move out, so that scales and offsets computed from invariants are already set before each loop.
+        IR::Pass::StrengthReducer reducing_pass {ir.constants};
+
+        for (auto& cfg : ir.cfg_list) {
+            if (!reducing_pass.apply(cfg)) {
+                return false;
+            }
+        }
+
+        /// NOTE: Registers are given out last, as the other passes rely on each temporary being its own.
+        IR::Pass::RegisterAllocator alloc_pass;
+
+        for (auto& cfg : ir.cfg_list) {
+            if (!alloc_pass.apply(cfg)) {
+                return false;
+            }
+        }
 
         return true;
     }
@@ -167,6 +289,18 @@ namespace Minuet::Driver {
         m_disassembler = std::make_unique<Disassembler>(bc_printer);
     }
 
+    void Driver::set_heap_config(Runtime::HeapConfig heap_config) noexcept {
+        m_heap_config = heap_config;
+    }
+
+    void Driver::set_heap_snapshot_path(std::string heap_snapshot_path) noexcept {
+        m_heap_snapshot_path = std::move(heap_snapshot_path);
+    }
+
+    void Driver::set_opt_level(int opt_level) noexcept {
+        m_opt_level = opt_level;
+    }
+
     auto Driver::operator()(const std::filesystem::path& entry_source_path, std::vector<std::string> program_args) -> bool {
         auto parsed_program = parse_sources(entry_source_path);
 
@@ -206,7 +340,11 @@ namespace Minuet::Driver {
             return true;
         }
 
-        Runtime::VM::Engine vm {normal_vm_config, program, &m_native_procs, std::move(program_args)};
+        auto vm_config = normal_vm_config;
+        vm_config.heap_config = m_heap_config;
+        vm_config.heap_snapshot_path = m_heap_snapshot_path;
+
+        Runtime::VM::Engine vm {vm_config, program, &m_native_procs, std::move(program_args)};
 
         auto run_start = std::chrono::steady_clock::now();
         const auto exec_status = vm();
@@ -214,6 +352,11 @@ namespace Minuet::Driver {
 
         std::println("Finished in: {}\n", std::chrono::duration_cast<std::chrono::milliseconds>(run_end - run_start));
 
+        /// NOTE: With a snapshot file given, the heap's final state is always recorded for post-mortem checks of what was never freed.
+        if (!m_heap_snapshot_path.empty() && !vm.dump_heap_snapshot()) {
+            std::println(std::cerr, "Failed to write heap snapshot to '{}'", m_heap_snapshot_path);
+        }
+
         switch (exec_status) {
             case ExecStatus::ok:
                 std::println("\033[1;32mStatus OK\033[0m\n");
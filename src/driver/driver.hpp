@@ -3,10 +3,12 @@
 
 #include <optional>
 #include <filesystem>
+#include <string>
 #include "frontend/lexing.hpp"
 #include "frontend/parsing.hpp"
 #include "ir/cfg.hpp"
 #include "runtime/bytecode.hpp"
+#include "runtime/heap_storage.hpp"
 #include "runtime/natives.hpp"
 #include "driver/plugins/printer.hpp"
 #include "driver/plugins/ir_dumper.hpp"
@@ -15,6 +17,9 @@
 namespace Minuet::Driver {
     class Driver {
     public:
+        /// NOTE: Level 0 runs no IR passes. Level 1 runs the SSA-based optimizations, bounds check elision, and register allocation. Level 2 also inlines small functions first.
+        static constexpr auto max_opt_level = 2;
+
         Driver();
 
         [[maybe_unused]] auto register_native_proc(const Runtime::NativeProcItem& item) -> bool;
@@ -34,6 +39,9 @@ namespace Minuet::Driver {
 
         void add_ir_dumper(Plugins::IRDumper ir_printer) noexcept;
         void add_disassembler(Plugins::Disassembler bc_printer) noexcept;
+        void set_heap_config(Runtime::HeapConfig heap_config) noexcept;
+        void set_heap_snapshot_path(std::string heap_snapshot_path) noexcept;
+        void set_opt_level(int opt_level) noexcept;
 
     private:
         Frontend::Lexing::Lexer m_lexer;
@@ -42,6 +50,9 @@ namespace Minuet::Driver {
         Runtime::NativeProcRegistry m_native_proc_ids;
         std::unique_ptr<Plugins::Printer> m_ir_printer;
         std::unique_ptr<Plugins::Printer> m_disassembler;
+        std::string m_heap_snapshot_path;
+        Runtime::HeapConfig m_heap_config;
+        int m_opt_level;
     };
 }
 
@@ -68,7 +68,7 @@ namespace Minuet::Driver::Plugins {
                 fmt_step_arg(oper_binary_p->arg_1)
             );
         } else if (const auto oper_ternary_p = std::get_if<IR::Steps::OperTernary>(&step); oper_ternary_p) {
-            std::print("{} {} {}",
+            std::print("{} {} {} {}",
                 ir_op_name(oper_ternary_p->op),
                 fmt_step_arg(oper_ternary_p->arg_0),
                 fmt_step_arg(oper_ternary_p->arg_1),
@@ -23,6 +23,8 @@ namespace Minuet::Frontend::Lexicals {
         keyword_return,
         keyword_while,
         keyword_break,
+        keyword_for,
+        keyword_in,
         identifier,
         literal_false,
         literal_true,
@@ -109,10 +109,19 @@ namespace Minuet::Frontend::Parsing {
 
         std::vector<ExprPtr> items;
 
+        /// NOTE: A brace literal is a dictionary if its first item is followed by a colon, or if it's just `{:}`.
+        if (!is_tuple && match(m_current, TokenType::colon)) {
+            return parse_dictionary(lexer, src, nullptr);
+        }
+
         if (!match(m_current, expected_end_tkn)) {
             items.emplace_back(parse_primary(lexer, src));
         }
 
+        if (!is_tuple && match(m_current, TokenType::colon)) {
+            return parse_dictionary(lexer, src, std::move(items.back()));
+        }
+
         while (!match(m_current, TokenType::eof)) {
             if (!match(m_current, TokenType::comma)) {
                 break;
@@ -131,6 +140,39 @@ namespace Minuet::Frontend::Parsing {
         });
     }
 
+    auto Parser::parse_dictionary(Lexing::Lexer& lexer, std::string_view src, ExprPtr first_key) -> Syntax::Exprs::ExprPtr {
+        std::vector<ExprPtr> keys;
+        std::vector<ExprPtr> values;
+
+        if (!first_key) {
+            consume(lexer, src, TokenType::colon);
+        } else {
+            keys.emplace_back(std::move(first_key));
+
+            consume(lexer, src, TokenType::colon);
+            values.emplace_back(parse_primary(lexer, src));
+
+            while (!match(m_current, TokenType::eof)) {
+                if (!match(m_current, TokenType::comma)) {
+                    break;
+                }
+
+                consume(lexer, src);
+
+                keys.emplace_back(parse_primary(lexer, src));
+                consume(lexer, src, TokenType::colon);
+                values.emplace_back(parse_primary(lexer, src));
+            }
+        }
+
+        consume(lexer, src, TokenType::close_brace);
+
+        return std::make_unique<Expr>(Syntax::Exprs::Dictionary {
+            .keys = std::move(keys),
+            .values = std::move(values),
+        });
+    }
+
     auto Parser::parse_primary(Lexing::Lexer& lexer, std::string_view src) -> ExprPtr {
         const auto temp_token_copy = m_current;
 
@@ -594,6 +636,30 @@ namespace Minuet::Frontend::Parsing {
         });
     }
 
+    auto Parser::parse_for(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr {
+        const auto stmt_begin = m_current.start;
+        consume(lexer, src, TokenType::keyword_for);
+        consume(lexer, src, TokenType::identifier);
+
+        const auto name_token = m_previous;
+
+        consume(lexer, src, TokenType::keyword_in);
+
+        auto iterable_expr = parse_compare(lexer, src);
+        auto body_block = parse_block(lexer, src);
+        const auto stmt_end = m_current.start;
+
+        return std::make_unique<Stmt>(Stmt {
+            .data = Syntax::Stmts::For {
+                .name = name_token,
+                .iterable = std::move(iterable_expr),
+                .body = std::move(body_block),
+            },
+            .src_begin = stmt_begin,
+            .src_end = stmt_end,
+        });
+    }
+
     auto Parser::parse_break(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr {
         consume(lexer, src, TokenType::keyword_break);
 
@@ -628,6 +694,8 @@ namespace Minuet::Frontend::Parsing {
                     return parse_return(lexer, src);
                 case TokenType::keyword_while:
                     return parse_while(lexer, src);
+                case TokenType::keyword_for:
+                    return parse_for(lexer, src);
                 case TokenType::keyword_break:
                     return parse_break(lexer, src);
                 default:
@@ -45,6 +45,7 @@ namespace Minuet::Frontend::Parsing {
         [[nodiscard]] auto parse_literal(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Exprs::ExprPtr;
         [[nodiscard]] auto parse_primary(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Exprs::ExprPtr;
         [[nodiscard]] auto parse_sequence(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Exprs::ExprPtr;
+        [[nodiscard]] auto parse_dictionary(Lexing::Lexer& lexer, std::string_view src, Syntax::Exprs::ExprPtr first_key) -> Syntax::Exprs::ExprPtr;
         [[nodiscard]] auto parse_lambda(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Exprs::ExprPtr;
         [[nodiscard]] auto parse_lhs(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Exprs::ExprPtr;
         [[nodiscard]] auto parse_call(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Exprs::ExprPtr;
@@ -63,6 +64,7 @@ namespace Minuet::Frontend::Parsing {
         // [[nodiscard]] auto parse_match(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr;
         [[nodiscard]] auto parse_return(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr;
         [[nodiscard]] auto parse_while(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr;
+        [[nodiscard]] auto parse_for(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr;
         [[nodiscard]] auto parse_break(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr;
         [[nodiscard]] auto parse_block(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr;
         [[nodiscard]] auto parse_function(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr;
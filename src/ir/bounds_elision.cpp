@@ -0,0 +1,295 @@
+#include <utility>
+#include <variant>
+
+#include "ir/bounds_elision.hpp"
+
+namespace Minuet::IR::Pass {
+    using Steps::Op;
+    using Steps::AbsAddrTag;
+    using Steps::AbsAddress;
+    using Steps::TACUnary;
+    using Steps::TACBinary;
+    using Steps::OperBinary;
+    using Steps::OperTernary;
+
+    /// NOTE: Control may enter or leave a block's steps at these, so straight-line reasoning has to stop there.
+    [[nodiscard]] static constexpr auto is_flow_boundary(Op op) noexcept -> bool {
+        switch (op) {
+        case Op::jump:
+        case Op::jump_if:
+        case Op::jump_else:
+        case Op::iter_next_or_jump:
+        case Op::ret:
+        case Op::halt:
+        case Op::meta_begin_while:
+        case Op::meta_end_while:
+        case Op::meta_mark_while_check:
+        case Op::meta_mark_break:
+        case Op::meta_mark_continue:
+        case Op::meta_end_if_else:
+        case Op::meta_mark_if_else_alt:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    BoundsCheckElider::BoundsCheckElider(std::span<const Runtime::FastValue> constants, int len_of_id, std::set<int> keeping_native_ids) noexcept
+    : m_constants {constants}, m_keeping_native_ids (std::move(keeping_native_ids)), m_len_of_id {len_of_id} {}
+
+    auto BoundsCheckElider::is_nonneg_int_constant(AbsAddress aa) const noexcept -> bool {
+        if (aa.tag != AbsAddrTag::constant || aa.id < 0 || static_cast<std::size_t>(aa.id) >= m_constants.size()) {
+            return false;
+        }
+
+        const auto& constant = m_constants[aa.id];
+
+        return constant.tag() == Runtime::FVTag::int32 && constant.to_scalar().value_or(-1) >= 0;
+    }
+
+    auto BoundsCheckElider::is_length_keeping(const Steps::Step& step) const noexcept -> bool {
+        switch (Steps::step_op(step)) {
+        case Op::seq_obj_pop:
+        case Op::call:
+            return false;
+        case Op::native_call:
+            return m_keeping_native_ids.contains(std::get<OperTernary>(step).arg_0.id);
+        default:
+            return true;
+        }
+    }
+
+    auto BoundsCheckElider::match_loop_check(const CFG::CFG& cfg, int check_bb_id) const noexcept -> std::optional<LoopCheck> {
+        const auto& check_steps = cfg.get_bb(check_bb_id).value()->steps;
+        const int check_steps_n = check_steps.size();
+
+        // 1. Find the loop check, which ends with a `jump_else` on the comparison's result.
+        auto mark_pos = check_steps_n - 1;
+
+        while (mark_pos >= 0 && Steps::step_op(check_steps[mark_pos]) != Op::meta_mark_while_check) {
+            --mark_pos;
+        }
+
+        if (mark_pos < 1) {
+            return {};
+        }
+
+        const auto jump_p = std::get_if<OperBinary>(&check_steps[mark_pos - 1]);
+
+        if (!jump_p || jump_p->op != Op::jump_else) {
+            return {};
+        }
+
+        // 2. Match `i < len` or `len > i` as the check's comparison.
+        auto cmp_pos = mark_pos - 2;
+
+        while (cmp_pos >= 0 && Steps::step_dest(check_steps[cmp_pos]) != jump_p->arg_0) {
+            --cmp_pos;
+        }
+
+        const auto cmp_p = (cmp_pos >= 0) ? std::get_if<TACBinary>(&check_steps[cmp_pos]) : nullptr;
+
+        if (!cmp_p || (cmp_p->op != Op::lt && cmp_p->op != Op::gt)) {
+            return {};
+        }
+
+        const auto [counter_aa, length_aa] = (cmp_p->op == Op::lt)
+            ? std::pair {cmp_p->arg_0, cmp_p->arg_1}
+            : std::pair {cmp_p->arg_1, cmp_p->arg_0};
+
+        if (counter_aa.tag != AbsAddrTag::temp || length_aa.tag != AbsAddrTag::temp) {
+            return {};
+        }
+
+        // 3. Match `len = len_of(xs)`, whose argument is staged into the call's result slot just before.
+        auto call_pos = cmp_pos - 1;
+
+        while (call_pos >= 0 && Steps::step_dest(check_steps[call_pos]) != length_aa) {
+            --call_pos;
+        }
+
+        const auto call_p = (call_pos >= 1) ? std::get_if<OperTernary>(&check_steps[call_pos]) : nullptr;
+
+        if (!call_p || call_p->op != Op::native_call || call_p->arg_0.id != m_len_of_id || call_p->arg_1.id != 1) {
+            return {};
+        }
+
+        const auto stage_p = std::get_if<TACUnary>(&check_steps[call_pos - 1]);
+
+        if (!stage_p || stage_p->op != Op::nop || stage_p->dest != length_aa || stage_p->arg_0.tag != AbsAddrTag::temp || stage_p->arg_0 == counter_aa) {
+            return {};
+        }
+
+        const auto sequence_aa = stage_p->arg_0;
+        auto begin_pos = call_pos - 1;
+
+        while (begin_pos >= 0 && Steps::step_op(check_steps[begin_pos]) != Op::meta_begin_while) {
+            --begin_pos;
+        }
+
+        if (begin_pos < 0) {
+            return {};
+        }
+
+        // 4. Nothing after the length is taken may change the counter, the sequence, or its length.
+        for (auto step_pos = call_pos + 1; step_pos < mark_pos - 1; ++step_pos) {
+            const auto& step = check_steps[step_pos];
+            const auto step_dest_opt = Steps::step_dest(step);
+
+            if (step_dest_opt == counter_aa || step_dest_opt == sequence_aa || !is_length_keeping(step)) {
+                return {};
+            }
+        }
+
+        // 5. The body starts in the very next block, and the loop ends at the block with its matching `#end_while`.
+        const auto body_id = check_bb_id + 1;
+        auto loop_depth = 1;
+
+        for (auto bb_id = body_id; bb_id < cfg.bb_count(); ++bb_id) {
+            for (const auto& step : cfg.get_bb(bb_id).value()->steps) {
+                if (const auto step_op = Steps::step_op(step); step_op == Op::meta_begin_while) {
+                    ++loop_depth;
+                } else if (step_op == Op::meta_end_while) {
+                    --loop_depth;
+                }
+            }
+
+            if (loop_depth == 0) {
+                return LoopCheck {
+                    .counter = counter_aa,
+                    .sequence = sequence_aa,
+                    .check_id = check_bb_id,
+                    .check_pos = begin_pos,
+                    .body_id = body_id,
+                    .post_id = bb_id,
+                };
+            }
+        }
+
+        return {};
+    }
+
+    auto BoundsCheckElider::is_bounded_counter(const CFG::CFG& cfg, const LoopCheck& loop) const noexcept -> bool {
+        // 1. The counter's first use must be its initialization to a non-negative integer. Control must not leave the branch or loop enclosing it before reaching the check, so that it surely runs first.
+        auto init_depth = -1;
+        auto construct_depth = 0;
+
+        for (auto bb_id = 0; bb_id <= loop.check_id; ++bb_id) {
+            const auto& steps = cfg.get_bb(bb_id).value()->steps;
+            const int scan_end = (bb_id == loop.check_id) ? loop.check_pos : steps.size();
+
+            for (auto step_pos = 0; step_pos < scan_end; ++step_pos) {
+                const auto& step = steps[step_pos];
+
+                if (const auto step_op = Steps::step_op(step); step_op == Op::meta_begin_while || step_op == Op::meta_begin_if_else) {
+                    ++construct_depth;
+                } else if (step_op == Op::meta_end_while || step_op == Op::meta_end_if_else) {
+                    --construct_depth;
+                }
+
+                if (init_depth != -1) {
+                    if (construct_depth < init_depth) {
+                        return false;
+                    }
+
+                    continue;
+                }
+
+                if (!Steps::step_mentions(step, loop.counter)) {
+                    continue;
+                }
+
+                if (const auto init_p = std::get_if<TACUnary>(&step); !init_p || init_p->op != Op::nop || init_p->dest != loop.counter || !is_nonneg_int_constant(init_p->arg_0)) {
+                    return false;
+                }
+
+                init_depth = construct_depth;
+            }
+        }
+
+        if (init_depth == -1) {
+            return false;
+        }
+
+        // 2. Every other write must be a non-negative constant or `i = i + step`. Steps are only allowed outside of nested loops in this loop's body, where the check already bounded `i` below the length, so each iteration grows `i` by a bounded amount past it at most.
+        auto nested_depth = 0;
+
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            const auto& steps = cfg.get_bb(bb_id).value()->steps;
+            const auto in_body = bb_id >= loop.body_id && bb_id < loop.post_id;
+
+            for (std::size_t step_pos = 0; step_pos < steps.size(); ++step_pos) {
+                const auto& step = steps[step_pos];
+
+                if (in_body) {
+                    if (const auto step_op = Steps::step_op(step); step_op == Op::meta_begin_while) {
+                        ++nested_depth;
+                    } else if (step_op == Op::meta_end_while) {
+                        --nested_depth;
+                    }
+                }
+
+                if (Steps::step_dest(step) != loop.counter) {
+                    continue;
+                }
+
+                const auto write_p = std::get_if<TACUnary>(&step);
+
+                if (write_p && write_p->op == Op::nop && is_nonneg_int_constant(write_p->arg_0)) {
+                    continue;
+                }
+
+                /// NOTE: Copy coalescing may have already folded the sum's copy into `i = i + step`.
+                const auto add_p = (write_p && write_p->op == Op::nop)
+                    ? ((step_pos > 0) ? std::get_if<TACBinary>(&steps[step_pos - 1]) : nullptr)
+                    : std::get_if<TACBinary>(&step);
+                const auto sum_aa = (write_p) ? write_p->arg_0 : loop.counter;
+
+                if (!in_body || nested_depth != 0 || !add_p || add_p->op != Op::add || add_p->dest != sum_aa) {
+                    return false;
+                }
+
+                const auto step_aa = (add_p->arg_0 == loop.counter) ? add_p->arg_1 : add_p->arg_0;
+
+                if ((add_p->arg_0 != loop.counter && add_p->arg_1 != loop.counter) || !is_nonneg_int_constant(step_aa) || m_constants[step_aa.id].to_scalar().value() > cm_max_counter_step) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    auto BoundsCheckElider::elide_accesses(CFG::CFG& cfg, const LoopCheck& loop) const noexcept -> int {
+        auto elided_count = 0;
+
+        for (auto& step : cfg.get_bb(loop.body_id).value()->steps) {
+            if (auto access_p = std::get_if<OperTernary>(&step); access_p && access_p->op == Op::seq_obj_get && access_p->arg_1 == loop.sequence && access_p->arg_2 == loop.counter) {
+                access_p->op = Op::seq_obj_get_unchecked;
+                ++elided_count;
+            }
+
+            const auto step_dest_opt = Steps::step_dest(step);
+
+            if (is_flow_boundary(Steps::step_op(step)) || !is_length_keeping(step) || step_dest_opt == loop.counter || step_dest_opt == loop.sequence) {
+                break;
+            }
+        }
+
+        return elided_count;
+    }
+
+    auto BoundsCheckElider::apply([[maybe_unused]] const CFG::CFG& cfg) -> bool {
+        return true;
+    }
+
+    auto BoundsCheckElider::apply(CFG::CFG& cfg) -> bool {
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            if (auto loop_opt = match_loop_check(cfg, bb_id); loop_opt && is_bounded_counter(cfg, loop_opt.value())) {
+                [[maybe_unused]] auto elided_count = elide_accesses(cfg, loop_opt.value());
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef MINUET_IR_BOUNDS_ELISION_HPP
+#define MINUET_IR_BOUNDS_ELISION_HPP
+
+#include <optional>
+#include <set>
+#include <span>
+
+#include "ir/pass.hpp"
+#include "runtime/fast_value.hpp"
+
+namespace Minuet::IR::Pass {
+    /**
+     * @brief Range analysis of loop counters which turns provably in-bounds `seq_obj_get` steps into `seq_obj_get_unchecked`. The proven shape is `while i < len_of(xs) { ... xs.i ... }` where `i` starts as a non-negative integer constant and only ever grows by small constant steps within that loop's body.
+     * @note An access is only rewritten while it's on the straight-line path right after the loop check, before anything that could reassign `i` or `xs`, call a user function, or call a native which may remove sequence items.
+     */
+    class BoundsCheckElider : public PassBase<bool> {
+    private:
+        /// NOTE: Counters may only step by this much per increment, so that `i + step` can't wrap around for any sequence length the VM can hold.
+        static constexpr auto cm_max_counter_step = 0xffff;
+
+        struct LoopCheck {
+            Steps::AbsAddress counter;
+            Steps::AbsAddress sequence;
+            int check_id;
+            int check_pos;
+            int body_id;
+            int post_id;
+        };
+
+        std::span<const Runtime::FastValue> m_constants;
+        std::set<int> m_keeping_native_ids;
+        int m_len_of_id;
+
+        [[nodiscard]] auto is_nonneg_int_constant(Steps::AbsAddress aa) const noexcept -> bool;
+        [[nodiscard]] auto is_length_keeping(const Steps::Step& step) const noexcept -> bool;
+        [[nodiscard]] auto match_loop_check(const CFG::CFG& cfg, int check_bb_id) const noexcept -> std::optional<LoopCheck>;
+        [[nodiscard]] auto is_bounded_counter(const CFG::CFG& cfg, const LoopCheck& loop) const noexcept -> bool;
+        [[nodiscard]] auto elide_accesses(CFG::CFG& cfg, const LoopCheck& loop) const noexcept -> int;
+
+    public:
+        /**
+         * @brief Constructs the pass.
+         *
+         * @param constants The program's constants, for checking counter initializers and steps.
+         * @param len_of_id The native procedure ID of `len_of`.
+         * @param keeping_native_ids IDs of the native procedures which never remove any sequence's items.
+         */
+        BoundsCheckElider(std::span<const Runtime::FastValue> constants, int len_of_id, std::set<int> keeping_native_ids) noexcept;
+
+        /// NOTE: A read-only CFG can't be rewritten, so this just succeeds.
+        [[nodiscard]] auto apply(const CFG::CFG& cfg) -> bool override;
+        [[nodiscard]] auto apply(CFG::CFG& cfg) -> bool override;
+    };
+}
+
+#endif
@@ -2,7 +2,15 @@
 
 namespace Minuet::IR::CFG {
     CFG::CFG()
-    : m_blocks {} {}
+    : m_blocks {}, m_param_count {0} {}
+
+    auto CFG::get_param_count() const noexcept -> int {
+        return m_param_count;
+    }
+
+    void CFG::set_param_count(int param_count) noexcept {
+        m_param_count = param_count;
+    }
 
     auto CFG::get_head() & noexcept -> std::optional<BasicBlock*> {
         if (m_blocks.empty()) {
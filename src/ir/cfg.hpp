@@ -21,6 +21,7 @@ namespace Minuet::IR::CFG {
 
     private:
         std::vector<BasicBlock> m_blocks;
+        int m_param_count;
 
     public:
         CFG();
@@ -29,6 +30,10 @@ namespace Minuet::IR::CFG {
             return self.m_blocks.size();
         }
 
+        /// @brief Gets how many parameters the function takes, which are its first temporaries.
+        [[nodiscard]] auto get_param_count() const noexcept -> int;
+        void set_param_count(int param_count) noexcept;
+
         [[nodiscard]] auto get_head() & noexcept -> std::optional<BasicBlock*>;
         [[nodiscard]] auto get_head() const& noexcept -> std::optional<const BasicBlock*>;
         [[nodiscard]] auto get_bb(int id) const& noexcept -> std::optional<const BasicBlock*>;
@@ -0,0 +1,590 @@
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <variant>
+
+#include "ir/const_propagation.hpp"
+
+namespace Minuet::IR::Pass {
+    using Steps::Op;
+    using Steps::AbsAddrTag;
+    using Steps::AbsAddress;
+    using Steps::Step;
+    using Steps::TACUnary;
+    using Steps::TACBinary;
+    using Steps::OperNonary;
+    using Steps::OperUnary;
+    using Steps::OperBinary;
+    using Steps::OperTernary;
+    using SSA::StepRef;
+    using Runtime::FVTag;
+    using Runtime::FastValue;
+
+    [[nodiscard]] static constexpr auto is_scalar_tag(FVTag tag) noexcept -> bool {
+        switch (tag) {
+        case FVTag::boolean:
+        case FVTag::chr8:
+        case FVTag::int32:
+        case FVTag::flt64:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    [[nodiscard]] static constexpr auto is_branch(Op op) noexcept -> bool {
+        return op == Op::jump_if || op == Op::jump_else;
+    }
+
+    /// NOTE: Points at the operands which the VM may also fetch from the constant pool. Others only take registers.
+    [[nodiscard]] static auto constant_slots(Step& step) noexcept -> std::array<AbsAddress*, 2> {
+        if (auto tac_unary_p = std::get_if<TACUnary>(&step); tac_unary_p && tac_unary_p->op == Op::nop) {
+            return {&tac_unary_p->arg_0, nullptr};
+        } else if (auto tac_binary_p = std::get_if<TACBinary>(&step); tac_binary_p) {
+            return {&tac_binary_p->arg_0, &tac_binary_p->arg_1};
+        } else if (auto oper_unary_p = std::get_if<OperUnary>(&step); oper_unary_p && oper_unary_p->op == Op::ret) {
+            return {&oper_unary_p->arg_0, nullptr};
+        } else if (auto oper_ternary_p = std::get_if<OperTernary>(&step); oper_ternary_p) {
+            switch (oper_ternary_p->op) {
+            case Op::seq_obj_push:
+                return {&oper_ternary_p->arg_1, nullptr};
+            case Op::seq_obj_get:
+            case Op::seq_obj_get_unchecked:
+            case Op::dict_get:
+                return {&oper_ternary_p->arg_2, nullptr};
+            case Op::seq_obj_set:
+            case Op::dict_set:
+                return {&oper_ternary_p->arg_1, &oper_ternary_p->arg_2};
+            default:
+                break;
+            }
+        }
+
+        return {nullptr, nullptr};
+    }
+
+    ConstPropagator::ConstPropagator(SSA::SSAForm& form, std::vector<FastValue>& constants) noexcept
+    : m_form_p {&form}, m_constants_p {&constants}, m_cells {}, m_uses {}, m_live_edges {}, m_live_blocks {}, m_flow_worklist {}, m_ssa_worklist {} {}
+
+    auto ConstPropagator::is_same_constant(const FastValue& lhs, const FastValue& rhs) noexcept -> bool {
+        if (lhs.tag() != rhs.tag() || !is_scalar_tag(lhs.tag())) {
+            return false;
+        }
+
+        /// NOTE: `-0.0` and `0.0` or two NaNs differ in what they print or compare as, so reals only match bit for bit.
+        if (lhs.tag() == FVTag::flt64) {
+            return std::bit_cast<uint64_t>(lhs.to_real().value()) == std::bit_cast<uint64_t>(rhs.to_real().value());
+        }
+
+        return lhs.to_scalar() == rhs.to_scalar();
+    }
+
+    auto ConstPropagator::meet_cells(const Cell& lhs, const Cell& rhs) noexcept -> Cell {
+        if (lhs.kind == CellKind::top) {
+            return rhs;
+        } else if (rhs.kind == CellKind::top) {
+            return lhs;
+        } else if (lhs.kind == CellKind::constant && rhs.kind == CellKind::constant && is_same_constant(lhs.value, rhs.value)) {
+            return lhs;
+        }
+
+        return Cell {{}, CellKind::bottom};
+    }
+
+    auto ConstPropagator::fold_binary(Op op, const Cell& lhs, const Cell& rhs) -> Cell {
+        if (lhs.kind == CellKind::bottom || rhs.kind == CellKind::bottom) {
+            return Cell {{}, CellKind::bottom};
+        } else if (lhs.kind == CellKind::top || rhs.kind == CellKind::top) {
+            return Cell {{}, CellKind::top};
+        }
+
+        /// NOTE: The arithmetic operators need a mutable copy, like the VM's registers.
+        auto lhs_value = lhs.value;
+        const auto& rhs_value = rhs.value;
+
+        if (lhs_value.tag() == FVTag::int32 && rhs_value.tag() == FVTag::int32) {
+            const int64_t lhs_n = lhs_value.to_scalar().value();
+            const int64_t rhs_n = rhs_value.to_scalar().value();
+            int64_t wide_n = 0;
+
+            switch (op) {
+            case Op::mul:
+                wide_n = lhs_n * rhs_n;
+                break;
+            case Op::div:
+            case Op::mod:
+                /// NOTE: Division by zero is a runtime error, and `INT_MIN / -1` traps the host.
+                if (rhs_n == 0 || (lhs_n == std::numeric_limits<int32_t>::min() && rhs_n == -1)) {
+                    return Cell {{}, CellKind::bottom};
+                }
+                break;
+            case Op::add:
+                wide_n = lhs_n + rhs_n;
+                break;
+            case Op::sub:
+                wide_n = lhs_n - rhs_n;
+                break;
+            default:
+                break;
+            }
+
+            if (wide_n < std::numeric_limits<int32_t>::min() || wide_n > std::numeric_limits<int32_t>::max()) {
+                return Cell {{}, CellKind::bottom};
+            }
+        }
+
+        FastValue result;
+
+        switch (op) {
+        case Op::mul:
+            result = lhs_value * rhs_value;
+            break;
+        case Op::div:
+            result = lhs_value / rhs_value;
+            break;
+        case Op::mod:
+            result = lhs_value % rhs_value;
+            break;
+        case Op::add:
+            result = lhs_value + rhs_value;
+            break;
+        case Op::sub:
+            result = lhs_value - rhs_value;
+            break;
+        case Op::equ:
+            result = lhs_value == rhs_value;
+            break;
+        case Op::neq:
+            result = lhs_value != rhs_value;
+            break;
+        case Op::lt:
+            result = lhs_value < rhs_value;
+            break;
+        case Op::gt:
+            result = lhs_value > rhs_value;
+            break;
+        case Op::lte:
+            result = lhs_value <= rhs_value;
+            break;
+        case Op::gte:
+            result = lhs_value >= rhs_value;
+            break;
+        default:
+            break;
+        }
+
+        /// NOTE: A dud result is either a runtime error or a mismatch of operand types, which are both left to the VM.
+        if (result.is_none()) {
+            return Cell {{}, CellKind::bottom};
+        }
+
+        return Cell {result, CellKind::constant};
+    }
+
+    auto ConstPropagator::get_cell(AbsAddress aa) const noexcept -> Cell {
+        if (aa.tag == AbsAddrTag::constant) {
+            const auto& constants = *m_constants_p;
+
+            if (aa.id >= 0 && static_cast<std::size_t>(aa.id) < constants.size() && is_scalar_tag(constants[aa.id].tag())) {
+                return Cell {constants[aa.id], CellKind::constant};
+            }
+        } else if (m_form_p->is_version(aa)) {
+            return m_cells[aa.id];
+        }
+
+        return Cell {{}, CellKind::bottom};
+    }
+
+    auto ConstPropagator::intern_constant(const FastValue& value) -> std::optional<AbsAddress> {
+        auto& constants = *m_constants_p;
+        const int constant_count = constants.size();
+
+        for (auto constant_id = 0; constant_id < constant_count; ++constant_id) {
+            if (is_same_constant(constants[constant_id], value)) {
+                return AbsAddress {
+                    .tag = AbsAddrTag::constant,
+                    .id = static_cast<int16_t>(constant_id),
+                };
+            }
+        }
+
+        if (constant_count >= std::numeric_limits<int16_t>::max()) {
+            return {};
+        }
+
+        constants.emplace_back(value);
+
+        return AbsAddress {
+            .tag = AbsAddrTag::constant,
+            .id = static_cast<int16_t>(constant_count),
+        };
+    }
+
+    void ConstPropagator::lower_cell(AbsAddress aa, const Cell& cell) {
+        auto& old_cell = m_cells[aa.id];
+        const auto next_cell = meet_cells(old_cell, cell);
+
+        if (next_cell.kind != old_cell.kind) {
+            old_cell = next_cell;
+            m_ssa_worklist.push_back(aa.id);
+        }
+    }
+
+    void ConstPropagator::mark_edge(int from_id, int to_id) {
+        if (!m_live_edges.contains(std::pair {from_id, to_id})) {
+            m_flow_worklist.emplace_back(from_id, to_id);
+        }
+    }
+
+    void ConstPropagator::visit_phi(int block_id, int phi_pos) {
+        const auto& block = m_form_p->get_blocks()[block_id];
+        const auto& [phi_dest, phi_args] = block.phis[phi_pos];
+        Cell merged_cell {{}, CellKind::top};
+
+        /// NOTE: Only arguments from edges known to run can matter, which is what lets a loop's constant stay constant.
+        for (auto pred_pos = 0UL; pred_pos < phi_args.size(); ++pred_pos) {
+            if (m_live_edges.contains(std::pair {block.preds[pred_pos], block_id})) {
+                merged_cell = meet_cells(merged_cell, get_cell(phi_args[pred_pos]));
+            }
+        }
+
+        lower_cell(phi_dest, merged_cell);
+    }
+
+    void ConstPropagator::visit_step(int block_id, int step_pos) {
+        const auto& step = m_form_p->get_step(m_form_p->get_blocks()[block_id].steps[step_pos]);
+        const auto dest_opt = Steps::step_dest(step);
+
+        if (!dest_opt || !m_form_p->is_version(dest_opt.value())) {
+            return;
+        }
+
+        if (const auto tac_unary_p = std::get_if<TACUnary>(&step); tac_unary_p && tac_unary_p->op == Op::nop) {
+            lower_cell(dest_opt.value(), get_cell(tac_unary_p->arg_0));
+        } else if (const auto tac_binary_p = std::get_if<TACBinary>(&step); tac_binary_p) {
+            lower_cell(dest_opt.value(), fold_binary(tac_binary_p->op, get_cell(tac_binary_p->arg_0), get_cell(tac_binary_p->arg_1)));
+        } else {
+            lower_cell(dest_opt.value(), Cell {{}, CellKind::bottom});
+        }
+    }
+
+    void ConstPropagator::visit_block_exit(int block_id) {
+        const auto& block = m_form_p->get_blocks()[block_id];
+
+        if (block.succs.size() == 2 && !block.steps.empty()) {
+            if (const auto jump_p = std::get_if<OperBinary>(&m_form_p->get_step(block.steps.back())); jump_p && is_branch(jump_p->op)) {
+                const auto check_cell = get_cell(jump_p->arg_0);
+
+                if (check_cell.kind == CellKind::top) {
+                    return;
+                }
+
+                if (check_cell.kind == CellKind::constant) {
+                    const auto jumps = static_cast<bool>(check_cell.value) == (jump_p->op == Op::jump_if);
+
+                    mark_edge(block_id, block.succs[jumps ? 1 : 0]);
+
+                    return;
+                }
+            }
+        }
+
+        for (const auto succ_id : block.succs) {
+            mark_edge(block_id, succ_id);
+        }
+    }
+
+    void ConstPropagator::solve() {
+        const auto& blocks = m_form_p->get_blocks();
+        const int block_count = blocks.size();
+
+        m_cells.assign(m_form_p->get_temp_count(), Cell {{}, CellKind::top});
+        m_uses.assign(m_form_p->get_temp_count(), {});
+        m_live_edges.clear();
+        m_live_blocks.assign(block_count, false);
+        m_flow_worklist.clear();
+        m_ssa_worklist.clear();
+
+        // 1. Index every read of a version, so that a change to its cell revisits only those.
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            const auto& block = blocks[block_id];
+
+            for (auto phi_pos = 0; const auto& phi : block.phis) {
+                for (const auto arg_aa : phi.args) {
+                    if (m_form_p->is_version(arg_aa)) {
+                        m_uses[arg_aa.id].emplace_back(UseSite {block_id, phi_pos, true});
+                    }
+                }
+
+                ++phi_pos;
+            }
+
+            for (auto step_pos = 0; const auto step_ref : block.steps) {
+                for (const auto use_p : Steps::step_uses(m_form_p->get_step(step_ref))) {
+                    if (use_p && m_form_p->is_version(*use_p)) {
+                        m_uses[use_p->id].emplace_back(UseSite {block_id, step_pos, false});
+                    }
+                }
+
+                ++step_pos;
+            }
+        }
+
+        // 2. Run both worklists until neither any edge nor any cell changes.
+        mark_edge(SSA::SSAForm::dud_block_id, SSA::SSAForm::entry_block_id);
+
+        while (!m_flow_worklist.empty() || !m_ssa_worklist.empty()) {
+            if (!m_flow_worklist.empty()) {
+                const auto edge = m_flow_worklist.back();
+                m_flow_worklist.pop_back();
+
+                if (!m_live_edges.insert(edge).second) {
+                    continue;
+                }
+
+                const auto block_id = edge.second;
+                const int phi_count = blocks[block_id].phis.size();
+
+                for (auto phi_pos = 0; phi_pos < phi_count; ++phi_pos) {
+                    visit_phi(block_id, phi_pos);
+                }
+
+                if (m_live_blocks[block_id]) {
+                    continue;
+                }
+
+                m_live_blocks[block_id] = true;
+
+                const int step_count = blocks[block_id].steps.size();
+
+                for (auto step_pos = 0; step_pos < step_count; ++step_pos) {
+                    visit_step(block_id, step_pos);
+                }
+
+                visit_block_exit(block_id);
+            } else {
+                const auto version_id = m_ssa_worklist.back();
+                m_ssa_worklist.pop_back();
+
+                for (const auto [block_id, pos, by_phi] : m_uses[version_id]) {
+                    if (!m_live_blocks[block_id]) {
+                        continue;
+                    }
+
+                    if (by_phi) {
+                        visit_phi(block_id, pos);
+                    } else {
+                        visit_step(block_id, pos);
+
+                        if (static_cast<std::size_t>(pos) + 1 == blocks[block_id].steps.size()) {
+                            visit_block_exit(block_id);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void ConstPropagator::rewrite_live_steps() {
+        const auto& blocks = m_form_p->get_blocks();
+        const int block_count = blocks.size();
+
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            if (!m_live_blocks[block_id]) {
+                continue;
+            }
+
+            for (const auto step_ref : blocks[block_id].steps) {
+                auto& step = m_form_p->get_step(step_ref);
+
+                // 1. A step computing a constant just loads it instead.
+                if (const auto dest_opt = Steps::step_dest(step); dest_opt && m_form_p->is_version(dest_opt.value()) && (std::holds_alternative<TACUnary>(step) || std::holds_alternative<TACBinary>(step))) {
+                    if (const auto& dest_cell = m_cells[dest_opt->id]; dest_cell.kind == CellKind::constant) {
+                        if (const auto constant_opt = intern_constant(dest_cell.value); constant_opt) {
+                            step = TACUnary {
+                                .dest = dest_opt.value(),
+                                .arg_0 = constant_opt.value(),
+                                .op = Op::nop,
+                            };
+
+                            continue;
+                        }
+                    }
+                }
+
+                // 2. Constant versions are read straight from the constant pool where the VM allows it.
+                for (const auto slot_p : constant_slots(step)) {
+                    if (!slot_p || !m_form_p->is_version(*slot_p)) {
+                        continue;
+                    }
+
+                    if (const auto& arg_cell = m_cells[slot_p->id]; arg_cell.kind == CellKind::constant) {
+                        if (const auto constant_opt = intern_constant(arg_cell.value); constant_opt) {
+                            *slot_p = constant_opt.value();
+                        }
+                    }
+                }
+
+                // 3. A branch on a constant either always jumps or never does. The emitter still patches the new `jump` by its marker.
+                if (const auto jump_p = std::get_if<OperBinary>(&step); jump_p && is_branch(jump_p->op)) {
+                    if (const auto check_cell = get_cell(jump_p->arg_0); check_cell.kind == CellKind::constant) {
+                        if (static_cast<bool>(check_cell.value) == (jump_p->op == Op::jump_if)) {
+                            step = OperUnary {
+                                .arg_0 = {.tag = AbsAddrTag::immediate, .id = 0},
+                                .op = Op::jump,
+                            };
+                        } else {
+                            step = OperNonary {
+                                .op = Op::nop,
+                            };
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void ConstPropagator::prune_dead_flow(std::vector<StepRef>& doomed_refs) {
+        auto& form = *m_form_p;
+        const auto& blocks = form.get_blocks();
+        const int block_count = blocks.size();
+        std::vector<std::pair<int, int>> dead_edges;
+
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            for (const auto succ_id : blocks[block_id].succs) {
+                if (!m_live_edges.contains(std::pair {block_id, succ_id})) {
+                    dead_edges.emplace_back(block_id, succ_id);
+                }
+            }
+        }
+
+        for (const auto& [from_id, to_id] : dead_edges) {
+            form.remove_edge(from_id, to_id);
+        }
+
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            if (m_live_blocks[block_id]) {
+                continue;
+            }
+
+            form.remove_block(block_id);
+
+            for (const auto step_ref : blocks[block_id].steps) {
+                if (!form.is_marked_step(step_ref)) {
+                    doomed_refs.push_back(step_ref);
+                }
+            }
+        }
+    }
+
+    void ConstPropagator::remove_dead_defs(std::vector<StepRef>& doomed_refs) {
+        auto& form = *m_form_p;
+        auto& blocks = form.get_blocks();
+        const int block_count = blocks.size();
+        std::vector<int> use_counts (form.get_temp_count(), 0);
+        std::vector<std::optional<UseSite>> def_sites (form.get_temp_count());
+
+        // 1. Count the reads of every version which may still run.
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            if (!m_live_blocks[block_id]) {
+                continue;
+            }
+
+            for (auto phi_pos = 0; const auto& [phi_dest, phi_args] : blocks[block_id].phis) {
+                def_sites[phi_dest.id] = UseSite {block_id, phi_pos, true};
+
+                for (const auto arg_aa : phi_args) {
+                    if (form.is_version(arg_aa)) {
+                        ++use_counts[arg_aa.id];
+                    }
+                }
+
+                ++phi_pos;
+            }
+
+            for (auto step_pos = 0; const auto step_ref : blocks[block_id].steps) {
+                auto& step = form.get_step(step_ref);
+
+                for (const auto use_p : Steps::step_uses(step)) {
+                    if (use_p && form.is_version(*use_p)) {
+                        ++use_counts[use_p->id];
+                    }
+                }
+
+                if (const auto dest_opt = Steps::step_dest(step); dest_opt && form.is_version(dest_opt.value())) {
+                    def_sites[dest_opt->id] = UseSite {block_id, step_pos, false};
+                }
+
+                ++step_pos;
+            }
+        }
+
+        // 2. Drop unread phis and loads of constants, which may leave more versions unread.
+        std::vector<int> unread_ids;
+        std::vector<std::vector<bool>> dead_phis (block_count);
+
+        for (auto version_id = 0; version_id < form.get_temp_count(); ++version_id) {
+            if (def_sites[version_id] && use_counts[version_id] == 0) {
+                unread_ids.push_back(version_id);
+            }
+        }
+
+        while (!unread_ids.empty()) {
+            const auto version_id = unread_ids.back();
+            unread_ids.pop_back();
+
+            const auto [block_id, pos, by_phi] = def_sites[version_id].value();
+            auto& block = blocks[block_id];
+
+            if (by_phi) {
+                dead_phis[block_id].resize(block.phis.size(), false);
+                dead_phis[block_id][pos] = true;
+
+                for (const auto arg_aa : block.phis[pos].args) {
+                    if (form.is_version(arg_aa) && --use_counts[arg_aa.id] == 0 && def_sites[arg_aa.id]) {
+                        unread_ids.push_back(arg_aa.id);
+                    }
+                }
+            } else {
+                const auto step_ref = block.steps[pos];
+                const auto load_p = std::get_if<TACUnary>(&form.get_step(step_ref));
+
+                if (load_p && load_p->op == Op::nop && load_p->arg_0.tag == AbsAddrTag::constant && !form.is_marked_step(step_ref)) {
+                    doomed_refs.push_back(step_ref);
+                }
+            }
+        }
+
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            auto& phis = blocks[block_id].phis;
+
+            for (auto phi_pos = static_cast<int>(dead_phis[block_id].size()) - 1; phi_pos >= 0; --phi_pos) {
+                if (dead_phis[block_id][phi_pos]) {
+                    phis.erase(phis.begin() + phi_pos);
+                }
+            }
+        }
+    }
+
+    auto ConstPropagator::apply([[maybe_unused]] const CFG::CFG& cfg) -> bool {
+        return true;
+    }
+
+    auto ConstPropagator::apply(CFG::CFG& cfg) -> bool {
+        if (&m_form_p->get_cfg() != &cfg) {
+            return false;
+        }
+
+        std::vector<StepRef> doomed_refs;
+
+        solve();
+        rewrite_live_steps();
+        prune_dead_flow(doomed_refs);
+        remove_dead_defs(doomed_refs);
+        m_form_p->remove_steps(std::move(doomed_refs));
+
+        return true;
+    }
+}
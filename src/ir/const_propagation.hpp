@@ -0,0 +1,81 @@
+#ifndef MINUET_IR_CONST_PROPAGATION_HPP
+#define MINUET_IR_CONST_PROPAGATION_HPP
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "ir/pass.hpp"
+#include "ir/ssa.hpp"
+#include "runtime/fast_value.hpp"
+
+namespace Minuet::IR::Pass {
+    /**
+     * @brief Sparse conditional constant propagation (Wegman-Zadeck) over a CFG in SSA form. Versions proven to always hold one scalar constant are folded into their uses, arithmetic and comparisons over them are evaluated ahead of time, and branches on constant conditions become plain jumps or `nop`s whose dead side is dropped.
+     * @note Folds which the VM would fault on or which overflow an `int32` are left for runtime. Phi arguments stay versions, so that leaving SSA never needs copies along critical edges.
+     */
+    class ConstPropagator : public PassBase<bool> {
+    private:
+        enum class CellKind : uint8_t {
+            top,
+            constant,
+            bottom,
+        };
+
+        struct Cell {
+            Runtime::FastValue value;
+            CellKind kind;
+        };
+
+        /// NOTE: Locates a read of a version, either by a phi or a step of some flow block.
+        struct UseSite {
+            int block_id;
+            int pos;
+            bool by_phi;
+        };
+
+        SSA::SSAForm* m_form_p;
+        std::vector<Runtime::FastValue>* m_constants_p;
+        std::vector<Cell> m_cells;
+        std::vector<std::vector<UseSite>> m_uses;
+        std::set<std::pair<int, int>> m_live_edges;
+        std::vector<bool> m_live_blocks;
+        std::vector<std::pair<int, int>> m_flow_worklist;
+        std::vector<int> m_ssa_worklist;
+
+        [[nodiscard]] static auto is_same_constant(const Runtime::FastValue& lhs, const Runtime::FastValue& rhs) noexcept -> bool;
+        [[nodiscard]] static auto meet_cells(const Cell& lhs, const Cell& rhs) noexcept -> Cell;
+        [[nodiscard]] static auto fold_binary(Steps::Op op, const Cell& lhs, const Cell& rhs) -> Cell;
+
+        [[nodiscard]] auto get_cell(Steps::AbsAddress aa) const noexcept -> Cell;
+        [[nodiscard]] auto intern_constant(const Runtime::FastValue& value) -> std::optional<Steps::AbsAddress>;
+
+        void lower_cell(Steps::AbsAddress aa, const Cell& cell);
+        void mark_edge(int from_id, int to_id);
+        void visit_phi(int block_id, int phi_pos);
+        void visit_step(int block_id, int step_pos);
+        void visit_block_exit(int block_id);
+        void solve();
+
+        void rewrite_live_steps();
+        void prune_dead_flow(std::vector<SSA::StepRef>& doomed_refs);
+        void remove_dead_defs(std::vector<SSA::StepRef>& doomed_refs);
+
+    public:
+        /**
+         * @brief Constructs the pass.
+         *
+         * @param form The SSA view of the CFG to optimize.
+         * @param constants The program's constants, which may get new ones for folded results.
+         */
+        ConstPropagator(SSA::SSAForm& form, std::vector<Runtime::FastValue>& constants) noexcept;
+
+        /// NOTE: A read-only CFG can't be rewritten, so this just succeeds.
+        [[nodiscard]] auto apply(const CFG::CFG& cfg) -> bool override;
+        [[nodiscard]] auto apply(CFG::CFG& cfg) -> bool override;
+    };
+}
+
+#endif
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <iostream>
@@ -8,6 +9,7 @@
 #include "ir/steps.hpp"
 #include "ir/cfg.hpp"
 #include "ir/convert_ast.hpp"
+#include "runtime/sequence_value.hpp"
 #include "runtime/string_value.hpp"
 
 /// TODO: fix emission to handle code with a flat BB after any whole conditional stmt??
@@ -42,7 +44,7 @@ namespace Minuet::IR::Convert {
     }
 
     ASTConversion::ASTConversion(const Runtime::NativeProcRegistry* native_proc_ids)
-    : m_globals {}, m_locals {}, m_pending_links {}, m_result_cfgs {}, m_proto_consts {}, m_proto_heap_objs {}, m_native_proc_ids {native_proc_ids}, m_proto_main_id {-1}, m_error_count {0}, m_next_func_aa {0}, m_next_local_aa {0}, m_prepassing {true} {}
+    : m_globals {}, m_locals {}, m_pending_links {}, m_result_cfgs {}, m_proto_consts {}, m_proto_heap_objs {}, m_key_literals {}, m_native_proc_ids {native_proc_ids}, m_proto_main_id {-1}, m_error_count {0}, m_next_func_aa {0}, m_next_local_aa {0}, m_prepassing {true} {}
 
     auto ASTConversion::operator()(const Syntax::AST::FullAST& src_mapped_ast, const std::unordered_map<uint32_t, std::string>& source_map) -> std::optional<FullIR> {
         // 1. Prepass top-level definitions of functions, etc. to avoid forward declaration jank.
@@ -65,6 +67,8 @@ namespace Minuet::IR::Convert {
             return {};
         }
 
+        m_key_literals.clear();
+
         return FullIR {
             .cfg_list = std::exchange(m_result_cfgs, {}),
             .constants = std::exchange(m_proto_consts, {}),
@@ -129,6 +133,28 @@ namespace Minuet::IR::Convert {
         };
     }
 
+    auto ASTConversion::resolve_key_literal_aa(const Syntax::Exprs::ExprPtr& key_expr, std::string_view source) -> std::optional<Steps::AbsAddress> {
+        const auto key_literal_p = std::get_if<Syntax::Exprs::Literal>(&key_expr->data);
+
+        if (!key_literal_p || key_literal_p->token.type != TokenType::literal_string) {
+            return {};
+        }
+
+        std::string key_text {token_to_sv(key_literal_p->token, source)};
+
+        if (auto key_it = m_key_literals.find(key_text); key_it != m_key_literals.end()) {
+            return key_it->second;
+        }
+
+        auto key_aa_opt = resolve_heap_obj_aa(std::make_unique<Runtime::StringValue>(key_text));
+
+        if (key_aa_opt) {
+            m_key_literals.emplace(std::move(key_text), key_aa_opt.value());
+        }
+
+        return key_aa_opt;
+    }
+
     auto ASTConversion::record_name_aa(Utils::NameLocation mode, const std::string& name, AbsAddress aa) -> bool {
         auto name_exists = false;
 
@@ -246,6 +272,70 @@ namespace Minuet::IR::Convert {
         return temp;
     }
 
+    auto ASTConversion::is_constant_item(const Syntax::Exprs::ExprPtr& item_expr) noexcept -> bool {
+        using Syntax::Exprs::Literal;
+
+        const auto is_literal_of = [](const Syntax::Exprs::ExprPtr& expr, auto... tags) noexcept {
+            const auto literal_p = std::get_if<Literal>(&expr->data);
+
+            return literal_p && ((literal_p->token.type == tags) || ...);
+        };
+
+        if (is_literal_of(item_expr, TokenType::literal_false, TokenType::literal_true, TokenType::literal_char, TokenType::literal_int, TokenType::literal_double)) {
+            return true;
+        } else if (const auto unary_p = std::get_if<Syntax::Exprs::Unary>(&item_expr->data); unary_p) {
+            return unary_p->op == Operator::negate && is_literal_of(unary_p->inner, TokenType::literal_int, TokenType::literal_double);
+        } else if (const auto sequence_p = std::get_if<Syntax::Exprs::Sequence>(&item_expr->data); sequence_p) {
+            return sequence_p->is_tuple && std::ranges::all_of(sequence_p->items, is_constant_item);
+        }
+
+        return false;
+    }
+
+    auto ASTConversion::fold_constant_item(const Syntax::Exprs::ExprPtr& item_expr, std::string_view source) -> std::optional<Runtime::FastValue> {
+        if (const auto sequence_p = std::get_if<Syntax::Exprs::Sequence>(&item_expr->data); sequence_p) {
+            if (auto tuple_aa_opt = preload_constant_tuple(*sequence_p, source); tuple_aa_opt) {
+                return m_proto_heap_objs[tuple_aa_opt->id]->as_fast_value();
+            }
+
+            return {};
+        }
+
+        const auto unary_p = std::get_if<Syntax::Exprs::Unary>(&item_expr->data);
+        const auto& literal = std::get<Syntax::Exprs::Literal>(((unary_p) ? unary_p->inner : item_expr)->data);
+        const std::string literal_lexeme {token_to_sv(literal.token, source)};
+
+        switch (literal.token.type) {
+        case TokenType::literal_false:
+        case TokenType::literal_true:
+            return Runtime::FastValue {literal.token.type == TokenType::literal_true};
+        case TokenType::literal_char:
+            return Utils::convert_char_literal(literal_lexeme);
+        case TokenType::literal_int:
+            return Runtime::FastValue {(unary_p) ? -std::stoi(literal_lexeme) : std::stoi(literal_lexeme)};
+        case TokenType::literal_double:
+            return Runtime::FastValue {(unary_p) ? -std::stod(literal_lexeme) : std::stod(literal_lexeme)};
+        default:
+            return {};
+        }
+    }
+
+    auto ASTConversion::preload_constant_tuple(const Syntax::Exprs::Sequence& sequence, std::string_view source) -> std::optional<Steps::AbsAddress> {
+        auto tuple_obj = std::make_unique<Runtime::SequenceValue>();
+
+        for (const auto& item_expr : sequence.items) {
+            auto item_value_opt = fold_constant_item(item_expr, source);
+
+            if (!item_value_opt || !tuple_obj->push_value(item_value_opt.value())) {
+                return {};
+            }
+        }
+
+        tuple_obj->freeze();
+
+        return resolve_heap_obj_aa(std::move(tuple_obj));
+    }
+
     auto ASTConversion::emit_sequence(const Syntax::Exprs::Sequence& sequence, std::string_view source) -> std::optional<Steps::AbsAddress> {
         auto temp_value_aa_opt = gen_temp_aa();
 
@@ -256,6 +346,25 @@ namespace Minuet::IR::Convert {
         auto value_aa = temp_value_aa_opt.value();
         const auto is_fixed_size = sequence.is_tuple;
 
+        /// NOTE: A tuple of only constants is built once at compile-time, then each evaluation just loads a reference to it. Frozen tuples are read-only, so sharing one is safe.
+        if (is_fixed_size && std::ranges::all_of(sequence.items, is_constant_item)) {
+            auto tuple_aa_opt = preload_constant_tuple(sequence, source);
+
+            if (!tuple_aa_opt) {
+                return {};
+            }
+
+            m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(
+                OperBinary {
+                    .arg_0 = value_aa,
+                    .arg_1 = tuple_aa_opt.value(),
+                    .op = Op::load_obj,
+                }
+            );
+
+            return value_aa;
+        }
+
         m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(
             OperUnary {
                 .arg_0 = value_aa,
@@ -295,6 +404,48 @@ namespace Minuet::IR::Convert {
         return value_aa;
     }
 
+    auto ASTConversion::emit_dictionary(const Syntax::Exprs::Dictionary& dictionary, std::string_view source) -> std::optional<Steps::AbsAddress> {
+        auto temp_value_aa_opt = gen_temp_aa();
+
+        if (!temp_value_aa_opt) {
+            return {};
+        }
+
+        auto value_aa = temp_value_aa_opt.value();
+
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(
+            OperUnary {
+                .arg_0 = value_aa,
+                .op = Op::make_dict,
+            }
+        );
+
+        for (std::size_t entry_pos = 0; entry_pos < dictionary.keys.size(); ++entry_pos) {
+            auto key_aa_opt = resolve_key_literal_aa(dictionary.keys[entry_pos], source);
+
+            if (!key_aa_opt) {
+                key_aa_opt = emit_expr(dictionary.keys[entry_pos], source);
+            }
+
+            auto entry_value_aa_opt = emit_expr(dictionary.values[entry_pos], source);
+
+            if (!key_aa_opt || !entry_value_aa_opt) {
+                return {};
+            }
+
+            m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(
+                OperTernary {
+                    .arg_0 = value_aa,
+                    .arg_1 = key_aa_opt.value(),
+                    .arg_2 = entry_value_aa_opt.value(),
+                    .op = Op::dict_set,
+                }
+            );
+        }
+
+        return value_aa;
+    }
+
     auto ASTConversion::emit_unary(const Syntax::Exprs::Unary& unary, std::string_view source) -> std::optional<AbsAddress> {
         std::optional<AbsAddress> temp = emit_expr(unary.inner, source);
 
@@ -323,6 +474,28 @@ namespace Minuet::IR::Convert {
 
     auto ASTConversion::emit_binary(const Syntax::Exprs::Binary& binary, std::string_view source) -> std::optional<AbsAddress> {
         const auto bin_operator = binary.op;
+
+        /// NOTE: An access by a string literal can only be a dictionary lookup, so it skips the generic `seq_obj_get` and the key's string copy.
+        if (bin_operator == Operator::access) {
+            if (auto key_aa_opt = resolve_key_literal_aa(binary.right, source); key_aa_opt) {
+                auto dict_aa_opt = emit_expr(binary.left, source);
+                auto dest_aa_opt = gen_temp_aa();
+
+                if (!dict_aa_opt || !dest_aa_opt) {
+                    return {};
+                }
+
+                m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperTernary {
+                    .arg_0 = dest_aa_opt.value(),
+                    .arg_1 = dict_aa_opt.value(),
+                    .arg_2 = key_aa_opt.value(),
+                    .op = Op::dict_get,
+                });
+
+                return dest_aa_opt;
+            }
+        }
+
         auto lhs_aa_opt = emit_expr(binary.left, source);
         auto rhs_aa_opt = emit_expr(binary.right, source);
 
@@ -361,7 +534,7 @@ namespace Minuet::IR::Convert {
                 }
             case Operator::access:
                 {
-                    /// TODO: add support for dictionary accesses?
+                    /// NOTE: Other keys may index a sequence or a dictionary, which the VM tells apart by the object.
                     if (auto dest_aa_opt = gen_temp_aa(); dest_aa_opt) {
                         auto dest_aa = dest_aa_opt.value();
 
@@ -399,19 +572,14 @@ namespace Minuet::IR::Convert {
             return {};
         }
 
-        /// NOTE: Any call will take the function ID and then N (stack argument count).
+        /// NOTE: Any call will take the function ID, then N (stack argument count), and then the base temp of its arguments which also receives the result.
         const int16_t real_args_n = call.args.size();
+        std::vector<AbsAddress> arg_aas;
 
-        for (int16_t arg_idx = 0; arg_idx < real_args_n; ++arg_idx) {
-            if (auto arg_aa_opt = emit_expr(call.args.at(arg_idx), source); arg_aa_opt) {
-                if (auto arg_dest_aa = gen_temp_aa(); arg_dest_aa) {
-                    m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(TACUnary {
-                        .dest = arg_dest_aa.value(),
-                        .arg_0 = arg_aa_opt.value(),
-                        .op = Op::nop,
-                    });
-                }
-
+        /// NOTE: All arguments are evaluated before any is staged, so that no temporaries of argument expressions land between the staged arguments.
+        for (const auto& arg_expr : call.args) {
+            if (auto arg_aa_opt = emit_expr(arg_expr, source); arg_aa_opt) {
+                arg_aas.emplace_back(arg_aa_opt.value());
                 continue;
             }
 
@@ -420,16 +588,31 @@ namespace Minuet::IR::Convert {
 
         const auto call_result_slot_aa = AbsAddress {
             .tag = AbsAddrTag::temp,
-            .id = static_cast<int16_t>(m_next_local_aa - real_args_n),
+            .id = m_next_local_aa,
         };
 
+        for (const auto& arg_aa : arg_aas) {
+            if (auto arg_dest_aa = gen_temp_aa(); arg_dest_aa) {
+                m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(TACUnary {
+                    .dest = arg_dest_aa.value(),
+                    .arg_0 = arg_aa,
+                    .op = Op::nop,
+                });
+            }
+        }
+
+        /// NOTE: A call without arguments still needs its own result slot.
+        if (real_args_n == 0) {
+            [[maybe_unused]] auto result_slot_aa = gen_temp_aa();
+        }
+
         auto callee_aa = callee_aa_opt.value();
         /// NOTE: the IR `Op` for call expressions will be `native_call` upon an AbsAddress with reused tag `constant`... This denotes a function pointer ID from the native procedure "registry".
         const auto calling_op = (callee_aa.tag == AbsAddrTag::immediate)
             ? Op::call
             : Op::native_call;
 
-        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperBinary {
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperTernary {
             .arg_0 = {
                 .tag = AbsAddrTag::immediate,
                 .id = callee_aa.id,
@@ -438,6 +621,7 @@ namespace Minuet::IR::Convert {
                 .tag = AbsAddrTag::immediate,
                 .id = real_args_n,
             },
+            .arg_2 = call_result_slot_aa,
             .op = calling_op,
         });
 
@@ -445,6 +629,32 @@ namespace Minuet::IR::Convert {
     }
 
     auto ASTConversion::emit_assign(const Syntax::Exprs::Assign& assign, std::string_view source) -> std::optional<AbsAddress> {
+        /// NOTE: Storing by a string literal key is a `dict_set`, which also adds the key if it's absent. Other item stores are a `seq_obj_set`, since string characters and packed array elements have no slot to be assigned through.
+        if (auto access_p = std::get_if<Syntax::Exprs::Binary>(&assign.left->data); access_p && access_p->op == Operator::access) {
+            auto key_aa_opt = resolve_key_literal_aa(access_p->right, source);
+            const auto store_op = (key_aa_opt) ? Op::dict_set : Op::seq_obj_set;
+            auto obj_aa_opt = emit_expr(access_p->left, source);
+
+            if (!key_aa_opt) {
+                key_aa_opt = emit_expr(access_p->right, source);
+            }
+
+            auto setting_aa_opt = emit_expr(assign.value, source);
+
+            if (!obj_aa_opt || !key_aa_opt || !setting_aa_opt) {
+                return {};
+            }
+
+            m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperTernary {
+                .arg_0 = obj_aa_opt.value(),
+                .arg_1 = key_aa_opt.value(),
+                .arg_2 = setting_aa_opt.value(),
+                .op = store_op,
+            });
+
+            return setting_aa_opt;
+        }
+
         auto lhs_aa_opt = emit_expr(assign.left, source);
         auto setting_aa_opt = emit_expr(assign.value, source);
 
@@ -468,6 +678,8 @@ namespace Minuet::IR::Convert {
             return emit_literal(std::get<Literal>(expr->data), source);
         } else if (std::holds_alternative<Sequence>(expr->data)) {
             return emit_sequence(std::get<Sequence>(expr->data), source);
+        } else if (std::holds_alternative<Dictionary>(expr->data)) {
+            return emit_dictionary(std::get<Dictionary>(expr->data), source);
         } else if (std::holds_alternative<Syntax::Exprs::Call>(expr->data)) {
             return emit_call(std::get<Call>(expr->data), source);
         } else if (std::holds_alternative<Syntax::Exprs::Unary>(expr->data)) {
@@ -736,6 +948,111 @@ namespace Minuet::IR::Convert {
         return true;
     }
 
+    [[nodiscard]] auto ASTConversion::emit_for(const Syntax::Stmts::For& floop, std::string_view source) -> bool {
+        // Usual IR: (Like a while loop, but the whole check is one `iter_next_or_jump` which loads the next item or else exits.)
+        //     (Pre-Block: iter_init)
+        //       |
+        //     (Check)-F-*
+        //       |   |   |
+        //       T   L   |
+        //       |   ^   |
+        //     (In-Loop) |
+        //               |
+        //     (Post-Block)
+
+        // 1. Set up the iterator in the current block, which takes 2 adjacent temps: the iterable and then the position.
+        auto iterable_aa_opt = emit_expr(floop.iterable, source);
+        auto iter_aa_opt = gen_temp_aa();
+        [[maybe_unused]] auto iter_pos_aa_opt = gen_temp_aa();
+        auto item_aa_opt = gen_temp_aa();
+
+        if (!iterable_aa_opt || !iter_aa_opt || !item_aa_opt) {
+            return false;
+        }
+
+        const auto iter_aa = iter_aa_opt.value();
+        const auto item_aa = item_aa_opt.value();
+        const auto pre_loop_bb_id = m_result_cfgs.back().bb_count() - 1;
+
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperBinary {
+            .arg_0 = iter_aa,
+            .arg_1 = iterable_aa_opt.value(),
+            .op = Op::iter_init,
+        });
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperNonary {
+            .op = Op::meta_begin_while,
+        });
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperNonary {
+            .op = Op::nop,
+        });
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperTernary {
+            .arg_0 = iter_aa,
+            .arg_1 = {
+                .tag = AbsAddrTag::immediate,
+                .id = 0,
+            },
+            .arg_2 = item_aa,
+            .op = Op::iter_next_or_jump,
+        });
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperNonary {
+            .op = Op::meta_mark_while_check,
+        });
+
+        // 2. Emit the body with the item's name in scope, which ends at the loop so that later loops may reuse it.
+        std::string item_name = std::format("{}", token_to_sv(floop.name, source));
+
+        if (!record_name_aa(NameLocation::local_slot, item_name, item_aa)) {
+            std::string bad_redef_msg = std::format("Invalid re-definition of local variable '{}' as a for loop item.\n", item_name);
+
+            report_error(bad_redef_msg);
+
+            return false;
+        }
+
+        const auto in_loop_bb_id = emit_block(std::get<Syntax::Stmts::Block>(floop.body->data), source);
+
+        m_locals.erase(item_name);
+
+        if (in_loop_bb_id == -1) {
+            return false;
+        }
+
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperUnary {
+            .arg_0 = {
+                .tag = AbsAddrTag::immediate,
+                .id = 0,
+            },
+            .op = Op::jump,
+        });
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperNonary {
+            .op = Op::meta_mark_continue,
+        });
+        m_pending_links.emplace(Utils::BBLink {
+            .from = in_loop_bb_id,
+            .to = pre_loop_bb_id,
+        });
+        m_pending_links.emplace(Utils::BBLink {
+            .from = pre_loop_bb_id,
+            .to = in_loop_bb_id,
+        });
+
+        // 3. The exhausted iterator jumps to the post-loop block.
+        const auto post_loop_bb_id = m_result_cfgs.back().add_bb();
+
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperNonary {
+            .op = Op::nop,
+        });
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperNonary {
+            .op = Op::meta_end_while,
+        });
+        m_pending_links.emplace(Utils::BBLink {
+            .from = pre_loop_bb_id,
+            .to = post_loop_bb_id,
+        });
+
+        return true;
+    }
+
     auto ASTConversion::emit_break([[maybe_unused]] const Syntax::Stmts::Break& loop_brk, [[maybe_unused]] std::string_view source) -> bool {
         m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperUnary {
             .arg_0 = {
@@ -782,6 +1099,7 @@ namespace Minuet::IR::Convert {
         }
 
         add_cfg();
+        m_result_cfgs.back().set_param_count(fun.params.size());
 
         auto generation_ok = true;
 
@@ -825,6 +1143,8 @@ namespace Minuet::IR::Convert {
             return emit_return(*ret_p, source);
         } else if (auto wloop_p = std::get_if<While>(&stmt->data); wloop_p) {
             return emit_while(*wloop_p, source);
+        } else if (auto floop_p = std::get_if<For>(&stmt->data); floop_p) {
+            return emit_for(*floop_p, source);
         } else if (auto loop_brk_p = std::get_if<Break>(&stmt->data); loop_brk_p) {
             return emit_break(*loop_brk_p, source);
         } else if (auto if_p = std::get_if<If>(&stmt->data); if_p) {
@@ -1,6 +1,7 @@
 #ifndef MINUET_IR_CONVERT_AST_HPP
 #define MINUET_IR_CONVERT_AST_HPP
 
+#include <map>
 #include <optional>
 #include <string>
 #include <queue>
@@ -47,6 +48,8 @@ namespace Minuet::IR::Convert {
 
         [[nodiscard]] auto resolve_constant_aa(const std::string& literal, Runtime::FastValue value) -> std::optional<Steps::AbsAddress>;
         [[nodiscard]] auto resolve_heap_obj_aa(std::unique_ptr<Runtime::HeapValueBase> obj_box) -> std::optional<Steps::AbsAddress>;
+        /// @brief Preloads a string literal dictionary key once per distinct text so that `dict_get` / `dict_set` can use it in place, or gives nothing if the key isn't one.
+        [[nodiscard]] auto resolve_key_literal_aa(const Syntax::Exprs::ExprPtr& key_expr, std::string_view source) -> std::optional<Steps::AbsAddress>;
         [[nodiscard]] auto record_name_aa(Utils::NameLocation mode, const std::string& name, Steps::AbsAddress aa) -> bool;
         [[nodiscard]] auto lookup_name_aa(const std::string& name) noexcept -> std::optional<Steps::AbsAddress>;
 
@@ -55,7 +58,13 @@ namespace Minuet::IR::Convert {
 
         [[nodiscard]] auto emit_string(const std::string& text) -> std::optional<Steps::AbsAddress>;
         [[nodiscard]] auto emit_literal(const Syntax::Exprs::Literal& literal, std::string_view source) -> std::optional<Steps::AbsAddress>;
+        /// @brief Checks for a bool, char, or number literal (maybe negated), or a tuple of only those and other such tuples.
+        [[nodiscard]] static auto is_constant_item(const Syntax::Exprs::ExprPtr& item_expr) noexcept -> bool;
+        [[nodiscard]] auto fold_constant_item(const Syntax::Exprs::ExprPtr& item_expr, std::string_view source) -> std::optional<Runtime::FastValue>;
+        /// @brief Builds a constant tuple once as a frozen preloaded object, giving its heap address.
+        [[nodiscard]] auto preload_constant_tuple(const Syntax::Exprs::Sequence& sequence, std::string_view source) -> std::optional<Steps::AbsAddress>;
         [[nodiscard]] auto emit_sequence(const Syntax::Exprs::Sequence& sequence, std::string_view source) -> std::optional<Steps::AbsAddress>;
+        [[nodiscard]] auto emit_dictionary(const Syntax::Exprs::Dictionary& dictionary, std::string_view source) -> std::optional<Steps::AbsAddress>;
         [[nodiscard]] auto emit_unary(const Syntax::Exprs::Unary& unary, std::string_view source) -> std::optional<Steps::AbsAddress>;
         [[nodiscard]] auto emit_binary(const Syntax::Exprs::Binary& binary, std::string_view source) -> std::optional<Steps::AbsAddress>;
         [[nodiscard]] auto emit_call(const Syntax::Exprs::Call& call, std::string_view source) -> std::optional<Steps::AbsAddress>;
@@ -67,6 +76,7 @@ namespace Minuet::IR::Convert {
         [[nodiscard]] auto emit_if(const Syntax::Stmts::If& cond, std::string_view source) -> bool;
         [[nodiscard]] auto emit_return(const Syntax::Stmts::Return& ret, std::string_view source) -> bool;
         [[nodiscard]] auto emit_while(const Syntax::Stmts::While& wloop, std::string_view source) -> bool;
+        [[nodiscard]] auto emit_for(const Syntax::Stmts::For& floop, std::string_view source) -> bool;
         [[nodiscard]] auto emit_break(const Syntax::Stmts::Break& loop_brk, std::string_view source) -> bool;
         [[nodiscard]] auto emit_block(const Syntax::Stmts::Block& block, std::string_view source) -> int;
         [[nodiscard]] auto emit_function(const Syntax::Stmts::Function& fun, std::string_view source) -> bool;
@@ -78,6 +88,7 @@ namespace Minuet::IR::Convert {
         std::vector<CFG::CFG> m_result_cfgs;
         std::vector<Runtime::FastValue> m_proto_consts;
         std::vector<std::unique_ptr<Runtime::HeapValueBase>> m_proto_heap_objs;
+        std::map<std::string, Steps::AbsAddress> m_key_literals;
         const Runtime::NativeProcRegistry* m_native_proc_ids;
         int m_proto_main_id;
         int m_error_count;
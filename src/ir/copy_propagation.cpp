@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <utility>
+#include <variant>
+
+#include "ir/copy_propagation.hpp"
+
+namespace Minuet::IR::Pass {
+    using Steps::Op;
+    using Steps::AbsAddrTag;
+    using Steps::AbsAddress;
+    using Steps::Step;
+    using Steps::TACUnary;
+    using Steps::TACBinary;
+    using SSA::StepRef;
+
+    CopyPropagator::CopyPropagator(SSA::SSAForm& form) noexcept
+    : m_form_p {&form}, m_defs {}, m_uses {}, m_origin_def_counts {}, m_doomed_refs {} {}
+
+    auto CopyPropagator::get_site_step(const Site& site) noexcept -> Step& {
+        return m_form_p->get_step(m_form_p->get_blocks()[site.block_id].steps[site.pos]);
+    }
+
+    auto CopyPropagator::is_origin_written(const Step& step, AbsAddress aa) const noexcept -> bool {
+        const auto dest_opt = Steps::step_dest(step);
+
+        return dest_opt && dest_opt->tag == AbsAddrTag::temp && m_form_p->get_origin(dest_opt.value()) == m_form_p->get_origin(aa);
+    }
+
+    auto CopyPropagator::is_origin_mentioned(Step& step, AbsAddress aa) const noexcept -> bool {
+        const auto origin_aa = m_form_p->get_origin(aa);
+
+        return is_origin_written(step, aa) || std::ranges::any_of(Steps::step_uses(step), [this, origin_aa](const AbsAddress* use_p) noexcept {
+            return use_p && use_p->tag == AbsAddrTag::temp && m_form_p->get_origin(*use_p) == origin_aa;
+        });
+    }
+
+    void CopyPropagator::index_versions() {
+        const auto& form = *m_form_p;
+        const auto& blocks = form.get_blocks();
+        const int block_count = blocks.size();
+
+        m_defs.assign(form.get_temp_count(), std::nullopt);
+        m_uses.assign(form.get_temp_count(), {});
+        m_origin_def_counts.assign(form.get_temp_count(), 0);
+        m_doomed_refs.clear();
+
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            if (!form.is_reachable(block_id)) {
+                continue;
+            }
+
+            const auto& block = blocks[block_id];
+
+            for (auto phi_pos = 0; const auto& [phi_dest, phi_args] : block.phis) {
+                m_defs[phi_dest.id] = Site {block_id, phi_pos, true};
+                ++m_origin_def_counts[form.get_origin(phi_dest).id];
+
+                for (const auto arg_aa : phi_args) {
+                    if (form.is_version(arg_aa)) {
+                        m_uses[arg_aa.id].emplace_back(Site {block_id, phi_pos, true});
+                    }
+                }
+
+                ++phi_pos;
+            }
+
+            for (auto step_pos = 0; const auto step_ref : block.steps) {
+                auto& step = m_form_p->get_step(step_ref);
+
+                for (const auto use_p : Steps::step_uses(step)) {
+                    if (use_p && form.is_version(*use_p)) {
+                        m_uses[use_p->id].emplace_back(Site {block_id, step_pos, false});
+                    }
+                }
+
+                if (const auto dest_opt = Steps::step_dest(step); dest_opt && dest_opt->tag == AbsAddrTag::temp) {
+                    ++m_origin_def_counts[form.get_origin(dest_opt.value()).id];
+
+                    if (form.is_version(dest_opt.value())) {
+                        m_defs[dest_opt->id] = Site {block_id, step_pos, false};
+                    }
+                }
+
+                ++step_pos;
+            }
+        }
+    }
+
+    void CopyPropagator::rename_uses(AbsAddress from_aa, AbsAddress to_aa, const std::vector<Site>& sites) {
+        auto& blocks = m_form_p->get_blocks();
+
+        for (const auto& site : sites) {
+            if (site.by_phi) {
+                std::ranges::replace(blocks[site.block_id].phis[site.pos].args, from_aa, to_aa);
+            } else {
+                for (const auto use_p : Steps::step_uses(get_site_step(site))) {
+                    if (use_p && *use_p == from_aa) {
+                        *use_p = to_aa;
+                    }
+                }
+            }
+        }
+
+        auto& to_uses = m_uses[to_aa.id];
+
+        to_uses.insert(to_uses.end(), sites.begin(), sites.end());
+    }
+
+    auto CopyPropagator::try_forward_copy(int block_id, int pos) -> bool {
+        auto& form = *m_form_p;
+        const auto copy_ref = form.get_blocks()[block_id].steps[pos];
+        const auto copy_p = std::get_if<TACUnary>(&form.get_step(copy_ref));
+
+        if (!copy_p || copy_p->op != Op::nop || !form.is_version(copy_p->dest) || !form.is_version(copy_p->arg_0) || copy_p->dest == copy_p->arg_0 || form.is_marked_step(copy_ref)) {
+            return false;
+        }
+
+        const auto dest_aa = copy_p->dest;
+        const auto source_aa = copy_p->arg_0;
+        const auto dest_uses = m_uses[dest_aa.id];
+
+        /// NOTE: Both versions share a register once SSA is left, so the copy does nothing and all of its readers may as well read the source.
+        if (form.get_origin(dest_aa) != form.get_origin(source_aa)) {
+            /// NOTE: A callee's frame overlaps the caller's registers from its argument base up, so the source only surely outlives the same calls as the destination if it's lower.
+            if (form.get_origin(source_aa).id > form.get_origin(dest_aa).id || std::ranges::any_of(dest_uses, [](const Site& site) noexcept { return site.by_phi; })) {
+                return false;
+            }
+
+            // The source's register must still hold it at every reader: either it's never written again, or each reader comes later in this block before any other version of the source is written.
+            if (m_origin_def_counts[form.get_origin(source_aa).id] != 1) {
+                auto last_use_pos = pos;
+
+                for (const auto& [use_block_id, use_pos, by_phi] : dest_uses) {
+                    if (use_block_id != block_id || use_pos <= pos) {
+                        return false;
+                    }
+
+                    last_use_pos = std::max(last_use_pos, use_pos);
+                }
+
+                for (auto step_pos = pos + 1; step_pos < last_use_pos; ++step_pos) {
+                    if (is_origin_written(get_site_step(Site {block_id, step_pos, false}), source_aa)) {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        rename_uses(dest_aa, source_aa, dest_uses);
+        m_uses[dest_aa.id].clear();
+        std::erase_if(m_uses[source_aa.id], [block_id, pos](const Site& site) noexcept {
+            return !site.by_phi && site.block_id == block_id && site.pos == pos;
+        });
+        m_defs[dest_aa.id].reset();
+        --m_origin_def_counts[form.get_origin(dest_aa).id];
+        m_doomed_refs.push_back(copy_ref);
+
+        return true;
+    }
+
+    auto CopyPropagator::try_coalesce_copy(int block_id, int pos) -> bool {
+        auto& form = *m_form_p;
+        const auto copy_ref = form.get_blocks()[block_id].steps[pos];
+        const auto copy_p = std::get_if<TACUnary>(&form.get_step(copy_ref));
+
+        if (!copy_p || copy_p->op != Op::nop || !form.is_version(copy_p->dest) || !form.is_version(copy_p->arg_0) || form.is_marked_step(copy_ref)) {
+            return false;
+        }
+
+        const auto dest_aa = copy_p->dest;
+        const auto source_aa = copy_p->arg_0;
+        const auto source_def_opt = m_defs[source_aa.id];
+
+        /// NOTE: Copies already forwarded are left for removal.
+        if (const auto& dest_def_opt = m_defs[dest_aa.id]; !dest_def_opt || dest_def_opt->block_id != block_id || dest_def_opt->pos != pos) {
+            return false;
+        }
+
+        /// NOTE: Likewise, the destination must be lower to outlive any call in between just as the source did.
+        if (!source_def_opt || form.get_origin(dest_aa).id > form.get_origin(source_aa).id || source_def_opt->by_phi || source_def_opt->block_id != block_id || source_def_opt->pos >= pos || m_uses[source_aa.id].size() != 1) {
+            return false;
+        }
+
+        auto& source_def = get_site_step(source_def_opt.value());
+
+        if (const auto def_load_p = std::get_if<TACUnary>(&source_def); (!def_load_p || def_load_p->op != Op::nop) && !std::holds_alternative<TACBinary>(source_def)) {
+            return false;
+        }
+
+        /// NOTE: The copy's destination gets written earlier now, so nothing in between may touch its register.
+        for (auto step_pos = source_def_opt->pos + 1; step_pos < pos; ++step_pos) {
+            if (is_origin_mentioned(get_site_step(Site {block_id, step_pos, false}), dest_aa)) {
+                return false;
+            }
+        }
+
+        *Steps::step_dest_slot(source_def) = dest_aa;
+        m_defs[dest_aa.id] = source_def_opt;
+        m_defs[source_aa.id].reset();
+        m_uses[source_aa.id].clear();
+        --m_origin_def_counts[form.get_origin(source_aa).id];
+        m_doomed_refs.push_back(copy_ref);
+
+        return true;
+    }
+
+    auto CopyPropagator::apply([[maybe_unused]] const CFG::CFG& cfg) -> bool {
+        return true;
+    }
+
+    auto CopyPropagator::apply(CFG::CFG& cfg) -> bool {
+        auto& form = *m_form_p;
+
+        if (&form.get_cfg() != &cfg) {
+            return false;
+        }
+
+        index_versions();
+
+        const auto& blocks = form.get_blocks();
+        const int block_count = blocks.size();
+
+        // 1. Let readers of copies read their sources, then coalesce the copies left with the steps computing their sources.
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            if (!form.is_reachable(block_id)) {
+                continue;
+            }
+
+            const int step_count = blocks[block_id].steps.size();
+
+            for (auto step_pos = 0; step_pos < step_count; ++step_pos) {
+                [[maybe_unused]] auto forwarded = try_forward_copy(block_id, step_pos);
+            }
+        }
+
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            if (!form.is_reachable(block_id)) {
+                continue;
+            }
+
+            const int step_count = blocks[block_id].steps.size();
+
+            for (auto step_pos = 0; step_pos < step_count; ++step_pos) {
+                [[maybe_unused]] auto coalesced = try_coalesce_copy(block_id, step_pos);
+            }
+        }
+
+        // 2. Drop the copies which no longer do anything.
+        form.remove_steps(std::move(m_doomed_refs));
+        m_doomed_refs.clear();
+
+        return true;
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef MINUET_IR_COPY_PROPAGATION_HPP
+#define MINUET_IR_COPY_PROPAGATION_HPP
+
+#include <optional>
+#include <vector>
+
+#include "ir/pass.hpp"
+#include "ir/ssa.hpp"
+
+namespace Minuet::IR::Pass {
+    /**
+     * @brief Removes `nop` copies between versions of a CFG in SSA form. A copy's readers are rewritten to read its source instead, or else the step computing its source writes the copy's destination directly.
+     * @note Only versions are touched, so the contiguous argument slots of calls and the iterator pairs keep their copies. Phi arguments are never renamed to another temporary, and a copy is only dropped when no other version of the affected temporary is live across it, so leaving SSA still gives back a valid register assignment.
+     */
+    class CopyPropagator : public PassBase<bool> {
+    private:
+        /// NOTE: Locates a read or write of a version, either by a phi or a step of some flow block.
+        struct Site {
+            int block_id;
+            int pos;
+            bool by_phi;
+        };
+
+        SSA::SSAForm* m_form_p;
+        std::vector<std::optional<Site>> m_defs;
+        std::vector<std::vector<Site>> m_uses;
+        std::vector<int> m_origin_def_counts;
+        std::vector<SSA::StepRef> m_doomed_refs;
+
+        [[nodiscard]] auto get_site_step(const Site& site) noexcept -> Steps::Step&;
+        [[nodiscard]] auto is_origin_written(const Steps::Step& step, Steps::AbsAddress aa) const noexcept -> bool;
+        [[nodiscard]] auto is_origin_mentioned(Steps::Step& step, Steps::AbsAddress aa) const noexcept -> bool;
+
+        void index_versions();
+        void rename_uses(Steps::AbsAddress from_aa, Steps::AbsAddress to_aa, const std::vector<Site>& sites);
+        [[nodiscard]] auto try_forward_copy(int block_id, int pos) -> bool;
+        [[nodiscard]] auto try_coalesce_copy(int block_id, int pos) -> bool;
+
+    public:
+        CopyPropagator(SSA::SSAForm& form) noexcept;
+
+        /// NOTE: A read-only CFG can't be rewritten, so this just succeeds.
+        [[nodiscard]] auto apply(const CFG::CFG& cfg) -> bool override;
+        [[nodiscard]] auto apply(CFG::CFG& cfg) -> bool override;
+    };
+}
+
+#endif
@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <stack>
+#include <utility>
+#include <variant>
+
+#include "ir/inlining.hpp"
+
+namespace Minuet::IR::Pass {
+    using Steps::Op;
+    using Steps::AbsAddrTag;
+    using Steps::AbsAddress;
+    using Steps::Step;
+    using Steps::TACUnary;
+    using Steps::OperNonary;
+    using Steps::OperUnary;
+    using Steps::OperTernary;
+
+    [[nodiscard]] static constexpr auto is_marker(Op op) noexcept -> bool {
+        return op >= Op::meta_begin_while && op < Op::last;
+    }
+
+    /// NOTE: Some steps read and write through the same slot, which must only be renamed once.
+    template <typename Renamer>
+    static void rename_temps(Step& step, Renamer renamer) {
+        const auto uses = Steps::step_uses(step);
+        const std::array<AbsAddress*, 4> slots {uses[0], uses[1], uses[2], Steps::step_dest_slot(step)};
+
+        for (auto slot_n = 0UL; slot_n < slots.size(); ++slot_n) {
+            if (const auto slot_p = slots[slot_n]; slot_p && slot_p->tag == AbsAddrTag::temp && std::find(slots.begin(), slots.begin() + slot_n, slot_p) == slots.begin() + slot_n) {
+                *slot_p = renamer(*slot_p);
+            }
+        }
+    }
+
+    Inliner::Inliner(std::span<const CFG::CFG> cfgs, int step_budget) noexcept
+    : m_cfgs {cfgs}, m_step_budget {step_budget} {}
+
+    auto Inliner::layout_bb_ids(const CFG::CFG& cfg) -> std::vector<int> {
+        std::vector<int> bb_ids;
+        std::set<int> visited_ids;
+        std::stack<int> frontier;
+
+        frontier.push(0);
+
+        while (!frontier.empty()) {
+            const auto next_bb_id = frontier.top();
+            frontier.pop();
+
+            const auto next_bb_opt = cfg.get_bb(next_bb_id);
+
+            if (visited_ids.contains(next_bb_id) || !next_bb_opt) {
+                continue;
+            }
+
+            bb_ids.push_back(next_bb_id);
+            visited_ids.insert(next_bb_id);
+
+            if (const auto falsy_child_id = next_bb_opt.value()->falsy_id; falsy_child_id != -1) {
+                frontier.push(falsy_child_id);
+            }
+
+            if (const auto truthy_child_id = next_bb_opt.value()->truthy_id; truthy_child_id != -1) {
+                frontier.push(truthy_child_id);
+            }
+        }
+
+        return bb_ids;
+    }
+
+    auto Inliner::count_temps(const CFG::CFG& cfg) noexcept -> int {
+        auto temp_count = cfg.get_param_count();
+
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            for (auto step : cfg.get_bb(bb_id).value()->steps) {
+                const auto step_op = Steps::step_op(step);
+
+                for (const auto use_p : Steps::step_uses(step)) {
+                    if (use_p && use_p->tag == AbsAddrTag::temp) {
+                        temp_count = std::max(temp_count, use_p->id + ((step_op == Op::iter_next_or_jump) ? 2 : 1));
+                    }
+                }
+
+                if (const auto dest_p = Steps::step_dest_slot(step); dest_p && dest_p->tag == AbsAddrTag::temp) {
+                    temp_count = std::max(temp_count, dest_p->id + ((step_op == Op::iter_init) ? 2 : 1));
+                }
+
+                if (const auto call_p = std::get_if<OperTernary>(&step); call_p && (step_op == Op::call || step_op == Op::native_call)) {
+                    temp_count = std::max(temp_count, call_p->arg_2.id + call_p->arg_1.id);
+                }
+            }
+        }
+
+        return temp_count;
+    }
+
+    auto Inliner::check_callee(int callee_id, int arg_count) const -> std::optional<CalleeShape> {
+        if (callee_id < 0 || static_cast<std::size_t>(callee_id) >= m_cfgs.size()) {
+            return {};
+        }
+
+        const auto& callee = m_cfgs[callee_id];
+
+        if (callee.get_param_count() != arg_count) {
+            return {};
+        }
+
+        auto step_count = 0;
+        auto ret_count = 0;
+        auto loop_depth = 0;
+        auto last_op = Op::nop;
+
+        for (const auto bb_id : layout_bb_ids(callee)) {
+            for (const auto& step : callee.get_bb(bb_id).value()->steps) {
+                const auto step_op = Steps::step_op(step);
+
+                if (step_op == Op::meta_begin_while) {
+                    ++loop_depth;
+                } else if (step_op == Op::meta_end_while) {
+                    --loop_depth;
+                }
+
+                if (is_marker(step_op)) {
+                    continue;
+                }
+
+                /// NOTE: A `ret` within one of the callee's loops would become a `break` out of that loop instead.
+                if (step_op == Op::call || step_op == Op::halt || (step_op == Op::ret && loop_depth > 0) || ++step_count > m_step_budget) {
+                    return {};
+                }
+
+                ret_count += (step_op == Op::ret) ? 1 : 0;
+                last_op = step_op;
+            }
+        }
+
+        if (last_op != Op::ret) {
+            return {};
+        }
+
+        return CalleeShape {
+            .temp_count = count_temps(callee),
+            .has_early_ret = ret_count > 1,
+        };
+    }
+
+    void Inliner::inline_call(CFG::CFG& cfg, int bb_id, int call_pos, const CalleeShape& shape, int first_temp_id) const {
+        const auto call_step = std::get<OperTernary>(cfg.get_bb(bb_id).value()->steps[call_pos]);
+        const auto& callee = m_cfgs[call_step.arg_0.id];
+        const auto param_count = callee.get_param_count();
+        const auto result_aa = call_step.arg_2;
+
+        /// NOTE: Parameters are just the staged argument slots, so the arguments needn't be copied again.
+        auto rename_temp = [&](AbsAddress aa) noexcept {
+            return AbsAddress {
+                .tag = AbsAddrTag::temp,
+                .id = static_cast<int16_t>((aa.id < param_count) ? result_aa.id + aa.id : first_temp_id + aa.id - param_count),
+            };
+        };
+
+        // 1. Cut the caller's block at the call, as its later steps move to a block laid out after the callee's.
+        std::vector<Step> tail_steps;
+
+        {
+            auto& steps = cfg.get_bb(bb_id).value()->steps;
+
+            tail_steps.assign(std::make_move_iterator(steps.begin() + call_pos + 1), std::make_move_iterator(steps.end()));
+            steps.erase(steps.begin() + call_pos, steps.end());
+        }
+
+        // 2. Copy the callee's blocks with their links, renaming its temporaries and turning each `ret` into a copy to the result slot. Only an early one has to leave the once-run loop.
+        const auto callee_layout = layout_bb_ids(callee);
+        auto last_ret_bb_id = callee_layout.front();
+        auto last_ret_pos = 0;
+
+        for (const auto callee_bb_id : callee_layout) {
+            const auto& callee_steps = callee.get_bb(callee_bb_id).value()->steps;
+
+            for (auto step_pos = 0; step_pos < static_cast<int>(callee_steps.size()); ++step_pos) {
+                if (!is_marker(Steps::step_op(callee_steps[step_pos]))) {
+                    last_ret_bb_id = callee_bb_id;
+                    last_ret_pos = step_pos;
+                }
+            }
+        }
+
+        const auto first_copy_id = cfg.bb_count();
+
+        for (auto callee_bb_id = 0; callee_bb_id < callee.bb_count(); ++callee_bb_id) {
+            [[maybe_unused]] auto copy_id = cfg.add_bb();
+        }
+
+        const auto post_id = cfg.add_bb();
+
+        for (auto callee_bb_id = 0; callee_bb_id < callee.bb_count(); ++callee_bb_id) {
+            const auto& callee_bb = *callee.get_bb(callee_bb_id).value();
+            auto& copy_bb = *cfg.get_bb(first_copy_id + callee_bb_id).value();
+
+            copy_bb.truthy_id = (callee_bb.truthy_id != CFG::CFG::dud_bb_id) ? first_copy_id + callee_bb.truthy_id : CFG::CFG::dud_bb_id;
+            copy_bb.falsy_id = (callee_bb.falsy_id != CFG::CFG::dud_bb_id) ? first_copy_id + callee_bb.falsy_id : CFG::CFG::dud_bb_id;
+
+            for (auto step_pos = 0; const auto& callee_step : callee_bb.steps) {
+                auto step = callee_step;
+
+                rename_temps(step, rename_temp);
+
+                if (const auto ret_p = std::get_if<OperUnary>(&step); ret_p && ret_p->op == Op::ret) {
+                    copy_bb.steps.emplace_back(TACUnary {
+                        .dest = result_aa,
+                        .arg_0 = ret_p->arg_0,
+                        .op = Op::nop,
+                    });
+
+                    if (shape.has_early_ret && (callee_bb_id != last_ret_bb_id || step_pos != last_ret_pos)) {
+                        copy_bb.steps.emplace_back(OperUnary {
+                            .arg_0 = {
+                                .tag = AbsAddrTag::immediate,
+                                .id = 0,
+                            },
+                            .op = Op::jump,
+                        });
+                        copy_bb.steps.emplace_back(OperNonary {
+                            .op = Op::meta_mark_break,
+                        });
+                    }
+                } else {
+                    copy_bb.steps.emplace_back(std::move(step));
+                }
+
+                ++step_pos;
+            }
+        }
+
+        // 3. Lay out the callee's copy right after the call's block and before the rest of the caller's steps, which keep the block's old links.
+        auto& call_bb = *cfg.get_bb(bb_id).value();
+        auto& post_bb = *cfg.get_bb(post_id).value();
+
+        post_bb.truthy_id = call_bb.truthy_id;
+        post_bb.falsy_id = call_bb.falsy_id;
+        call_bb.truthy_id = first_copy_id;
+        call_bb.falsy_id = post_id;
+
+        if (shape.has_early_ret) {
+            call_bb.steps.emplace_back(OperNonary {.op = Op::meta_begin_while});
+            call_bb.steps.emplace_back(OperNonary {.op = Op::nop});
+            call_bb.steps.emplace_back(OperNonary {.op = Op::meta_mark_while_check});
+            post_bb.steps.emplace_back(OperNonary {.op = Op::nop});
+            post_bb.steps.emplace_back(OperNonary {.op = Op::meta_end_while});
+        }
+
+        post_bb.steps.insert(post_bb.steps.end(), std::make_move_iterator(tail_steps.begin()), std::make_move_iterator(tail_steps.end()));
+    }
+
+    auto Inliner::apply([[maybe_unused]] const CFG::CFG& cfg) -> bool {
+        return true;
+    }
+
+    auto Inliner::apply(CFG::CFG& cfg) -> bool {
+        auto next_temp_id = count_temps(cfg);
+
+        /// NOTE: Inlining a call moves the rest of its block to a new block, which is scanned later on for more calls.
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            const auto& steps = cfg.get_bb(bb_id).value()->steps;
+            const int step_count = steps.size();
+
+            for (auto step_pos = 0; step_pos < step_count; ++step_pos) {
+                const auto call_p = std::get_if<OperTernary>(&steps[step_pos]);
+
+                /// NOTE: A structural marker right after the call would refer to it, so such a call stays.
+                if (!call_p || call_p->op != Op::call || (step_pos + 1 < step_count && is_marker(Steps::step_op(steps[step_pos + 1])))) {
+                    continue;
+                }
+
+                const auto shape_opt = check_callee(call_p->arg_0.id, call_p->arg_1.id);
+
+                if (!shape_opt) {
+                    continue;
+                }
+
+                const auto added_temp_count = shape_opt->temp_count - call_p->arg_1.id;
+
+                if (next_temp_id + added_temp_count >= std::numeric_limits<int16_t>::max()) {
+                    continue;
+                }
+
+                inline_call(cfg, bb_id, step_pos, shape_opt.value(), next_temp_id);
+                next_temp_id += added_temp_count;
+                break;
+            }
+        }
+
+        return true;
+    }
+}
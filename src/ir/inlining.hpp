@@ -0,0 +1,46 @@
+#ifndef MINUET_IR_INLINING_HPP
+#define MINUET_IR_INLINING_HPP
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "ir/pass.hpp"
+
+namespace Minuet::IR::Pass {
+    /**
+     * @brief Substitutes the bodies of small leaf functions for the calls to them, saving each call's frame switch and return. The callee's parameters become the call's argument slots, its other temporaries get fresh ones past the caller's, and each `ret` becomes a copy into the call's result slot.
+     * @note Only callees which call no other bytecode function are taken, so recursion never inlines. A callee with several returns is wrapped in a loop which runs once, where each early return breaks out, so its returns must not be nested in loops of its own.
+     */
+    class Inliner : public PassBase<bool> {
+    private:
+        struct CalleeShape {
+            int temp_count;
+            bool has_early_ret;
+        };
+
+        std::span<const CFG::CFG> m_cfgs;
+        int m_step_budget;
+
+        [[nodiscard]] static auto layout_bb_ids(const CFG::CFG& cfg) -> std::vector<int>;
+        [[nodiscard]] static auto count_temps(const CFG::CFG& cfg) noexcept -> int;
+
+        [[nodiscard]] auto check_callee(int callee_id, int arg_count) const -> std::optional<CalleeShape>;
+        void inline_call(CFG::CFG& cfg, int bb_id, int call_pos, const CalleeShape& shape, int first_temp_id) const;
+
+    public:
+        /**
+         * @brief Constructs the pass.
+         *
+         * @param cfgs Every function's CFG, indexed by function ID.
+         * @param step_budget The most steps (not counting markers) a callee may have.
+         */
+        Inliner(std::span<const CFG::CFG> cfgs, int step_budget) noexcept;
+
+        /// NOTE: A read-only CFG can't be rewritten, so this just succeeds.
+        [[nodiscard]] auto apply(const CFG::CFG& cfg) -> bool override;
+        [[nodiscard]] auto apply(CFG::CFG& cfg) -> bool override;
+    };
+}
+
+#endif
@@ -0,0 +1,472 @@
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <variant>
+
+#include "ir/loop_invariants.hpp"
+
+namespace Minuet::IR::Pass {
+    using Steps::Op;
+    using Steps::AbsAddrTag;
+    using Steps::AbsAddress;
+    using Steps::Step;
+    using Steps::TACUnary;
+    using Steps::TACBinary;
+    using Steps::OperNonary;
+    using Steps::OperUnary;
+    using Steps::OperBinary;
+    using Steps::OperTernary;
+    using SSA::StepRef;
+    using SSA::FlowBlock;
+    using SSA::NaturalLoop;
+
+    [[nodiscard]] static constexpr auto is_arithmetic(Op op) noexcept -> bool {
+        return op == Op::mul || op == Op::div || op == Op::mod || op == Op::add || op == Op::sub;
+    }
+
+    [[nodiscard]] static constexpr auto is_comparison(Op op) noexcept -> bool {
+        return op >= Op::equ && op <= Op::gte;
+    }
+
+    /// NOTE: The emitter resolves a jump by the last step before one of these markers, so that step must stay in place. The last step of a block is also kept, as its block's successor may start with such a marker.
+    [[nodiscard]] static auto is_marked_step(const CFG::CFG& cfg, StepRef ref) noexcept -> bool {
+        const auto& steps = cfg.get_bb(ref.bb_id).value()->steps;
+
+        if (static_cast<std::size_t>(ref.pos) + 1 >= steps.size()) {
+            return true;
+        }
+
+        const auto next_op = Steps::step_op(steps[ref.pos + 1]);
+
+        return next_op > Op::meta_begin_while && next_op < Op::last && next_op != Op::meta_begin_if_else;
+    }
+
+    /// NOTE: Iterator steps also write the position after their iterator.
+    template <typename DefVisitor>
+    static void visit_defs(const Step& step, DefVisitor visitor) {
+        if (const auto dest_opt = Steps::step_dest(step); dest_opt && dest_opt->tag == AbsAddrTag::temp) {
+            visitor(dest_opt->id);
+        }
+
+        if (const auto step_op = Steps::step_op(step); step_op == Op::iter_init) {
+            visitor(std::get<OperBinary>(step).arg_0.id + 1);
+        } else if (step_op == Op::iter_next_or_jump) {
+            visitor(std::get<OperTernary>(step).arg_0.id + 1);
+        }
+    }
+
+    LoopInvariantMover::LoopInvariantMover(std::set<int> pure_native_ids, std::set<int> reading_native_ids) noexcept
+    : m_pure_native_ids (std::move(pure_native_ids)), m_reading_native_ids (std::move(reading_native_ids)), m_pinned_ids {}, m_native_slot_ids {}, m_def_counts {}, m_ref_flags {}, m_sequence_flags {} {}
+
+    void LoopInvariantMover::index_temps(const CFG::CFG& cfg) {
+        auto temp_count = cfg.get_param_count();
+
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            for (auto step : cfg.get_bb(bb_id).value()->steps) {
+                for (const auto use_p : Steps::step_uses(step)) {
+                    if (use_p && use_p->tag == AbsAddrTag::temp) {
+                        temp_count = std::max(temp_count, use_p->id + 2);
+                    }
+                }
+
+                if (const auto dest_p = Steps::step_dest_slot(step); dest_p && dest_p->tag == AbsAddrTag::temp) {
+                    temp_count = std::max(temp_count, dest_p->id + 2);
+                }
+
+                if (const auto call_p = std::get_if<OperTernary>(&step); call_p && (call_p->op == Op::call || call_p->op == Op::native_call)) {
+                    temp_count = std::max(temp_count, call_p->arg_2.id + call_p->arg_1.id);
+                }
+            }
+        }
+
+        m_pinned_ids = SSAConstruction::find_pinned_temps(cfg);
+        m_native_slot_ids.clear();
+        m_def_counts.assign(temp_count, 0);
+
+        std::vector<bool> used_flags (temp_count, false);
+
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            for (auto step : cfg.get_bb(bb_id).value()->steps) {
+                visit_defs(step, [this](int temp_id) {
+                    ++m_def_counts[temp_id];
+                });
+
+                for (const auto use_p : Steps::step_uses(step)) {
+                    if (use_p && use_p->tag == AbsAddrTag::temp) {
+                        used_flags[use_p->id] = true;
+                    }
+                }
+
+                if (const auto call_p = std::get_if<OperTernary>(&step); call_p && call_p->op == Op::native_call) {
+                    for (auto slot_n = 0; slot_n < std::max(call_p->arg_1.id, static_cast<int16_t>(1)); ++slot_n) {
+                        m_native_slot_ids.insert(call_p->arg_2.id + slot_n);
+                    }
+                }
+            }
+        }
+
+        /// NOTE: Flags the temporaries whose every write is of some kind, where a copy is of the same kind as its source.
+        auto find_def_kind = [&cfg, temp_count, this](auto is_kind_op) {
+            std::vector<bool> kind_flags (temp_count, false);
+
+            for (auto temp_id = 0; temp_id < temp_count; ++temp_id) {
+                kind_flags[temp_id] = m_def_counts[temp_id] > 0;
+            }
+
+            for (auto changed = true; changed; ) {
+                changed = false;
+
+                for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+                    for (const auto& step : cfg.get_bb(bb_id).value()->steps) {
+                        const auto copy_p = std::get_if<TACUnary>(&step);
+                        const auto is_kind_def = is_kind_op(Steps::step_op(step)) || (copy_p && copy_p->op == Op::nop && copy_p->arg_0.tag == AbsAddrTag::temp && kind_flags[copy_p->arg_0.id]);
+
+                        visit_defs(step, [&](int temp_id) {
+                            if (!is_kind_def && kind_flags[temp_id]) {
+                                kind_flags[temp_id] = false;
+                                changed = true;
+                            }
+                        });
+                    }
+                }
+            }
+
+            return kind_flags;
+        };
+
+        // 1. Temporaries which only ever hold a sequence or string can't be dicts, whose lookups by `seq_obj_get` add absent keys. Preloaded tuples are also read-only, so their items are given by value.
+        m_sequence_flags = find_def_kind([](Op op) noexcept {
+            return op == Op::make_seq || op == Op::make_str || op == Op::load_obj;
+        });
+
+        const auto tuple_flags = find_def_kind([](Op op) noexcept {
+            return op == Op::load_obj;
+        });
+
+        // 2. Other sequences give items by reference, and a callee may return one. Parameters may be given item references too, and a copy of a reference or arithmetic on one still holds it.
+        m_ref_flags.assign(temp_count, false);
+
+        for (auto temp_id = 0; temp_id < temp_count; ++temp_id) {
+            m_ref_flags[temp_id] = used_flags[temp_id] && m_def_counts[temp_id] == 0;
+        }
+
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            for (const auto& step : cfg.get_bb(bb_id).value()->steps) {
+                if (const auto call_p = std::get_if<OperTernary>(&step); call_p && call_p->op == Op::call) {
+                    m_ref_flags[call_p->arg_2.id] = true;
+                } else if (call_p && (call_p->op == Op::seq_obj_get || call_p->op == Op::seq_obj_get_unchecked) && !tuple_flags[call_p->arg_1.id]) {
+                    m_ref_flags[call_p->arg_0.id] = true;
+                }
+            }
+        }
+
+        for (auto changed = true; changed; ) {
+            changed = false;
+
+            for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+                for (const auto& step : cfg.get_bb(bb_id).value()->steps) {
+                    const auto copy_p = std::get_if<TACUnary>(&step);
+                    const auto calc_p = std::get_if<TACBinary>(&step);
+                    const auto passes_ref = (copy_p && copy_p->op == Op::nop) || (calc_p && (calc_p->op == Op::mul || calc_p->op == Op::add || calc_p->op == Op::sub));
+
+                    if (!passes_ref) {
+                        continue;
+                    }
+
+                    const auto source_aa = (copy_p) ? copy_p->arg_0 : calc_p->arg_0;
+                    const auto dest_aa = (copy_p) ? copy_p->dest : calc_p->dest;
+
+                    if (source_aa.tag == AbsAddrTag::temp && dest_aa.tag == AbsAddrTag::temp && m_ref_flags[source_aa.id] && !m_ref_flags[dest_aa.id]) {
+                        m_ref_flags[dest_aa.id] = true;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    auto LoopInvariantMover::is_heap_write(const Step& step) const noexcept -> bool {
+        const auto is_ref = [this](AbsAddress aa) noexcept {
+            return aa.tag == AbsAddrTag::temp && m_ref_flags[aa.id];
+        };
+
+        switch (const auto step_op = Steps::step_op(step); step_op) {
+        case Op::seq_obj_push:
+        case Op::seq_obj_pop:
+        case Op::seq_obj_set:
+        case Op::frz_seq_obj:
+        case Op::dict_set:
+        case Op::inc:
+        case Op::dec:
+        case Op::call:
+            return true;
+        case Op::native_call:
+            {
+                const auto native_id = std::get<OperTernary>(step).arg_0.id;
+
+                return !m_pure_native_ids.contains(native_id) && !m_reading_native_ids.contains(native_id);
+            }
+        case Op::seq_obj_get:
+        case Op::seq_obj_get_unchecked:
+            return !m_sequence_flags[std::get<OperTernary>(step).arg_1.id];
+        case Op::neg:
+            return is_ref(std::get<OperUnary>(step).arg_0);
+        case Op::nop:
+            /// NOTE: Like the register allocator, this takes a native's argument slots to only hold copies which the native is done with.
+            if (const auto copy_p = std::get_if<TACUnary>(&step); copy_p) {
+                return is_ref(copy_p->dest) && !m_native_slot_ids.contains(copy_p->dest.id);
+            }
+
+            return false;
+        case Op::mul:
+        case Op::add:
+        case Op::sub:
+            return is_ref(std::get<TACBinary>(step).arg_0);
+        default:
+            return false;
+        }
+    }
+
+    auto LoopInvariantMover::hoist_invariants(CFG::CFG& cfg, const std::vector<FlowBlock>& blocks, const NaturalLoop& loop) const -> bool {
+        const auto& header = blocks[loop.header_id];
+
+        // 1. The loop must start right after its `#begin_while`, and only be entered by falling through it, so that steps put before the marker run once before every entry.
+        if (header.steps.empty()) {
+            return false;
+        }
+
+        const auto [head_bb_id, head_pos] = header.steps.front();
+
+        if (head_pos < 1 || Steps::step_op(cfg.get_bb(head_bb_id).value()->steps[head_pos - 1]) != Op::meta_begin_while) {
+            return false;
+        }
+
+        if (std::ranges::count_if(header.preds, [&loop](int pred_id) noexcept { return std::ranges::find(loop.block_ids, pred_id) == loop.block_ids.end(); }) != 1) {
+            return false;
+        }
+
+        // 2. Count the loop's writes of each temporary. A call's frame may overwrite every temporary from its argument base up, so those all count as written.
+        std::vector<StepRef> loop_refs;
+        std::vector<int> loop_def_counts (m_def_counts.size(), 0);
+        int min_call_base = std::numeric_limits<int16_t>::max();
+        auto heap_stable = true;
+
+        for (const auto block_id : loop.block_ids) {
+            for (const auto step_ref : blocks[block_id].steps) {
+                const auto& step = cfg.get_bb(step_ref.bb_id).value()->steps[step_ref.pos];
+
+                loop_refs.push_back(step_ref);
+                visit_defs(step, [&loop_def_counts](int temp_id) {
+                    ++loop_def_counts[temp_id];
+                });
+
+                if (const auto call_p = std::get_if<OperTernary>(&step); call_p && call_p->op == Op::call) {
+                    min_call_base = std::min(min_call_base, static_cast<int>(call_p->arg_2.id));
+                }
+
+                heap_stable = heap_stable && !is_heap_write(step);
+            }
+        }
+
+        const int loop_step_count = loop_refs.size();
+        const int header_step_count = header.steps.size();
+
+        auto step_at = [&cfg, &loop_refs](int step_n) -> const Step& {
+            return cfg.get_bb(loop_refs[step_n].bb_id).value()->steps[loop_refs[step_n].pos];
+        };
+
+        auto is_invariant = [&](AbsAddress aa) noexcept {
+            return aa.tag != AbsAddrTag::temp || (loop_def_counts[aa.id] == 0 && aa.id < min_call_base);
+        };
+
+        auto is_ref = [this](AbsAddress aa) noexcept {
+            return aa.tag == AbsAddrTag::temp && m_ref_flags[aa.id];
+        };
+
+        /// NOTE: The destination keeps its value across the whole loop once moved, so nothing else may write it.
+        auto is_sole_def = [&](AbsAddress aa) noexcept {
+            return aa.tag == AbsAddrTag::temp && m_def_counts[aa.id] == 1 && !m_pinned_ids.contains(aa.id) && !m_ref_flags[aa.id] && aa.id < min_call_base;
+        };
+
+        // 3. Pick the invariant steps until no more become so. Failing steps must also come before any effect or other failure in the loop check, which then runs just as before.
+        std::vector<bool> hoisted_flags (loop_step_count, false);
+        std::vector<int> hoisted_ids;
+
+        auto is_quiet_before = [&](int step_n, const std::vector<int>& group_ids) {
+            for (auto prior_n = 0; prior_n < step_n; ++prior_n) {
+                if (hoisted_flags[prior_n] || std::ranges::find(group_ids, prior_n) != group_ids.end()) {
+                    continue;
+                }
+
+                const auto& prior = step_at(prior_n);
+                const auto prior_op = Steps::step_op(prior);
+
+                if (is_heap_write(prior) || prior_op == Op::div || prior_op == Op::mod || !(std::holds_alternative<TACUnary>(prior) || std::holds_alternative<TACBinary>(prior) || std::holds_alternative<OperNonary>(prior) || prior_op == Op::load_obj)) {
+                    return false;
+                }
+            }
+
+            return true;
+        };
+
+        auto take_step = [&](int step_n) {
+            hoisted_flags[step_n] = true;
+            hoisted_ids.push_back(step_n);
+            visit_defs(step_at(step_n), [&loop_def_counts](int temp_id) {
+                --loop_def_counts[temp_id];
+            });
+        };
+
+        auto try_take_native = [&](int step_n, const OperTernary& call_step) {
+            const auto base_id = call_step.arg_2.id;
+            const auto arg_count = call_step.arg_1.id;
+
+            if (step_n >= header_step_count || !heap_stable || !m_pure_native_ids.contains(call_step.arg_0.id) || base_id + std::max(arg_count, static_cast<int16_t>(1)) > min_call_base) {
+                return false;
+            }
+
+            if (arg_count == 0 && (m_def_counts[base_id] != 1 || loop_def_counts[base_id] != 1)) {
+                return false;
+            }
+
+            // Each argument slot must only be written by one copy of an invariant just before the call, and the base slot also by the call.
+            std::vector<int> group_ids;
+
+            for (auto slot_id = base_id; slot_id < base_id + arg_count; ++slot_id) {
+                const auto slot_def_count = (slot_id == base_id) ? 2 : 1;
+
+                if (m_def_counts[slot_id] != slot_def_count || loop_def_counts[slot_id] != slot_def_count) {
+                    return false;
+                }
+
+                auto stage_n = step_n - 1;
+
+                while (stage_n >= 0 && Steps::step_dest(step_at(stage_n)) != AbsAddress {.tag = AbsAddrTag::temp, .id = slot_id}) {
+                    --stage_n;
+                }
+
+                const auto stage_p = (stage_n >= 0) ? std::get_if<TACUnary>(&step_at(stage_n)) : nullptr;
+
+                if (!stage_p || stage_p->op != Op::nop || hoisted_flags[stage_n] || !is_invariant(stage_p->arg_0) || is_marked_step(cfg, loop_refs[stage_n])) {
+                    return false;
+                }
+
+                group_ids.push_back(stage_n);
+            }
+
+            if (!is_quiet_before(step_n, group_ids)) {
+                return false;
+            }
+
+            std::ranges::sort(group_ids);
+
+            for (const auto stage_n : group_ids) {
+                take_step(stage_n);
+            }
+
+            take_step(step_n);
+
+            return true;
+        };
+
+        auto try_take = [&](int step_n) {
+            const auto& step = step_at(step_n);
+
+            if (is_marked_step(cfg, loop_refs[step_n])) {
+                return false;
+            }
+
+            if (const auto copy_p = std::get_if<TACUnary>(&step); copy_p) {
+                return copy_p->op == Op::nop && is_sole_def(copy_p->dest) && is_invariant(copy_p->arg_0) && !is_ref(copy_p->arg_0);
+            } else if (const auto calc_p = std::get_if<TACBinary>(&step); calc_p) {
+                const auto calc_op = calc_p->op;
+                const auto reads_heap = calc_op == Op::equ || calc_op == Op::neq || is_ref(calc_p->arg_0) || is_ref(calc_p->arg_1);
+                const auto may_fail = calc_op == Op::div || calc_op == Op::mod;
+
+                if (!(is_arithmetic(calc_op) || is_comparison(calc_op)) || !is_sole_def(calc_p->dest) || !is_invariant(calc_p->arg_0) || !is_invariant(calc_p->arg_1)) {
+                    return false;
+                }
+
+                return !(is_arithmetic(calc_op) && is_ref(calc_p->arg_0)) && (!reads_heap || heap_stable) && (!may_fail || (step_n < header_step_count && is_quiet_before(step_n, {})));
+            } else if (const auto load_p = std::get_if<OperUnary>(&step); load_p) {
+                return load_p->op == Op::load_obj && is_sole_def(load_p->arg_0);
+            }
+
+            return false;
+        };
+
+        for (auto changed = true; changed; ) {
+            changed = false;
+
+            for (auto step_n = 0; step_n < loop_step_count; ++step_n) {
+                if (hoisted_flags[step_n]) {
+                    continue;
+                }
+
+                if (const auto call_p = std::get_if<OperTernary>(&step_at(step_n)); call_p && call_p->op == Op::native_call) {
+                    changed = try_take_native(step_n, *call_p) || changed;
+                } else if (try_take(step_n)) {
+                    take_step(step_n);
+                    changed = true;
+                }
+            }
+        }
+
+        if (hoisted_ids.empty()) {
+            return false;
+        }
+
+        // 4. Move the picked steps in the order they were picked, which keeps each after the steps it reads.
+        std::vector<Step> moved_steps;
+        std::vector<StepRef> moved_refs;
+
+        for (const auto step_n : hoisted_ids) {
+            moved_steps.push_back(step_at(step_n));
+            moved_refs.push_back(loop_refs[step_n]);
+        }
+
+        std::ranges::sort(moved_refs, [](StepRef lhs, StepRef rhs) noexcept {
+            return (lhs.bb_id != rhs.bb_id) ? lhs.bb_id < rhs.bb_id : lhs.pos > rhs.pos;
+        });
+
+        for (const auto [bb_id, pos] : moved_refs) {
+            auto& steps = cfg.get_bb(bb_id).value()->steps;
+
+            steps.erase(steps.begin() + pos);
+        }
+
+        /// NOTE: Every moved step came after the marker, so erasing them left its position alone.
+        auto& head_steps = cfg.get_bb(head_bb_id).value()->steps;
+
+        head_steps.insert(head_steps.begin() + head_pos - 1, std::make_move_iterator(moved_steps.begin()), std::make_move_iterator(moved_steps.end()));
+
+        return true;
+    }
+
+    auto LoopInvariantMover::apply([[maybe_unused]] const CFG::CFG& cfg) -> bool {
+        return true;
+    }
+
+    auto LoopInvariantMover::apply(CFG::CFG& cfg) -> bool {
+        index_temps(cfg);
+
+        /// NOTE: Moving steps changes the traced flow, so the loops are found again after each loop's steps move. This ends once no loop has any left, as steps only ever move outward.
+        for (;;) {
+            auto blocks_opt = SSAConstruction::trace_flow(cfg);
+
+            if (!blocks_opt) {
+                return true;
+            }
+
+            auto& blocks = blocks_opt.value();
+
+            SSAConstruction::find_dominators(blocks);
+
+            const auto loops = SSAConstruction::find_loops(blocks);
+
+            if (std::ranges::none_of(loops, [&, this](const NaturalLoop& loop) { return hoist_invariants(cfg, blocks, loop); })) {
+                return true;
+            }
+        }
+    }
+}
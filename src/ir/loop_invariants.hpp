@@ -0,0 +1,45 @@
+#ifndef MINUET_IR_LOOP_INVARIANTS_HPP
+#define MINUET_IR_LOOP_INVARIANTS_HPP
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "ir/pass.hpp"
+#include "ir/ssa.hpp"
+
+namespace Minuet::IR::Pass {
+    /**
+     * @brief Loop-invariant code motion over a CFG's natural loops, found from the back edges of its traced flow to a dominating header. Steps whose operands no step in the loop writes are moved to a preheader right before the loop's `#begin_while` marker, so they run once per entry instead of once per iteration.
+     * @note Only arithmetic, comparisons, copies, `load_obj`, and calls of natives known to be pure are moved, and each only if its destination is written nowhere else in the function. Steps which may fail (division, modulo, and native calls) only move out of the loop check, which runs at least once anyway, and comparisons of objects or calls of natives only move out of loops which can't change any heap object. Temporaries which may hold an item reference are never taken as the left operand of moved arithmetic, since the VM writes the result through such a reference.
+     */
+    class LoopInvariantMover : public PassBase<bool> {
+    private:
+        std::set<int> m_pure_native_ids;
+        std::set<int> m_reading_native_ids;
+        std::set<int16_t> m_pinned_ids;
+        std::set<int16_t> m_native_slot_ids;
+        std::vector<int> m_def_counts;
+        std::vector<bool> m_ref_flags;
+        std::vector<bool> m_sequence_flags;
+
+        void index_temps(const CFG::CFG& cfg);
+        [[nodiscard]] auto is_heap_write(const Steps::Step& step) const noexcept -> bool;
+        [[nodiscard]] auto hoist_invariants(CFG::CFG& cfg, const std::vector<SSA::FlowBlock>& blocks, const SSA::NaturalLoop& loop) const -> bool;
+
+    public:
+        /**
+         * @brief Constructs the pass.
+         *
+         * @param pure_native_ids IDs of the native procedures which only read their arguments and give a plain value, without any other effect.
+         * @param reading_native_ids IDs of other native procedures which never change any heap object, though they may have other effects such as I/O.
+         */
+        LoopInvariantMover(std::set<int> pure_native_ids, std::set<int> reading_native_ids) noexcept;
+
+        /// NOTE: A read-only CFG can't be rewritten, so this just succeeds.
+        [[nodiscard]] auto apply(const CFG::CFG& cfg) -> bool override;
+        [[nodiscard]] auto apply(CFG::CFG& cfg) -> bool override;
+    };
+}
+
+#endif
@@ -0,0 +1,429 @@
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <variant>
+
+#include "ir/register_allocation.hpp"
+
+namespace Minuet::IR::Pass {
+    using Steps::Op;
+    using Steps::AbsAddrTag;
+    using Steps::AbsAddress;
+    using Steps::Step;
+    using Steps::OperBinary;
+    using Steps::OperTernary;
+    using SSA::StepRef;
+    using SSA::FlowBlock;
+    using SSA::SSAForm;
+
+    RegisterAllocator::RegisterAllocator() noexcept
+    : m_step_refs {}, m_step_uses {}, m_step_defs {}, m_intervals {}, m_groups {}, m_group_ids {}, m_calls {}, m_fixed_ids {}, m_temp_count {0} {}
+
+    auto RegisterAllocator::index_steps(const CFG::CFG& cfg, const std::vector<FlowBlock>& blocks) -> bool {
+        m_step_refs.clear();
+        m_step_uses.clear();
+        m_step_defs.clear();
+        m_groups.clear();
+        m_calls.clear();
+        m_temp_count = cfg.get_param_count();
+
+        auto note_temp = [this](std::vector<int16_t>& accesses, int temp_id) {
+            accesses.push_back(temp_id);
+            m_temp_count = std::max(m_temp_count, temp_id + 1);
+        };
+
+        // 1. Gather every step's reads and writes of temporaries, including the implicit ones of calls and iterators.
+        for (const auto& block : blocks) {
+            for (const auto step_ref : block.steps) {
+                auto step = cfg.get_bb(step_ref.bb_id).value()->steps[step_ref.pos];
+                const auto step_op = Steps::step_op(step);
+                const auto is_calling = step_op == Op::call || step_op == Op::native_call;
+                const int pos = m_step_refs.size();
+                std::vector<int16_t> uses;
+                std::vector<int16_t> defs;
+
+                for (const auto use_p : Steps::step_uses(step)) {
+                    /// NOTE: A call without arguments only writes its result slot.
+                    if (use_p && use_p->tag == AbsAddrTag::temp && !(is_calling && std::get<OperTernary>(step).arg_1.id == 0)) {
+                        note_temp(uses, use_p->id);
+                    }
+                }
+
+                if (const auto dest_opt = Steps::step_dest(step); dest_opt && dest_opt->tag == AbsAddrTag::temp) {
+                    note_temp(defs, dest_opt->id);
+                }
+
+                if (is_calling) {
+                    const auto& call_step = std::get<OperTernary>(step);
+
+                    for (auto slot_n = 1; slot_n < call_step.arg_1.id; ++slot_n) {
+                        note_temp(uses, call_step.arg_2.id + slot_n);
+                    }
+
+                    m_groups.emplace_back(SlotGroup {
+                        .base_id = call_step.arg_2.id,
+                        .size = std::max(call_step.arg_1.id, static_cast<int16_t>(1)),
+                        .kind = (step_op == Op::call) ? GroupKind::call : GroupKind::native_call,
+                    });
+
+                    if (step_op == Op::call) {
+                        m_calls.emplace_back(CallSite {pos, call_step.arg_2.id});
+                    }
+                } else if (step_op == Op::iter_init) {
+                    const auto iter_id = std::get<OperBinary>(step).arg_0.id;
+
+                    note_temp(defs, iter_id + 1);
+                    m_groups.emplace_back(SlotGroup {iter_id, 2, GroupKind::iterator});
+                } else if (step_op == Op::iter_next_or_jump) {
+                    const auto iter_id = std::get<OperTernary>(step).arg_0.id;
+
+                    note_temp(uses, iter_id + 1);
+                    note_temp(defs, iter_id + 1);
+                    m_groups.emplace_back(SlotGroup {iter_id, 2, GroupKind::iterator});
+                }
+
+                m_step_refs.push_back(step_ref);
+                m_step_uses.emplace_back(std::move(uses));
+                m_step_defs.emplace_back(std::move(defs));
+            }
+        }
+
+        // 2. Map each grouped temporary to its group, where a temporary can't belong to two different groups.
+        std::sort(m_groups.begin(), m_groups.end(), [](const SlotGroup& lhs, const SlotGroup& rhs) noexcept {
+            return (lhs.base_id != rhs.base_id) ? lhs.base_id < rhs.base_id : lhs.size < rhs.size;
+        });
+
+        m_groups.erase(std::unique(m_groups.begin(), m_groups.end(), [](const SlotGroup& lhs, const SlotGroup& rhs) noexcept {
+            return lhs.base_id == rhs.base_id && lhs.size == rhs.size && lhs.kind == rhs.kind;
+        }), m_groups.end());
+
+        m_group_ids.assign(m_temp_count, -1);
+
+        for (auto group_id = 0; const auto& [base_id, size, kind] : m_groups) {
+            for (auto slot_id = base_id; slot_id < base_id + size; ++slot_id) {
+                if (m_group_ids[slot_id] != -1) {
+                    return false;
+                }
+
+                m_group_ids[slot_id] = group_id;
+            }
+
+            ++group_id;
+        }
+
+        return true;
+    }
+
+    void RegisterAllocator::find_intervals(const std::vector<FlowBlock>& blocks, int param_count) {
+        const int block_count = blocks.size();
+        std::vector<int> first_positions (block_count, -1);
+        std::vector<std::vector<bool>> gen_sets (block_count, std::vector<bool> (m_temp_count, false));
+        std::vector<std::vector<bool>> kill_sets (block_count, std::vector<bool> (m_temp_count, false));
+
+        // 1. Find the temporaries each flow block reads before writing, and the ones it writes.
+        for (auto block_id = 0, pos = 0; block_id < block_count; ++block_id) {
+            first_positions[block_id] = pos;
+
+            for (auto step_n = 0UL; step_n < blocks[block_id].steps.size(); ++step_n, ++pos) {
+                for (const auto use_id : m_step_uses[pos]) {
+                    if (!kill_sets[block_id][use_id]) {
+                        gen_sets[block_id][use_id] = true;
+                    }
+                }
+
+                for (const auto def_id : m_step_defs[pos]) {
+                    kill_sets[block_id][def_id] = true;
+                }
+            }
+        }
+
+        // 2. Solve liveness backwards to a fixed point.
+        std::vector<std::vector<bool>> live_ins (block_count, std::vector<bool> (m_temp_count, false));
+        std::vector<std::vector<bool>> live_outs (block_count, std::vector<bool> (m_temp_count, false));
+
+        for (auto changed = true; changed; ) {
+            changed = false;
+
+            for (auto block_id = block_count - 1; block_id >= 0; --block_id) {
+                auto& live_out = live_outs[block_id];
+                auto& live_in = live_ins[block_id];
+
+                for (const auto succ_id : blocks[block_id].succs) {
+                    for (auto temp_id = 0; temp_id < m_temp_count; ++temp_id) {
+                        if (live_ins[succ_id][temp_id] && !live_out[temp_id]) {
+                            live_out[temp_id] = true;
+                        }
+                    }
+                }
+
+                for (auto temp_id = 0; temp_id < m_temp_count; ++temp_id) {
+                    if (!live_in[temp_id] && (gen_sets[block_id][temp_id] || (live_out[temp_id] && !kill_sets[block_id][temp_id]))) {
+                        live_in[temp_id] = true;
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        // 3. Widen each temporary's interval over its accesses and the ends of the blocks it's live through.
+        m_intervals.assign(m_temp_count, Interval {-1, -1});
+
+        auto extend_interval = [this](int temp_id, int pos) noexcept {
+            auto& [start, end] = m_intervals[temp_id];
+
+            start = (start == -1) ? pos : std::min(start, pos);
+            end = std::max(end, pos);
+        };
+
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            const int step_count = blocks[block_id].steps.size();
+
+            if (step_count == 0) {
+                continue;
+            }
+
+            const auto first_pos = first_positions[block_id];
+            const auto last_pos = first_pos + step_count - 1;
+
+            for (auto temp_id = 0; temp_id < m_temp_count; ++temp_id) {
+                if (live_ins[block_id][temp_id]) {
+                    extend_interval(temp_id, first_pos);
+                }
+
+                if (live_outs[block_id][temp_id]) {
+                    extend_interval(temp_id, last_pos);
+                }
+            }
+
+            for (auto pos = first_pos; pos <= last_pos; ++pos) {
+                for (const auto use_id : m_step_uses[pos]) {
+                    extend_interval(use_id, pos);
+                }
+
+                for (const auto def_id : m_step_defs[pos]) {
+                    extend_interval(def_id, pos);
+                }
+            }
+        }
+
+        // 4. Parameters, and anything else read before being written, must stay where the caller left them.
+        m_fixed_ids.clear();
+
+        for (int16_t temp_id = 0; temp_id < m_temp_count; ++temp_id) {
+            if (temp_id < param_count || live_ins[SSAForm::entry_block_id][temp_id]) {
+                m_fixed_ids.insert(temp_id);
+            }
+        }
+    }
+
+    auto RegisterAllocator::is_retired(const std::set<int16_t>& pinned_ids, int16_t temp_id) const noexcept -> bool {
+        if (!pinned_ids.contains(temp_id)) {
+            return false;
+        }
+
+        /// NOTE: Argument slots only ever hold copies which the callee is done with, and iterators hold their iterable by value. A result slot may still be given an item reference, though.
+        if (const auto group_id = m_group_ids[temp_id]; group_id != -1) {
+            const auto& [base_id, size, kind] = m_groups[group_id];
+
+            return kind != GroupKind::iterator && temp_id == base_id;
+        }
+
+        return true;
+    }
+
+    auto RegisterAllocator::assign_registers(const std::set<int16_t>& pinned_ids, int param_count) const -> std::optional<std::vector<int16_t>> {
+        std::vector<int16_t> regs (m_temp_count, -1);
+        std::set<int> free_regs;
+        std::vector<int16_t> active_ids;
+        auto next_reg = param_count;
+
+        for (const auto fixed_id : m_fixed_ids) {
+            if (m_group_ids[fixed_id] != -1) {
+                return {};
+            }
+
+            regs[fixed_id] = fixed_id;
+            next_reg = std::max(next_reg, fixed_id + 1);
+        }
+
+        /// NOTE: Registers below this were taken by temporaries which may still leave an item reference there, so no callee's frame may start below it either.
+        auto retired_top = next_reg;
+
+        for (auto reg = param_count; reg < next_reg; ++reg) {
+            if (!m_fixed_ids.contains(reg)) {
+                free_regs.insert(reg);
+            }
+        }
+
+        // 1. Order the temporaries to place by where their intervals start, keeping each group together.
+        std::vector<std::pair<int, int16_t>> pending_ids;
+
+        for (int16_t temp_id = 0; temp_id < m_temp_count; ++temp_id) {
+            const auto start = m_intervals[temp_id].start;
+
+            if (m_fixed_ids.contains(temp_id) || (start == -1 && m_group_ids[temp_id] == -1)) {
+                continue;
+            }
+
+            if (const auto group_id = m_group_ids[temp_id]; group_id == -1) {
+                pending_ids.emplace_back(start, temp_id);
+            } else if (m_groups[group_id].base_id == temp_id) {
+                auto group_start = -1;
+
+                for (auto slot_id = temp_id; slot_id < temp_id + m_groups[group_id].size; ++slot_id) {
+                    if (const auto slot_start = m_intervals[slot_id].start; slot_start != -1) {
+                        group_start = (group_start == -1) ? slot_start : std::min(group_start, slot_start);
+                    }
+                }
+
+                pending_ids.emplace_back(group_start, temp_id);
+            }
+        }
+
+        std::stable_sort(pending_ids.begin(), pending_ids.end(), [](const auto& lhs, const auto& rhs) noexcept {
+            return lhs.first < rhs.first;
+        });
+
+        /// NOTE: Gets the lowest run of free registers, where those past every taken one are free too.
+        auto take_regs = [&free_regs, &next_reg](int count) {
+            auto run_reg = next_reg;
+
+            for (const auto free_reg : free_regs) {
+                auto fits = true;
+
+                for (auto reg = free_reg + 1; reg < free_reg + count && reg < next_reg; ++reg) {
+                    fits = fits && free_regs.contains(reg);
+                }
+
+                if (fits) {
+                    run_reg = free_reg;
+                    break;
+                }
+            }
+
+            for (auto reg = run_reg; reg < run_reg + count; ++reg) {
+                free_regs.erase(reg);
+            }
+
+            next_reg = std::max(next_reg, run_reg + count);
+
+            return run_reg;
+        };
+
+        // 2. Scan the intervals, freeing the registers of the ones ended before giving out more.
+        for (const auto& [start, temp_id] : pending_ids) {
+            std::erase_if(active_ids, [&, this](int16_t active_id) {
+                if (m_intervals[active_id].end >= start) {
+                    return false;
+                }
+
+                if (!is_retired(pinned_ids, active_id)) {
+                    free_regs.insert(regs[active_id]);
+                }
+
+                return true;
+            });
+
+            const auto group_id = m_group_ids[temp_id];
+            const int16_t slot_count = (group_id == -1) ? 1 : m_groups[group_id].size;
+            int first_reg;
+
+            if (group_id != -1 && m_groups[group_id].kind == GroupKind::call) {
+                /// NOTE: The callee's frame starts at its first argument slot and may grow past any register above, so those must all be free of values needed afterwards.
+                first_reg = retired_top;
+
+                for (const auto active_id : active_ids) {
+                    first_reg = std::max(first_reg, regs[active_id] + 1);
+                }
+
+                for (auto reg = first_reg; reg < first_reg + slot_count; ++reg) {
+                    free_regs.erase(reg);
+                }
+
+                next_reg = std::max(next_reg, first_reg + slot_count);
+            } else if (group_id == -1 && is_retired(pinned_ids, temp_id)) {
+                /// NOTE: A register that may receive an item reference must be one no other temporary ever had. Otherwise, an earlier step of a loop body would write through the reference on the next iteration.
+                first_reg = next_reg;
+                ++next_reg;
+            } else {
+                first_reg = take_regs(slot_count);
+            }
+
+            for (auto slot_n = 0; slot_n < slot_count; ++slot_n) {
+                const int16_t slot_id = temp_id + slot_n;
+
+                regs[slot_id] = first_reg + slot_n;
+                active_ids.push_back(slot_id);
+
+                if (is_retired(pinned_ids, slot_id)) {
+                    retired_top = std::max(retired_top, first_reg + slot_n + 1);
+                }
+            }
+        }
+
+        return regs;
+    }
+
+    auto RegisterAllocator::is_call_safe(const std::vector<int16_t>& regs) const noexcept -> bool {
+        for (const auto [call_pos, base_id] : m_calls) {
+            const auto group_id = m_group_ids[base_id];
+
+            for (auto temp_id = 0; temp_id < m_temp_count; ++temp_id) {
+                if (regs[temp_id] == -1 || m_group_ids[temp_id] == group_id) {
+                    continue;
+                }
+
+                if (const auto [start, end] = m_intervals[temp_id]; start < call_pos && end > call_pos && regs[temp_id] >= regs[base_id]) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    auto RegisterAllocator::apply([[maybe_unused]] const CFG::CFG& cfg) -> bool {
+        return true;
+    }
+
+    auto RegisterAllocator::apply(CFG::CFG& cfg) -> bool {
+        const auto blocks_opt = SSAConstruction::trace_flow(cfg);
+
+        if (!blocks_opt || !index_steps(cfg, blocks_opt.value())) {
+            return true;
+        }
+
+        const auto param_count = cfg.get_param_count();
+
+        find_intervals(blocks_opt.value(), param_count);
+
+        const auto regs_opt = assign_registers(SSAConstruction::find_pinned_temps(cfg), param_count);
+
+        if (!regs_opt || !is_call_safe(regs_opt.value())) {
+            return true;
+        }
+
+        const auto& regs = regs_opt.value();
+
+        for (const auto [bb_id, pos] : m_step_refs) {
+            auto& step = cfg.get_bb(bb_id).value()->steps[pos];
+            const auto uses = Steps::step_uses(step);
+            const std::array<AbsAddress*, 4> slots {uses[0], uses[1], uses[2], Steps::step_dest_slot(step)};
+
+            /// NOTE: Some steps read and write through the same slot, which must only be renamed once.
+            for (auto slot_n = 0UL; slot_n < slots.size(); ++slot_n) {
+                const auto slot_p = slots[slot_n];
+
+                if (!slot_p || slot_p->tag != AbsAddrTag::temp || std::find(slots.begin(), slots.begin() + slot_n, slot_p) != slots.begin() + slot_n) {
+                    continue;
+                }
+
+                if (const auto reg = regs[slot_p->id]; reg != -1) {
+                    slot_p->id = reg;
+                }
+            }
+        }
+
+        return true;
+    }
+}
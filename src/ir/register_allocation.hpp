@@ -0,0 +1,68 @@
+#ifndef MINUET_IR_REGISTER_ALLOCATION_HPP
+#define MINUET_IR_REGISTER_ALLOCATION_HPP
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "ir/pass.hpp"
+#include "ir/ssa.hpp"
+
+namespace Minuet::IR::Pass {
+    /**
+     * @brief Linear-scan register allocation (Poletto & Sarkar) over a CFG's traced flow. Each temporary's live range is widened to one interval of the emitter's step order, and temporaries whose intervals don't overlap share a VM register, so a function's frame only grows with how many of its values are live at once.
+     * @note Parameters keep their registers. Temporaries which may hold an item reference get registers that no other temporary takes before or after them, as `mov` writes through those. A call's argument slots stay contiguous and above every register still in use across it, since the callee's frame starts there. A CFG whose flow can't be traced, or whose calls can't be satisfied so, keeps its original temporaries.
+     */
+    class RegisterAllocator : public PassBase<bool> {
+    private:
+        /// NOTE: Spans the positions where a temporary may be live, both ends included. Temporaries never mentioned have a `start` of -1.
+        struct Interval {
+            int start;
+            int end;
+        };
+
+        enum class GroupKind : uint8_t {
+            call,
+            native_call,
+            iterator,
+        };
+
+        /// NOTE: Temporaries which must get consecutive registers: a call's argument slots (the first also takes its result) or an iterator with its position.
+        struct SlotGroup {
+            int16_t base_id;
+            int16_t size;
+            GroupKind kind;
+        };
+
+        struct CallSite {
+            int pos;
+            int16_t base_id;
+        };
+
+        std::vector<SSA::StepRef> m_step_refs;
+        std::vector<std::vector<int16_t>> m_step_uses;
+        std::vector<std::vector<int16_t>> m_step_defs;
+        std::vector<Interval> m_intervals;
+        std::vector<SlotGroup> m_groups;
+        std::vector<int> m_group_ids;
+        std::vector<CallSite> m_calls;
+        std::set<int16_t> m_fixed_ids;
+        int m_temp_count;
+
+        [[nodiscard]] auto index_steps(const CFG::CFG& cfg, const std::vector<SSA::FlowBlock>& blocks) -> bool;
+        void find_intervals(const std::vector<SSA::FlowBlock>& blocks, int param_count);
+        [[nodiscard]] auto is_retired(const std::set<int16_t>& pinned_ids, int16_t temp_id) const noexcept -> bool;
+        [[nodiscard]] auto assign_registers(const std::set<int16_t>& pinned_ids, int param_count) const -> std::optional<std::vector<int16_t>>;
+        [[nodiscard]] auto is_call_safe(const std::vector<int16_t>& regs) const noexcept -> bool;
+
+    public:
+        RegisterAllocator() noexcept;
+
+        /// NOTE: A read-only CFG can't be rewritten, so this just succeeds.
+        [[nodiscard]] auto apply(const CFG::CFG& cfg) -> bool override;
+        [[nodiscard]] auto apply(CFG::CFG& cfg) -> bool override;
+    };
+}
+
+#endif
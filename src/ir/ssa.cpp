@@ -0,0 +1,965 @@
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <stack>
+#include <utility>
+#include <variant>
+
+#include "ir/ssa.hpp"
+
+namespace Minuet::IR::SSA {
+    using Steps::AbsAddrTag;
+    using Steps::AbsAddress;
+
+    SSAForm::SSAForm(CFG::CFG& cfg, std::vector<FlowBlock> blocks, std::vector<int16_t> origins)
+    : m_blocks (std::move(blocks)), m_dom_children {}, m_origins (std::move(origins)), m_cfg_p {&cfg} {
+        m_dom_children.resize(m_blocks.size());
+
+        for (auto block_id = 0; const auto& block : m_blocks) {
+            if (block.idom != dud_block_id) {
+                m_dom_children[block.idom].push_back(block_id);
+            }
+
+            ++block_id;
+        }
+    }
+
+    auto SSAForm::get_blocks() noexcept -> std::vector<FlowBlock>& {
+        return m_blocks;
+    }
+
+    auto SSAForm::get_blocks() const noexcept -> const std::vector<FlowBlock>& {
+        return m_blocks;
+    }
+
+    auto SSAForm::get_cfg() noexcept -> CFG::CFG& {
+        return *m_cfg_p;
+    }
+
+    auto SSAForm::get_step(StepRef ref) noexcept -> Steps::Step& {
+        return m_cfg_p->get_bb(ref.bb_id).value()->steps[ref.pos];
+    }
+
+    auto SSAForm::get_step(StepRef ref) const noexcept -> const Steps::Step& {
+        return static_cast<const CFG::CFG*>(m_cfg_p)->get_bb(ref.bb_id).value()->steps[ref.pos];
+    }
+
+    auto SSAForm::get_dom_children(int block_id) const noexcept -> const std::vector<int>& {
+        return m_dom_children[block_id];
+    }
+
+    auto SSAForm::is_reachable(int block_id) const noexcept -> bool {
+        return block_id == entry_block_id || m_blocks[block_id].idom != dud_block_id;
+    }
+
+    auto SSAForm::get_temp_count() const noexcept -> int {
+        return m_origins.size();
+    }
+
+    auto SSAForm::is_version(AbsAddress aa) const noexcept -> bool {
+        return aa.tag == AbsAddrTag::temp && aa.id >= 0 && static_cast<std::size_t>(aa.id) < m_origins.size() && m_origins[aa.id] != aa.id;
+    }
+
+    auto SSAForm::get_origin(AbsAddress aa) const noexcept -> AbsAddress {
+        if (aa.tag != AbsAddrTag::temp || aa.id < 0 || static_cast<std::size_t>(aa.id) >= m_origins.size()) {
+            return aa;
+        }
+
+        return AbsAddress {
+            .tag = AbsAddrTag::temp,
+            .id = m_origins[aa.id],
+        };
+    }
+
+    auto SSAForm::is_marked_step(StepRef ref) const noexcept -> bool {
+        const auto& steps = static_cast<const CFG::CFG*>(m_cfg_p)->get_bb(ref.bb_id).value()->steps;
+
+        if (static_cast<std::size_t>(ref.pos) + 1 >= steps.size()) {
+            return true;
+        }
+
+        switch (Steps::step_op(steps[ref.pos + 1])) {
+        case Steps::Op::meta_end_while:
+        case Steps::Op::meta_mark_while_check:
+        case Steps::Op::meta_mark_break:
+        case Steps::Op::meta_mark_continue:
+        case Steps::Op::meta_end_if_else:
+        case Steps::Op::meta_mark_if_else_check:
+        case Steps::Op::meta_mark_if_else_alt:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void SSAForm::remove_edge(int from_id, int to_id) {
+        auto& from_succs = m_blocks[from_id].succs;
+        auto& to_block = m_blocks[to_id];
+
+        std::erase(from_succs, to_id);
+
+        if (const auto pred_it = std::find(to_block.preds.begin(), to_block.preds.end(), from_id); pred_it != to_block.preds.end()) {
+            const auto pred_pos = pred_it - to_block.preds.begin();
+
+            for (auto& phi : to_block.phis) {
+                phi.args.erase(phi.args.begin() + pred_pos);
+            }
+
+            to_block.preds.erase(pred_it);
+        }
+    }
+
+    void SSAForm::remove_block(int block_id) {
+        for (const auto succ_id : std::vector<int> {m_blocks[block_id].succs}) {
+            remove_edge(block_id, succ_id);
+        }
+
+        for (const auto pred_id : std::vector<int> {m_blocks[block_id].preds}) {
+            remove_edge(pred_id, block_id);
+        }
+
+        auto& block = m_blocks[block_id];
+
+        if (block.idom != dud_block_id) {
+            std::erase(m_dom_children[block.idom], block_id);
+        }
+
+        block.phis.clear();
+        block.idom = dud_block_id;
+    }
+
+    void SSAForm::remove_steps(std::vector<StepRef> refs) {
+        std::sort(refs.begin(), refs.end(), [](StepRef lhs, StepRef rhs) noexcept {
+            return (lhs.bb_id != rhs.bb_id) ? lhs.bb_id < rhs.bb_id : lhs.pos > rhs.pos;
+        });
+
+        refs.erase(std::unique(refs.begin(), refs.end(), [](StepRef lhs, StepRef rhs) noexcept {
+            return lhs.bb_id == rhs.bb_id && lhs.pos == rhs.pos;
+        }), refs.end());
+
+        for (const auto [bb_id, pos] : refs) {
+            auto& steps = m_cfg_p->get_bb(bb_id).value()->steps;
+
+            steps.erase(steps.begin() + pos);
+        }
+
+        /// NOTE: Each remaining step moves back by how many erased steps came before it in its CFG block.
+        for (auto& block : m_blocks) {
+            std::vector<StepRef> kept_refs;
+
+            for (const auto step_ref : block.steps) {
+                auto shift = 0;
+                auto erased = false;
+
+                for (const auto [bb_id, pos] : refs) {
+                    if (bb_id == step_ref.bb_id && pos == step_ref.pos) {
+                        erased = true;
+                    } else if (bb_id == step_ref.bb_id && pos < step_ref.pos) {
+                        ++shift;
+                    }
+                }
+
+                if (!erased) {
+                    kept_refs.emplace_back(StepRef {step_ref.bb_id, step_ref.pos - shift});
+                }
+            }
+
+            block.steps = std::move(kept_refs);
+        }
+    }
+}
+
+namespace Minuet::IR::Pass {
+    using Steps::Op;
+    using Steps::Step;
+    using Steps::AbsAddrTag;
+    using Steps::AbsAddress;
+    using Steps::TACUnary;
+    using Steps::OperNonary;
+    using Steps::OperUnary;
+    using Steps::OperBinary;
+    using Steps::OperTernary;
+    using SSA::StepRef;
+    using SSA::Phi;
+    using SSA::FlowBlock;
+    using SSA::SSAForm;
+    using SSA::NaturalLoop;
+
+    [[nodiscard]] static constexpr auto is_marker(Op op) noexcept -> bool {
+        return op >= Op::meta_begin_while && op < Op::last;
+    }
+
+    [[nodiscard]] static constexpr auto is_branching(Op op) noexcept -> bool {
+        return op == Op::jump_if || op == Op::jump_else || op == Op::iter_next_or_jump;
+    }
+
+    [[nodiscard]] static constexpr auto is_flow_end(Op op) noexcept -> bool {
+        return op == Op::jump || op == Op::ret || op == Op::halt || is_branching(op);
+    }
+
+    [[nodiscard]] static auto step_at(const CFG::CFG& cfg, StepRef ref) noexcept -> const Step& {
+        return cfg.get_bb(ref.bb_id).value()->steps[ref.pos];
+    }
+
+    [[nodiscard]] static auto step_at(CFG::CFG& cfg, StepRef ref) noexcept -> Step& {
+        return cfg.get_bb(ref.bb_id).value()->steps[ref.pos];
+    }
+
+    SSAConstruction::SSAConstruction() noexcept = default;
+
+    auto SSAConstruction::trace_flow(const CFG::CFG& cfg) -> std::optional<std::vector<FlowBlock>> {
+        // 1. Lay out the steps in the emitter's order: depth-first, truthy children first.
+        std::vector<StepRef> layout;
+        std::set<int> visited_ids;
+        std::stack<int> frontier;
+
+        frontier.push(0);
+
+        while (!frontier.empty()) {
+            const auto next_bb_id = frontier.top();
+            frontier.pop();
+
+            if (visited_ids.contains(next_bb_id)) {
+                continue;
+            }
+
+            const auto next_bb_opt = cfg.get_bb(next_bb_id);
+
+            if (!next_bb_opt) {
+                return {};
+            }
+
+            const auto next_bb_p = next_bb_opt.value();
+
+            for (auto step_pos = 0; step_pos < static_cast<int>(next_bb_p->steps.size()); ++step_pos) {
+                layout.emplace_back(StepRef {next_bb_id, step_pos});
+            }
+
+            visited_ids.insert(next_bb_id);
+
+            if (const auto falsy_child_id = next_bb_p->falsy_id; falsy_child_id != -1) {
+                frontier.push(falsy_child_id);
+            }
+
+            if (const auto truthy_child_id = next_bb_p->truthy_id; truthy_child_id != -1) {
+                frontier.push(truthy_child_id);
+            }
+        }
+
+        const int layout_n = layout.size();
+        std::vector<int> next_real_ids (layout_n + 1, layout_n);
+
+        for (auto layout_id = layout_n - 1; layout_id >= 0; --layout_id) {
+            next_real_ids[layout_id] = (is_marker(Steps::step_op(step_at(cfg, layout[layout_id])))) ? next_real_ids[layout_id + 1] : layout_id;
+        }
+
+        // 2. Resolve each jump's target from the structural markers, as the emitter patches them.
+        struct PendingLoop {
+            std::vector<int> brk_ids;
+            std::vector<int> cont_ids;
+            int start_id;
+            int check_id;
+        };
+
+        struct PendingIfElse {
+            int check_id;
+            int alt_id;
+        };
+
+        std::vector<PendingLoop> pending_loops;
+        std::vector<PendingIfElse> pending_ifs;
+        std::vector<int> target_ids (layout_n, -1);
+        auto last_real_id = -1;
+
+        for (auto layout_id = 0; layout_id < layout_n; ++layout_id) {
+            const auto step_op = Steps::step_op(step_at(cfg, layout[layout_id]));
+
+            if (!is_marker(step_op)) {
+                last_real_id = layout_id;
+                continue;
+            }
+
+            const auto in_loop = !pending_loops.empty();
+            const auto in_if = !pending_ifs.empty();
+
+            if (step_op == Op::meta_begin_while) {
+                pending_loops.emplace_back(PendingLoop {
+                    .brk_ids = {},
+                    .cont_ids = {},
+                    .start_id = next_real_ids[layout_id],
+                    .check_id = -1,
+                });
+            } else if (step_op == Op::meta_begin_if_else) {
+                pending_ifs.emplace_back(PendingIfElse {
+                    .check_id = -1,
+                    .alt_id = -1,
+                });
+            } else if (last_real_id == -1 || (!in_loop && !in_if)) {
+                return {};
+            } else if (step_op == Op::meta_mark_while_check && in_loop) {
+                pending_loops.back().check_id = last_real_id;
+            } else if (step_op == Op::meta_mark_break && in_loop) {
+                pending_loops.back().brk_ids.push_back(last_real_id);
+            } else if (step_op == Op::meta_mark_continue && in_loop) {
+                pending_loops.back().cont_ids.push_back(last_real_id);
+            } else if (step_op == Op::meta_end_while && in_loop) {
+                const auto& [brk_ids, cont_ids, start_id, check_id] = pending_loops.back();
+
+                if (check_id == -1) {
+                    return {};
+                }
+
+                target_ids[check_id] = last_real_id;
+
+                for (const auto brk_id : brk_ids) {
+                    target_ids[brk_id] = last_real_id;
+                }
+
+                for (const auto cont_id : cont_ids) {
+                    target_ids[cont_id] = start_id;
+                }
+
+                pending_loops.pop_back();
+            } else if (step_op == Op::meta_mark_if_else_check && in_if) {
+                pending_ifs.back().check_id = last_real_id;
+            } else if (step_op == Op::meta_mark_if_else_alt && in_if) {
+                pending_ifs.back().alt_id = last_real_id;
+            } else if (step_op == Op::meta_end_if_else && in_if) {
+                const auto [check_id, alt_id] = pending_ifs.back();
+
+                if (check_id == -1) {
+                    return {};
+                }
+
+                if (alt_id != -1) {
+                    target_ids[check_id] = next_real_ids[alt_id + 1];
+                    target_ids[alt_id] = last_real_id;
+                } else {
+                    target_ids[check_id] = last_real_id;
+                }
+
+                pending_ifs.pop_back();
+            } else {
+                return {};
+            }
+        }
+
+        // 3. Find every real step's successors, and split the steps before each jump target and after each jump.
+        std::vector<std::vector<int>> succ_ids (layout_n);
+        std::vector<bool> leader_flags (layout_n, false);
+
+        for (auto layout_id = next_real_ids[0]; layout_id < layout_n; layout_id = next_real_ids[layout_id + 1]) {
+            const auto step_op = Steps::step_op(step_at(cfg, layout[layout_id]));
+            const auto next_id = next_real_ids[layout_id + 1];
+            const auto target_id = target_ids[layout_id];
+
+            if ((step_op == Op::jump || is_branching(step_op)) && (target_id == -1 || target_id >= layout_n)) {
+                return {};
+            }
+
+            if (step_op != Op::jump && step_op != Op::ret && step_op != Op::halt && next_id < layout_n) {
+                succ_ids[layout_id].push_back(next_id);
+            }
+
+            if (step_op == Op::jump || is_branching(step_op)) {
+                succ_ids[layout_id].push_back(target_id);
+                leader_flags[target_id] = true;
+            }
+
+            if (is_flow_end(step_op) && next_id < layout_n) {
+                leader_flags[next_id] = true;
+            }
+        }
+
+        // 4. Group the steps into flow blocks after an empty entry block, so that the entry never has predecessors.
+        std::vector<FlowBlock> blocks;
+        std::vector<int> block_ids (layout_n, -1);
+        std::vector<int> last_ids;
+
+        blocks.emplace_back(FlowBlock {
+            .steps = {},
+            .phis = {},
+            .preds = {},
+            .succs = {},
+            .idom = SSAForm::dud_block_id,
+        });
+        last_ids.push_back(-1);
+
+        for (auto layout_id = next_real_ids[0]; layout_id < layout_n; layout_id = next_real_ids[layout_id + 1]) {
+            if (blocks.size() == 1 || leader_flags[layout_id]) {
+                blocks.emplace_back(FlowBlock {
+                    .steps = {},
+                    .phis = {},
+                    .preds = {},
+                    .succs = {},
+                    .idom = SSAForm::dud_block_id,
+                });
+                last_ids.push_back(-1);
+            }
+
+            blocks.back().steps.push_back(layout[layout_id]);
+            block_ids[layout_id] = blocks.size() - 1;
+            last_ids.back() = layout_id;
+        }
+
+        if (blocks.size() > 1) {
+            blocks[SSAForm::entry_block_id].succs.push_back(1);
+        }
+
+        for (auto block_id = 1; block_id < static_cast<int>(blocks.size()); ++block_id) {
+            for (const auto succ_layout_id : succ_ids[last_ids[block_id]]) {
+                if (auto& succs = blocks[block_id].succs; std::find(succs.begin(), succs.end(), block_ids[succ_layout_id]) == succs.end()) {
+                    succs.push_back(block_ids[succ_layout_id]);
+                }
+            }
+        }
+
+        for (auto block_id = 0; block_id < static_cast<int>(blocks.size()); ++block_id) {
+            for (const auto succ_id : blocks[block_id].succs) {
+                blocks[succ_id].preds.push_back(block_id);
+            }
+        }
+
+        return blocks;
+    }
+
+    void SSAConstruction::find_dominators(std::vector<FlowBlock>& blocks) {
+        const int block_count = blocks.size();
+
+        // 1. Order the reachable blocks in reverse postorder.
+        std::vector<int> postorder;
+        std::vector<int> rpo_ids (block_count, -1);
+        std::vector<bool> seen_flags (block_count, false);
+        std::stack<std::pair<int, std::size_t>> frontier;
+
+        frontier.emplace(SSAForm::entry_block_id, 0UL);
+        seen_flags[SSAForm::entry_block_id] = true;
+
+        while (!frontier.empty()) {
+            auto& [block_id, succ_pos] = frontier.top();
+
+            if (succ_pos < blocks[block_id].succs.size()) {
+                const auto succ_id = blocks[block_id].succs[succ_pos];
+
+                ++succ_pos;
+
+                if (!seen_flags[succ_id]) {
+                    seen_flags[succ_id] = true;
+                    frontier.emplace(succ_id, 0UL);
+                }
+
+                continue;
+            }
+
+            postorder.push_back(block_id);
+            frontier.pop();
+        }
+
+        const std::vector<int> rpo (postorder.rbegin(), postorder.rend());
+
+        for (auto rpo_id = 0; const auto block_id : rpo) {
+            rpo_ids[block_id] = rpo_id;
+            ++rpo_id;
+        }
+
+        // 2. Unreachable blocks can't affect any dominance, so their edges are dropped.
+        for (auto& block : blocks) {
+            std::erase_if(block.preds, [&rpo_ids](int pred_id) noexcept {
+                return rpo_ids[pred_id] == -1;
+            });
+        }
+
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            if (rpo_ids[block_id] == -1) {
+                blocks[block_id].preds.clear();
+                blocks[block_id].succs.clear();
+            }
+        }
+
+        // 3. Iterate the immediate dominators to a fixed point (Cooper, Harvey & Kennedy).
+        std::vector<int> idoms (block_count, -1);
+
+        idoms[SSAForm::entry_block_id] = SSAForm::entry_block_id;
+
+        auto intersect = [&idoms, &rpo_ids](int lhs_id, int rhs_id) noexcept {
+            while (lhs_id != rhs_id) {
+                while (rpo_ids[lhs_id] > rpo_ids[rhs_id]) {
+                    lhs_id = idoms[lhs_id];
+                }
+
+                while (rpo_ids[rhs_id] > rpo_ids[lhs_id]) {
+                    rhs_id = idoms[rhs_id];
+                }
+            }
+
+            return lhs_id;
+        };
+
+        for (auto changed = true; changed; ) {
+            changed = false;
+
+            for (auto rpo_pos = 1UL; rpo_pos < rpo.size(); ++rpo_pos) {
+                const auto block_id = rpo[rpo_pos];
+                auto new_idom = -1;
+
+                for (const auto pred_id : blocks[block_id].preds) {
+                    if (idoms[pred_id] != -1) {
+                        new_idom = (new_idom == -1) ? pred_id : intersect(pred_id, new_idom);
+                    }
+                }
+
+                if (idoms[block_id] != new_idom) {
+                    idoms[block_id] = new_idom;
+                    changed = true;
+                }
+            }
+        }
+
+        for (auto block_id = 1; block_id < block_count; ++block_id) {
+            blocks[block_id].idom = idoms[block_id];
+        }
+    }
+
+    auto SSAConstruction::find_loops(const std::vector<FlowBlock>& blocks) -> std::vector<NaturalLoop> {
+        const int block_count = blocks.size();
+        std::vector<NaturalLoop> loops;
+
+        auto dominates = [&blocks](int dom_id, int block_id) noexcept {
+            for (auto next_id = block_id; next_id != SSAForm::dud_block_id; next_id = (next_id == SSAForm::entry_block_id) ? SSAForm::dud_block_id : blocks[next_id].idom) {
+                if (next_id == dom_id) {
+                    return true;
+                }
+            }
+
+            return false;
+        };
+
+        for (auto header_id = 1; header_id < block_count; ++header_id) {
+            std::vector<bool> member_flags (block_count, false);
+            std::vector<int> frontier;
+
+            member_flags[header_id] = true;
+
+            // 1. Each back edge comes from a block which the header dominates, and the loop holds every block reaching it backward without passing the header.
+            for (const auto pred_id : blocks[header_id].preds) {
+                if (dominates(header_id, pred_id) && !member_flags[pred_id]) {
+                    member_flags[pred_id] = true;
+                    frontier.push_back(pred_id);
+                }
+            }
+
+            if (frontier.empty()) {
+                continue;
+            }
+
+            while (!frontier.empty()) {
+                const auto next_id = frontier.back();
+                frontier.pop_back();
+
+                for (const auto pred_id : blocks[next_id].preds) {
+                    if (!member_flags[pred_id]) {
+                        member_flags[pred_id] = true;
+                        frontier.push_back(pred_id);
+                    }
+                }
+            }
+
+            NaturalLoop loop {
+                .block_ids = {header_id},
+                .header_id = header_id,
+            };
+
+            for (auto block_id = 0; block_id < block_count; ++block_id) {
+                if (member_flags[block_id] && block_id != header_id) {
+                    loop.block_ids.push_back(block_id);
+                }
+            }
+
+            loops.emplace_back(std::move(loop));
+        }
+
+        // 2. Inner loops go first, so that passes rewriting one loop at a time get to nested loops before the loops enclosing them.
+        std::stable_sort(loops.begin(), loops.end(), [](const NaturalLoop& lhs, const NaturalLoop& rhs) noexcept {
+            return lhs.block_ids.size() < rhs.block_ids.size();
+        });
+
+        return loops;
+    }
+
+    auto SSAConstruction::find_frontiers(const std::vector<FlowBlock>& blocks) -> std::vector<std::set<int>> {
+        std::vector<std::set<int>> frontiers (blocks.size());
+
+        for (auto block_id = 0; const auto& block : blocks) {
+            if (block.preds.size() >= 2) {
+                for (const auto pred_id : block.preds) {
+                    for (auto runner_id = pred_id; runner_id != block.idom && runner_id != SSAForm::dud_block_id; runner_id = blocks[runner_id].idom) {
+                        frontiers[runner_id].insert(block_id);
+                    }
+                }
+            }
+
+            ++block_id;
+        }
+
+        return frontiers;
+    }
+
+    auto SSAConstruction::find_pinned_temps(const CFG::CFG& cfg) -> std::set<int16_t> {
+        std::set<int16_t> pinned_ids;
+
+        // 1. Pin the temporaries with fixed places in the register frame, and the ones which may receive an item reference.
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            for (auto step : cfg.get_bb(bb_id).value()->steps) {
+                const auto step_op = Steps::step_op(step);
+
+                if (step_op == Op::call || step_op == Op::native_call) {
+                    const auto& call_step = std::get<OperTernary>(step);
+                    const auto slot_count = std::max(call_step.arg_1.id, static_cast<int16_t>(1));
+
+                    for (auto slot_n = 0; slot_n < slot_count; ++slot_n) {
+                        pinned_ids.insert(call_step.arg_2.id + slot_n);
+                    }
+                } else if (step_op == Op::iter_init || step_op == Op::iter_next_or_jump) {
+                    const auto iter_id = (step_op == Op::iter_init) ? std::get<OperBinary>(step).arg_0.id : std::get<OperTernary>(step).arg_0.id;
+
+                    pinned_ids.insert(iter_id);
+                    pinned_ids.insert(iter_id + 1);
+                } else if (const auto rmw_p = std::get_if<OperUnary>(&step); rmw_p && (step_op == Op::neg || step_op == Op::inc || step_op == Op::dec)) {
+                    pinned_ids.insert(rmw_p->arg_0.id);
+                } else if (step_op == Op::seq_obj_get || step_op == Op::seq_obj_get_unchecked) {
+                    pinned_ids.insert(std::get<OperTernary>(step).arg_0.id);
+                }
+            }
+        }
+
+        // 2. Parameters may receive item references as arguments, so even a write to one whose value is never read again must stay in place.
+        for (auto param_id = 0; param_id < cfg.get_param_count(); ++param_id) {
+            pinned_ids.insert(param_id);
+        }
+
+        // 3. Copies of pinned temporaries may also hold item references, and writes through those must stay in place.
+        for (auto changed = true; changed; ) {
+            changed = false;
+
+            for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+                for (const auto& step : cfg.get_bb(bb_id).value()->steps) {
+                    if (const auto copy_p = std::get_if<TACUnary>(&step); copy_p && copy_p->arg_0.tag == AbsAddrTag::temp && pinned_ids.contains(copy_p->arg_0.id) && !pinned_ids.contains(copy_p->dest.id)) {
+                        pinned_ids.insert(copy_p->dest.id);
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        return pinned_ids;
+    }
+
+    auto SSAConstruction::apply([[maybe_unused]] const CFG::CFG& cfg) -> std::optional<SSAForm> {
+        return {};
+    }
+
+    auto SSAConstruction::apply(CFG::CFG& cfg) -> std::optional<SSAForm> {
+        auto blocks_opt = trace_flow(cfg);
+
+        if (!blocks_opt) {
+            return {};
+        }
+
+        auto& blocks = blocks_opt.value();
+        const int block_count = blocks.size();
+
+        find_dominators(blocks);
+
+        const auto frontiers = find_frontiers(blocks);
+        const auto pinned_ids = find_pinned_temps(cfg);
+
+        // 1. Find the versioned temporaries, their defining blocks, and which of them are read in a block before any write there.
+        int16_t first_version_id = 0;
+        std::map<int16_t, std::set<int>> def_block_ids;
+        std::set<int16_t> crossing_ids;
+        auto version_count = 0;
+
+        /// NOTE: Versions are numbered past every temporary of the frame, including the implicit call argument slots and iterator positions.
+        auto reserve_temp = [&first_version_id](int temp_id) noexcept {
+            first_version_id = std::max(first_version_id, static_cast<int16_t>(temp_id + 1));
+        };
+
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            for (auto step : cfg.get_bb(bb_id).value()->steps) {
+                const auto step_op = Steps::step_op(step);
+
+                for (const auto use_p : Steps::step_uses(step)) {
+                    if (use_p && use_p->tag == AbsAddrTag::temp) {
+                        reserve_temp(use_p->id + ((step_op == Op::iter_next_or_jump) ? 1 : 0));
+                    }
+                }
+
+                if (const auto dest_p = Steps::step_dest_slot(step); dest_p && dest_p->tag == AbsAddrTag::temp) {
+                    reserve_temp(dest_p->id + ((step_op == Op::iter_init) ? 1 : 0));
+                }
+
+                if (const auto call_p = std::get_if<OperTernary>(&step); call_p && (step_op == Op::call || step_op == Op::native_call)) {
+                    reserve_temp(call_p->arg_2.id + call_p->arg_1.id - 1);
+                }
+            }
+        }
+
+        auto is_versioned = [&pinned_ids](AbsAddress aa) noexcept {
+            return aa.tag == AbsAddrTag::temp && !pinned_ids.contains(aa.id);
+        };
+
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            std::set<int16_t> written_ids;
+
+            for (const auto step_ref : blocks[block_id].steps) {
+                auto step = step_at(cfg, step_ref);
+
+                for (const auto use_p : Steps::step_uses(step)) {
+                    if (use_p && is_versioned(*use_p) && !written_ids.contains(use_p->id)) {
+                        crossing_ids.insert(use_p->id);
+                    }
+                }
+
+                if (const auto dest_p = Steps::step_dest_slot(step); dest_p && is_versioned(*dest_p)) {
+                    written_ids.insert(dest_p->id);
+                    def_block_ids[dest_p->id].insert(block_id);
+                    ++version_count;
+                }
+            }
+        }
+
+        // 2. Place phis on the iterated dominance frontiers of each crossing temporary's writes.
+        for (const auto& [temp_id, def_ids] : def_block_ids) {
+            if (!crossing_ids.contains(temp_id)) {
+                continue;
+            }
+
+            std::set<int> phi_block_ids;
+            std::vector<int> worklist (def_ids.begin(), def_ids.end());
+
+            while (!worklist.empty()) {
+                const auto next_id = worklist.back();
+                worklist.pop_back();
+
+                for (const auto frontier_id : frontiers[next_id]) {
+                    if (phi_block_ids.contains(frontier_id)) {
+                        continue;
+                    }
+
+                    const auto temp_aa = AbsAddress {AbsAddrTag::temp, temp_id};
+
+                    blocks[frontier_id].phis.emplace_back(Phi {
+                        .dest = temp_aa,
+                        .args = std::vector<AbsAddress> (blocks[frontier_id].preds.size(), temp_aa),
+                    });
+                    phi_block_ids.insert(frontier_id);
+                    ++version_count;
+
+                    if (!def_ids.contains(frontier_id)) {
+                        worklist.push_back(frontier_id);
+                    }
+                }
+            }
+        }
+
+        if (first_version_id + version_count >= std::numeric_limits<int16_t>::max()) {
+            return {};
+        }
+
+        // 3. Rename along the dominator tree, where the version atop each temporary's stack reaches the current block. An empty stack gives the original temporary, as for parameters.
+        std::vector<int16_t> origins (first_version_id);
+        std::vector<std::vector<int16_t>> version_stacks (first_version_id);
+        std::vector<std::vector<int>> dom_children (block_count);
+        std::stack<std::pair<int, bool>> frontier;
+        std::vector<std::vector<int16_t>> pushed_ids (block_count);
+
+        for (int16_t temp_id = 0; temp_id < first_version_id; ++temp_id) {
+            origins[temp_id] = temp_id;
+        }
+
+        for (auto block_id = 1; block_id < block_count; ++block_id) {
+            if (blocks[block_id].idom != SSAForm::dud_block_id) {
+                dom_children[blocks[block_id].idom].push_back(block_id);
+            }
+        }
+
+        auto top_version = [&version_stacks](int16_t temp_id) noexcept {
+            return (version_stacks[temp_id].empty()) ? temp_id : version_stacks[temp_id].back();
+        };
+
+        frontier.emplace(SSAForm::entry_block_id, false);
+
+        while (!frontier.empty()) {
+            const auto block_id = frontier.top().first;
+            const auto leaving = frontier.top().second;
+
+            frontier.pop();
+
+            if (leaving) {
+                for (const auto temp_id : pushed_ids[block_id]) {
+                    version_stacks[temp_id].pop_back();
+                }
+
+                continue;
+            }
+
+            auto gen_version = [&](int16_t temp_id) {
+                const int16_t version_id = origins.size();
+
+                origins.push_back(temp_id);
+                version_stacks[temp_id].push_back(version_id);
+                pushed_ids[block_id].push_back(temp_id);
+
+                return version_id;
+            };
+
+            auto& block = blocks[block_id];
+
+            for (auto& phi : block.phis) {
+                phi.dest.id = gen_version(phi.dest.id);
+            }
+
+            for (const auto step_ref : block.steps) {
+                auto& step = step_at(cfg, step_ref);
+
+                for (const auto use_p : Steps::step_uses(step)) {
+                    if (use_p && is_versioned(*use_p)) {
+                        use_p->id = top_version(use_p->id);
+                    }
+                }
+
+                if (const auto dest_p = Steps::step_dest_slot(step); dest_p && is_versioned(*dest_p)) {
+                    dest_p->id = gen_version(dest_p->id);
+                }
+            }
+
+            for (const auto succ_id : block.succs) {
+                auto& succ_block = blocks[succ_id];
+                const auto pred_pos = std::find(succ_block.preds.begin(), succ_block.preds.end(), block_id) - succ_block.preds.begin();
+
+                for (auto& phi : succ_block.phis) {
+                    phi.args[pred_pos].id = top_version(origins[phi.dest.id]);
+                }
+            }
+
+            frontier.emplace(block_id, true);
+
+            for (const auto child_id : dom_children[block_id]) {
+                frontier.emplace(child_id, false);
+            }
+        }
+
+        return SSAForm {cfg, std::move(blocks), std::move(origins)};
+    }
+
+
+    SSADestruction::SSADestruction(SSAForm& form) noexcept
+    : m_form_p {&form} {}
+
+    auto SSADestruction::apply([[maybe_unused]] const CFG::CFG& cfg) -> bool {
+        return false;
+    }
+
+    auto SSADestruction::apply(CFG::CFG& cfg) -> bool {
+        auto& form = *m_form_p;
+
+        if (&form.get_cfg() != &cfg) {
+            return false;
+        }
+
+        auto& blocks = form.get_blocks();
+        const int block_count = blocks.size();
+
+        // 1. Find the copies needed along each edge, for phi arguments which aren't versions of their phi's temporary.
+        std::map<std::pair<int, int>, std::vector<TACUnary>> edge_copies;
+
+        for (auto block_id = 0; block_id < block_count; ++block_id) {
+            const auto& block = blocks[block_id];
+
+            for (const auto& [phi_dest, phi_args] : block.phis) {
+                const auto dest_aa = form.get_origin(phi_dest);
+
+                for (auto pred_pos = 0UL; pred_pos < phi_args.size(); ++pred_pos) {
+                    if (const auto arg_aa = form.get_origin(phi_args[pred_pos]); arg_aa != dest_aa) {
+                        edge_copies[std::pair {block.preds[pred_pos], block_id}].emplace_back(TACUnary {
+                            .dest = dest_aa,
+                            .arg_0 = arg_aa,
+                            .op = Op::nop,
+                        });
+                    }
+                }
+            }
+        }
+
+        // 2. Give every version its original temporary back.
+        for (const auto& block : blocks) {
+            for (const auto step_ref : block.steps) {
+                auto& step = form.get_step(step_ref);
+
+                for (const auto use_p : Steps::step_uses(step)) {
+                    if (use_p) {
+                        *use_p = form.get_origin(*use_p);
+                    }
+                }
+
+                if (const auto dest_p = Steps::step_dest_slot(step); dest_p) {
+                    *dest_p = form.get_origin(*dest_p);
+                }
+            }
+        }
+
+        // 3. Place the copies of each edge where only that edge runs them, before any jump ending the predecessor. A jump target's leading `nop` must also stay first, as jumps land on it.
+        std::vector<std::pair<StepRef, TACUnary>> insertions;
+
+        for (const auto& [edge, copies] : edge_copies) {
+            const auto& [pred_id, succ_id] = edge;
+            const auto& pred_block = blocks[pred_id];
+            const auto& succ_block = blocks[succ_id];
+
+            for (const auto& copy : copies) {
+                for (const auto& other_copy : copies) {
+                    if (copy.dest == other_copy.arg_0 && &copy != &other_copy) {
+                        return false;
+                    }
+                }
+            }
+
+            StepRef place_ref;
+
+            if (pred_block.succs.size() == 1 && !pred_block.steps.empty()) {
+                const auto last_ref = pred_block.steps.back();
+                const auto last_op = Steps::step_op(form.get_step(last_ref));
+
+                place_ref = StepRef {last_ref.bb_id, (last_op == Op::jump || is_branching(last_op)) ? last_ref.pos : last_ref.pos + 1};
+            } else if (succ_block.preds.size() == 1 && !succ_block.steps.empty()) {
+                const auto first_ref = succ_block.steps.front();
+                const auto first_nop_p = std::get_if<OperNonary>(&form.get_step(first_ref));
+
+                place_ref = StepRef {first_ref.bb_id, (first_nop_p && first_nop_p->op == Op::nop) ? first_ref.pos + 1 : first_ref.pos};
+            } else {
+                return false;
+            }
+
+            for (const auto& copy : copies) {
+                insertions.emplace_back(place_ref, copy);
+            }
+        }
+
+        /// NOTE: Later positions of a block are filled first, so that the earlier ones stay valid.
+        std::stable_sort(insertions.begin(), insertions.end(), [](const auto& lhs, const auto& rhs) noexcept {
+            return (lhs.first.bb_id != rhs.first.bb_id) ? lhs.first.bb_id < rhs.first.bb_id : lhs.first.pos > rhs.first.pos;
+        });
+
+        for (const auto& [place_ref, copy] : insertions) {
+            auto& steps = cfg.get_bb(place_ref.bb_id).value()->steps;
+
+            steps.insert(steps.begin() + place_ref.pos, Step {copy});
+        }
+
+        for (auto& block : blocks) {
+            block.phis.clear();
+        }
+
+        return true;
+    }
+}
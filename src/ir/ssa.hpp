@@ -0,0 +1,142 @@
+#ifndef MINUET_IR_SSA_HPP
+#define MINUET_IR_SSA_HPP
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "ir/pass.hpp"
+
+namespace Minuet::IR::SSA {
+    /// @brief Locates a step within one of its CFG's basic blocks.
+    struct StepRef {
+        int bb_id;
+        int pos;
+    };
+
+    /// @brief Merges the versions of a temporary which reach a flow block, with one argument per predecessor in the same order as `FlowBlock::preds`.
+    struct Phi {
+        Steps::AbsAddress dest;
+        std::vector<Steps::AbsAddress> args;
+    };
+
+    /**
+     * @brief A true basic block of executed steps. These are derived from the CFG's layout blocks, whose links only give the emitter's code order, by resolving every jump target from the structural markers just as the emitter does.
+     * @note Only real steps are listed, as markers never execute. A block ending in a conditional jump lists its fall-through successor first.
+     */
+    struct FlowBlock {
+        std::vector<StepRef> steps;
+        std::vector<Phi> phis;
+        std::vector<int> preds;
+        std::vector<int> succs;
+        int idom; // the entry block and unreachable blocks have none
+    };
+
+    /// @brief A header with every flow block reaching one of its back edges without passing it. Blocks are listed in the emitter's order, so the header comes first.
+    struct NaturalLoop {
+        std::vector<int> block_ids;
+        int header_id;
+    };
+
+    /**
+     * @brief Views a CFG whose steps were renamed into SSA form: every write of a versioned temporary makes a new one which dominates all of its reads, and phis merge the versions at control flow joins.
+     * @note Temporaries with fixed places in the register frame stay unversioned: call argument slots, iterator pairs, and any which may hold an item reference since writes go through those. Passes working on this form must not let two versions of the same temporary be live at once, as leaving SSA gives them back the original register.
+     */
+    class SSAForm {
+    public:
+        static constexpr auto entry_block_id = 0;
+        static constexpr auto dud_block_id = -1;
+
+    private:
+        std::vector<FlowBlock> m_blocks;
+        std::vector<std::vector<int>> m_dom_children;
+        std::vector<int16_t> m_origins;
+        CFG::CFG* m_cfg_p;
+
+    public:
+        SSAForm(CFG::CFG& cfg, std::vector<FlowBlock> blocks, std::vector<int16_t> origins);
+
+        [[nodiscard]] auto get_blocks() noexcept -> std::vector<FlowBlock>&;
+        [[nodiscard]] auto get_blocks() const noexcept -> const std::vector<FlowBlock>&;
+        [[nodiscard]] auto get_cfg() noexcept -> CFG::CFG&;
+
+        [[nodiscard]] auto get_step(StepRef ref) noexcept -> Steps::Step&;
+        [[nodiscard]] auto get_step(StepRef ref) const noexcept -> const Steps::Step&;
+
+        /// @brief Gets the flow blocks immediately dominated by a block, for walking the dominator tree from `entry_block_id`.
+        [[nodiscard]] auto get_dom_children(int block_id) const noexcept -> const std::vector<int>&;
+
+        [[nodiscard]] auto is_reachable(int block_id) const noexcept -> bool;
+
+        /// @brief Gets how many temporary IDs are in use, counting every version.
+        [[nodiscard]] auto get_temp_count() const noexcept -> int;
+
+        /// @brief Checks if an address is a version made by renaming, rather than an unversioned temporary.
+        [[nodiscard]] auto is_version(Steps::AbsAddress aa) const noexcept -> bool;
+
+        /// @brief Maps a version back to its original temporary. Other addresses are given as is.
+        [[nodiscard]] auto get_origin(Steps::AbsAddress aa) const noexcept -> Steps::AbsAddress;
+
+        /// @brief Checks if the emitter resolves a jump by this step, as the last one before a structural marker (possibly in a later block). Such steps must stay in place.
+        [[nodiscard]] auto is_marked_step(StepRef ref) const noexcept -> bool;
+
+        /// @brief Unlinks an edge which can never run, dropping its phi arguments.
+        void remove_edge(int from_id, int to_id);
+
+        /// @brief Detaches a block which can never run from the flow graph and dominator tree. Its steps stay listed, so that leaving SSA still renames any which must be kept.
+        void remove_block(int block_id);
+
+        /// @brief Erases steps from the CFG and re-points every flow block's steps past them.
+        /// @note Steps which a structural marker refers to must not be erased, or the emitter will patch the wrong jump.
+        void remove_steps(std::vector<StepRef> refs);
+    };
+}
+
+namespace Minuet::IR::Pass {
+    /**
+     * @brief Converts a CFG into SSA form by finding the dominator tree (Cooper-Harvey-Kennedy), dominance frontiers, placing phis for temporaries that live across flow blocks (semi-pruned), and renaming along the dominator tree.
+     * @note Gives nothing and leaves the CFG untouched if some jump's target can't be resolved or the versions would overflow the temporary IDs.
+     */
+    class SSAConstruction : public PassBase<std::optional<SSA::SSAForm>> {
+    private:
+        [[nodiscard]] static auto find_frontiers(const std::vector<SSA::FlowBlock>& blocks) -> std::vector<std::set<int>>;
+
+    public:
+        /// @brief Sets each flow block's immediate dominator, leaving unreachable blocks without one and dropping their edges.
+        static void find_dominators(std::vector<SSA::FlowBlock>& blocks);
+
+        /// @brief Finds the natural loops of flow blocks with dominators set, from the back edges to each header. Inner loops are listed before the loops enclosing them.
+        [[nodiscard]] static auto find_loops(const std::vector<SSA::FlowBlock>& blocks) -> std::vector<SSA::NaturalLoop>;
+
+        /// @brief Splits a CFG's steps into flow blocks in the emitter's order, with the entry block empty. Dominators and phis are left unset. Gives nothing if some jump's target can't be resolved.
+        [[nodiscard]] static auto trace_flow(const CFG::CFG& cfg) -> std::optional<std::vector<SSA::FlowBlock>>;
+
+        /// @brief Finds the temporaries with fixed places in the register frame or which may hold an item reference: call slots, iterator pairs, parameters, and copies of those.
+        [[nodiscard]] static auto find_pinned_temps(const CFG::CFG& cfg) -> std::set<int16_t>;
+
+        SSAConstruction() noexcept;
+
+        /// NOTE: A read-only CFG can't be renamed, so this gives nothing.
+        [[nodiscard]] auto apply(const CFG::CFG& cfg) -> std::optional<SSA::SSAForm> override;
+        [[nodiscard]] auto apply(CFG::CFG& cfg) -> std::optional<SSA::SSAForm> override;
+    };
+
+    /**
+     * @brief Takes a CFG out of SSA form: each version gets its original temporary back, and a phi whose argument isn't a version of its temporary becomes a copy along that edge.
+     * @note Such a copy goes at the end of a predecessor with one successor or at the start of a block with one predecessor. Copies on other edges, or ones which would clobber each other's sources, make this fail.
+     */
+    class SSADestruction : public PassBase<bool> {
+    private:
+        SSA::SSAForm* m_form_p;
+
+    public:
+        SSADestruction(SSA::SSAForm& form) noexcept;
+
+        /// NOTE: A read-only CFG can't be renamed, so this just fails.
+        [[nodiscard]] auto apply(const CFG::CFG& cfg) -> bool override;
+        [[nodiscard]] auto apply(CFG::CFG& cfg) -> bool override;
+    };
+}
+
+#endif
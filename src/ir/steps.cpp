@@ -1,5 +1,6 @@
 #include <array>
 #include <string_view>
+#include <type_traits>
 #include "ir/steps.hpp"
 
 namespace Minuet::IR::Steps {
@@ -10,13 +11,23 @@ namespace Minuet::IR::Steps {
         "seq_obj_push",
         "seq_obj_pop",
         "seq_obj_get",
+        "seq_obj_get_unchecked",
+        "seq_obj_set",
         "frz_seq_obj",
+        "make_dict",
+        "dict_get",
+        "dict_set",
+        "load_obj",
+        "iter_init",
+        "iter_next_or_jump",
         "neg",
         "inc",
         "dec",
         "mul",
         "div",
         "mod",
+        "shr",
+        "bit_and",
         "add",
         "sub",
         "equ",
@@ -60,4 +71,135 @@ namespace Minuet::IR::Steps {
         const auto aa_tag_ord = static_cast<std::size_t>(tag);
         return aa_names[aa_tag_ord];
     }
+
+    auto step_op(const Step& step) noexcept -> Op {
+        return std::visit([](const auto& step_v) noexcept {
+            return step_v.op;
+        }, step);
+    }
+
+    template <typename StepType>
+    [[nodiscard]] static constexpr auto dest_slot_of(StepType& step_v) noexcept {
+        using PlainType = std::remove_cvref_t<StepType>;
+        using SlotPtr = std::conditional_t<std::is_const_v<StepType>, const AbsAddress*, AbsAddress*>;
+
+        if constexpr (std::is_same_v<PlainType, TACUnary> || std::is_same_v<PlainType, TACBinary>) {
+            return SlotPtr {&step_v.dest};
+        } else if constexpr (std::is_same_v<PlainType, OperNonary>) {
+            return SlotPtr {nullptr};
+        } else {
+            switch (step_v.op) {
+            case Op::make_str:
+            case Op::make_seq:
+            case Op::seq_obj_pop:
+            case Op::seq_obj_get:
+            case Op::seq_obj_get_unchecked:
+            case Op::make_dict:
+            case Op::dict_get:
+            case Op::load_obj:
+            case Op::iter_init:
+            case Op::neg:
+            case Op::inc:
+            case Op::dec:
+                return SlotPtr {&step_v.arg_0};
+            case Op::call:
+            case Op::native_call:
+            case Op::iter_next_or_jump:
+                if constexpr (std::is_same_v<PlainType, OperTernary>) {
+                    return SlotPtr {&step_v.arg_2};
+                }
+                return SlotPtr {nullptr};
+            default:
+                return SlotPtr {nullptr};
+            }
+        }
+    }
+
+    auto step_dest(const Step& step) noexcept -> std::optional<AbsAddress> {
+        return std::visit([](const auto& step_v) noexcept -> std::optional<AbsAddress> {
+            if (const auto dest_p = dest_slot_of(step_v); dest_p) {
+                return *dest_p;
+            }
+
+            return {};
+        }, step);
+    }
+
+    auto step_dest_slot(Step& step) noexcept -> AbsAddress* {
+        return std::visit([](auto& step_v) noexcept -> AbsAddress* {
+            return dest_slot_of(step_v);
+        }, step);
+    }
+
+    auto step_uses(Step& step) noexcept -> std::array<AbsAddress*, 3> {
+        return std::visit([](auto& step_v) noexcept -> std::array<AbsAddress*, 3> {
+            using StepType = std::remove_cvref_t<decltype(step_v)>;
+
+            if constexpr (std::is_same_v<StepType, TACUnary>) {
+                return {&step_v.arg_0, nullptr, nullptr};
+            } else if constexpr (std::is_same_v<StepType, TACBinary>) {
+                return {&step_v.arg_0, &step_v.arg_1, nullptr};
+            } else if constexpr (std::is_same_v<StepType, OperNonary>) {
+                return {nullptr, nullptr, nullptr};
+            } else if constexpr (std::is_same_v<StepType, OperUnary>) {
+                switch (step_v.op) {
+                case Op::make_seq:
+                case Op::make_dict:
+                case Op::jump:
+                    return {nullptr, nullptr, nullptr};
+                default:
+                    return {&step_v.arg_0, nullptr, nullptr};
+                }
+            } else if constexpr (std::is_same_v<StepType, OperBinary>) {
+                switch (step_v.op) {
+                case Op::jump_if:
+                case Op::jump_else:
+                    return {&step_v.arg_0, nullptr, nullptr};
+                default:
+                    return {&step_v.arg_1, nullptr, nullptr};
+                }
+            } else {
+                switch (step_v.op) {
+                case Op::seq_obj_push:
+                    return {&step_v.arg_0, &step_v.arg_1, nullptr};
+                case Op::seq_obj_pop:
+                    return {&step_v.arg_1, nullptr, nullptr};
+                case Op::seq_obj_get:
+                case Op::seq_obj_get_unchecked:
+                case Op::dict_get:
+                    return {&step_v.arg_1, &step_v.arg_2, nullptr};
+                case Op::seq_obj_set:
+                case Op::dict_set:
+                    return {&step_v.arg_0, &step_v.arg_1, &step_v.arg_2};
+                case Op::iter_next_or_jump:
+                    return {&step_v.arg_0, nullptr, nullptr};
+                case Op::call:
+                case Op::native_call:
+                    return {&step_v.arg_2, nullptr, nullptr};
+                default:
+                    return {nullptr, nullptr, nullptr};
+                }
+            }
+        }, step);
+    }
+
+    auto step_mentions(const Step& step, AbsAddress aa) noexcept -> bool {
+        return std::visit([aa](const auto& step_v) noexcept -> bool {
+            using StepType = std::remove_cvref_t<decltype(step_v)>;
+
+            if constexpr (std::is_same_v<StepType, TACUnary>) {
+                return step_v.dest == aa || step_v.arg_0 == aa;
+            } else if constexpr (std::is_same_v<StepType, TACBinary>) {
+                return step_v.dest == aa || step_v.arg_0 == aa || step_v.arg_1 == aa;
+            } else if constexpr (std::is_same_v<StepType, OperUnary>) {
+                return step_v.arg_0 == aa;
+            } else if constexpr (std::is_same_v<StepType, OperBinary>) {
+                return step_v.arg_0 == aa || step_v.arg_1 == aa;
+            } else if constexpr (std::is_same_v<StepType, OperTernary>) {
+                return step_v.arg_0 == aa || step_v.arg_1 == aa || step_v.arg_2 == aa;
+            } else {
+                return false;
+            }
+        }, step);
+    }
 }
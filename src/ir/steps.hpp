@@ -1,7 +1,9 @@
 #ifndef MINUET_IR_STEPS_HPP
 #define MINUET_IR_STEPS_HPP
 
+#include <array>
 #include <cstdint>
+#include <optional>
 #include <string_view>
 #include <variant>
 
@@ -13,13 +15,23 @@ namespace Minuet::IR::Steps {
         seq_obj_push,
         seq_obj_pop,
         seq_obj_get,
+        seq_obj_get_unchecked,
+        seq_obj_set,
         frz_seq_obj,
+        make_dict,
+        dict_get,
+        dict_set,
+        load_obj,
+        iter_init,
+        iter_next_or_jump,
         neg,
         inc,
         dec,
         mul,
         div,
         mod,
+        shr,
+        bit_and,
         add,
         sub,
         equ,
@@ -105,6 +117,22 @@ namespace Minuet::IR::Steps {
     };
 
     using Step = std::variant<TACUnary, TACBinary, OperNonary, OperUnary, OperBinary, OperTernary>;
+
+    [[nodiscard]] auto step_op(const Step& step) noexcept -> Op;
+
+    /// @brief Gets the temporary which a step writes into, if any. Calls write their result into the base slot of their arguments, and `iter_next_or_jump` writes its item into `arg_2`.
+    /// @note Iterator steps also use the temporary after their `arg_0` as the iterator's position.
+    [[nodiscard]] auto step_dest(const Step& step) noexcept -> std::optional<AbsAddress>;
+
+    /// @brief Like `step_dest`, but points at the written operand so that passes may rename it.
+    [[nodiscard]] auto step_dest_slot(Step& step) noexcept -> AbsAddress*;
+
+    /// @brief Points at the operands which a step reads, so that passes may rename them. Unused entries are `nullptr`.
+    /// @note Calls also read the argument temporaries after their base slot, and iterator steps the position after their `arg_0`, which aren't listed here.
+    [[nodiscard]] auto step_uses(Step& step) noexcept -> std::array<AbsAddress*, 3>;
+
+    /// @brief Checks if a step has the address as any of its operands, whether read or written.
+    [[nodiscard]] auto step_mentions(const Step& step, AbsAddress aa) noexcept -> bool;
 }
 
 #endif
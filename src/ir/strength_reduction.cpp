@@ -0,0 +1,744 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <variant>
+
+#include "ir/strength_reduction.hpp"
+
+namespace Minuet::IR::Pass {
+    using Steps::Op;
+    using Steps::AbsAddrTag;
+    using Steps::AbsAddress;
+    using Steps::Step;
+    using Steps::TACUnary;
+    using Steps::TACBinary;
+    using Steps::OperBinary;
+    using Steps::OperTernary;
+    using SSA::StepRef;
+    using SSA::FlowBlock;
+    using SSA::SSAForm;
+    using SSA::NaturalLoop;
+    using Runtime::FVTag;
+    using Runtime::FastValue;
+
+    [[nodiscard]] static constexpr auto is_int_arithmetic(Op op) noexcept -> bool {
+        return op == Op::mul || op == Op::div || op == Op::mod || op == Op::shr || op == Op::bit_and || op == Op::add || op == Op::sub;
+    }
+
+    [[nodiscard]] static constexpr auto is_same_ref(StepRef lhs, StepRef rhs) noexcept -> bool {
+        return lhs.bb_id == rhs.bb_id && lhs.pos == rhs.pos;
+    }
+
+    [[nodiscard]] static constexpr auto is_same_link(const TACBinary& lhs, const TACBinary& rhs) noexcept -> bool {
+        return lhs.op == rhs.op && lhs.dest == rhs.dest && lhs.arg_0 == rhs.arg_0 && lhs.arg_1 == rhs.arg_1;
+    }
+
+    /// NOTE: The emitter resolves a jump by the last step before one of these markers, so that step must stay in place. The last step of a block is also kept, as its block's successor may start with such a marker.
+    [[nodiscard]] static auto is_marked_step(const CFG::CFG& cfg, StepRef ref) noexcept -> bool {
+        const auto& steps = cfg.get_bb(ref.bb_id).value()->steps;
+
+        if (static_cast<std::size_t>(ref.pos) + 1 >= steps.size()) {
+            return true;
+        }
+
+        const auto next_op = Steps::step_op(steps[ref.pos + 1]);
+
+        return next_op > Op::meta_begin_while && next_op < Op::last && next_op != Op::meta_begin_if_else;
+    }
+
+    /// NOTE: Iterator steps also write the position after their iterator.
+    template <typename DefVisitor>
+    static void visit_defs(const Step& step, DefVisitor visitor) {
+        if (const auto dest_opt = Steps::step_dest(step); dest_opt && dest_opt->tag == AbsAddrTag::temp) {
+            visitor(dest_opt->id);
+        }
+
+        if (const auto step_op = Steps::step_op(step); step_op == Op::iter_init) {
+            visitor(std::get<OperBinary>(step).arg_0.id + 1);
+        } else if (step_op == Op::iter_next_or_jump) {
+            visitor(std::get<OperTernary>(step).arg_0.id + 1);
+        }
+    }
+
+    /// NOTE: Flags the flow blocks of the loops nested within another loop, whose steps may run many times per iteration of it.
+    [[nodiscard]] static auto find_inner_blocks(const std::vector<FlowBlock>& blocks, const NaturalLoop& loop, const std::vector<NaturalLoop>& loops) -> std::vector<bool> {
+        std::vector<bool> inner_flags (blocks.size(), false);
+
+        for (const auto& other : loops) {
+            if (other.header_id != loop.header_id && std::ranges::find(loop.block_ids, other.header_id) != loop.block_ids.end()) {
+                for (const auto block_id : other.block_ids) {
+                    inner_flags[block_id] = true;
+                }
+            }
+        }
+
+        return inner_flags;
+    }
+
+    StrengthReducer::StrengthReducer(std::vector<FastValue>& constants) noexcept
+    : m_constants_p {&constants}, m_pinned_ids {}, m_def_counts {}, m_use_counts {}, m_int_flags {}, m_temp_count {0} {}
+
+    auto StrengthReducer::get_int_constant(AbsAddress aa) const noexcept -> std::optional<int> {
+        const auto& constants = *m_constants_p;
+
+        if (aa.tag != AbsAddrTag::constant || aa.id < 0 || static_cast<std::size_t>(aa.id) >= constants.size() || constants[aa.id].tag() != FVTag::int32) {
+            return {};
+        }
+
+        return constants[aa.id].to_scalar();
+    }
+
+    auto StrengthReducer::intern_int_constant(int value) -> std::optional<AbsAddress> {
+        auto& constants = *m_constants_p;
+        const int constant_count = constants.size();
+
+        for (auto constant_id = 0; constant_id < constant_count; ++constant_id) {
+            const AbsAddress constant_aa {
+                .tag = AbsAddrTag::constant,
+                .id = static_cast<int16_t>(constant_id),
+            };
+
+            if (get_int_constant(constant_aa) == value) {
+                return constant_aa;
+            }
+        }
+
+        if (constant_count >= std::numeric_limits<int16_t>::max()) {
+            return {};
+        }
+
+        constants.emplace_back(FastValue {value});
+
+        return AbsAddress {
+            .tag = AbsAddrTag::constant,
+            .id = static_cast<int16_t>(constant_count),
+        };
+    }
+
+    auto StrengthReducer::is_int(AbsAddress aa) const noexcept -> bool {
+        return get_int_constant(aa).has_value() || (aa.tag == AbsAddrTag::temp && m_int_flags[aa.id]);
+    }
+
+    void StrengthReducer::index_temps(const CFG::CFG& cfg) {
+        auto temp_count = cfg.get_param_count();
+
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            for (auto step : cfg.get_bb(bb_id).value()->steps) {
+                for (const auto use_p : Steps::step_uses(step)) {
+                    if (use_p && use_p->tag == AbsAddrTag::temp) {
+                        temp_count = std::max(temp_count, use_p->id + 2);
+                    }
+                }
+
+                if (const auto dest_p = Steps::step_dest_slot(step); dest_p && dest_p->tag == AbsAddrTag::temp) {
+                    temp_count = std::max(temp_count, dest_p->id + 2);
+                }
+
+                if (const auto call_p = std::get_if<OperTernary>(&step); call_p && (call_p->op == Op::call || call_p->op == Op::native_call)) {
+                    temp_count = std::max(temp_count, call_p->arg_2.id + call_p->arg_1.id);
+                }
+            }
+        }
+
+        m_temp_count = temp_count;
+        m_pinned_ids = SSAConstruction::find_pinned_temps(cfg);
+        m_def_counts.assign(temp_count, 0);
+        m_use_counts.assign(temp_count, 0);
+
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            for (auto step : cfg.get_bb(bb_id).value()->steps) {
+                visit_defs(step, [this](int temp_id) {
+                    ++m_def_counts[temp_id];
+                });
+
+                for (const auto use_p : Steps::step_uses(step)) {
+                    if (use_p && use_p->tag == AbsAddrTag::temp) {
+                        ++m_use_counts[use_p->id];
+                    }
+                }
+            }
+        }
+
+        /// NOTE: Flags the temporaries whose every write is an integer copy or integer arithmetic. Parameters may be given anything, even item references, so they're never taken.
+        const auto param_count = cfg.get_param_count();
+
+        m_int_flags.assign(temp_count, false);
+
+        for (auto temp_id = param_count; temp_id < temp_count; ++temp_id) {
+            m_int_flags[temp_id] = m_def_counts[temp_id] > 0 && !m_pinned_ids.contains(temp_id);
+        }
+
+        for (auto changed = true; changed; ) {
+            changed = false;
+
+            for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+                for (const auto& step : cfg.get_bb(bb_id).value()->steps) {
+                    const auto copy_p = std::get_if<TACUnary>(&step);
+                    const auto calc_p = std::get_if<TACBinary>(&step);
+                    const auto is_int_def = (copy_p && copy_p->op == Op::nop && is_int(copy_p->arg_0)) || (calc_p && is_int_arithmetic(calc_p->op) && is_int(calc_p->arg_0) && is_int(calc_p->arg_1));
+
+                    visit_defs(step, [&](int temp_id) {
+                        if (!is_int_def && m_int_flags[temp_id]) {
+                            m_int_flags[temp_id] = false;
+                            changed = true;
+                        }
+                    });
+                }
+            }
+        }
+    }
+
+    auto StrengthReducer::find_counter_steps(const CFG::CFG& cfg, const std::vector<FlowBlock>& blocks, const NaturalLoop& loop, const std::vector<int>& loop_def_counts) const -> std::vector<CounterStep> {
+        std::vector<CounterStep> counter_steps;
+
+        auto step_at = [&cfg](StepRef ref) -> const Step& {
+            return cfg.get_bb(ref.bb_id).value()->steps[ref.pos];
+        };
+
+        for (const auto block_id : loop.block_ids) {
+            const auto& block_steps = blocks[block_id].steps;
+
+            for (auto step_n = 0; step_n < static_cast<int>(block_steps.size()); ++step_n) {
+                const auto write_ref = block_steps[step_n];
+                const auto& step = step_at(write_ref);
+                const auto dest_opt = Steps::step_dest(step);
+
+                if (!dest_opt || dest_opt->tag != AbsAddrTag::temp || loop_def_counts[dest_opt->id] != 1 || !m_int_flags[dest_opt->id]) {
+                    continue;
+                }
+
+                const auto counter = dest_opt.value();
+                auto sum_ref = write_ref;
+
+                // 1. The sum may go to a temporary only read by the copy back to the counter, which then comes right after it.
+                if (const auto copy_p = std::get_if<TACUnary>(&step); copy_p && copy_p->op == Op::nop) {
+                    const auto sum_aa = copy_p->arg_0;
+
+                    if (step_n < 1 || sum_aa.tag != AbsAddrTag::temp || m_def_counts[sum_aa.id] != 1 || m_use_counts[sum_aa.id] != 1) {
+                        continue;
+                    }
+
+                    sum_ref = block_steps[step_n - 1];
+
+                    if (Steps::step_dest(step_at(sum_ref)) != sum_aa) {
+                        continue;
+                    }
+                }
+
+                // 2. The sum must step the counter by an integer constant.
+                const auto sum_p = std::get_if<TACBinary>(&step_at(sum_ref));
+                std::optional<int> step_opt;
+
+                if (!sum_p) {
+                    continue;
+                } else if (sum_p->op == Op::add && sum_p->arg_0 == counter) {
+                    step_opt = get_int_constant(sum_p->arg_1);
+                } else if (sum_p->op == Op::add && sum_p->arg_1 == counter) {
+                    step_opt = get_int_constant(sum_p->arg_0);
+                } else if (sum_p->op == Op::sub && sum_p->arg_0 == counter) {
+                    if (const auto negated_opt = get_int_constant(sum_p->arg_1); negated_opt && negated_opt.value() != std::numeric_limits<int>::min()) {
+                        step_opt = -negated_opt.value();
+                    }
+                }
+
+                if (!step_opt) {
+                    continue;
+                }
+
+                counter_steps.emplace_back(CounterStep {
+                    .counter = counter,
+                    .delta = step_opt.value(),
+                    .sum_ref = sum_ref,
+                    .write_ref = write_ref,
+                    .block_id = block_id,
+                });
+            }
+        }
+
+        return counter_steps;
+    }
+
+    auto StrengthReducer::reduce_counter_runs(CFG::CFG& cfg, const std::vector<FlowBlock>& blocks, const NaturalLoop& loop, const std::vector<NaturalLoop>& loops) -> bool {
+        const auto& header = blocks[loop.header_id];
+
+        // 1. The loop must start right after its `#begin_while`, and only be entered by falling through it, so that steps put before the marker run once before every entry.
+        if (header.steps.empty()) {
+            return false;
+        }
+
+        const auto [head_bb_id, head_pos] = header.steps.front();
+
+        if (head_pos < 1 || Steps::step_op(cfg.get_bb(head_bb_id).value()->steps[head_pos - 1]) != Op::meta_begin_while) {
+            return false;
+        }
+
+        if (std::ranges::count_if(header.preds, [&loop](int pred_id) noexcept { return std::ranges::find(loop.block_ids, pred_id) == loop.block_ids.end(); }) != 1) {
+            return false;
+        }
+
+        // 2. Count the loop's writes of each temporary. A call's frame may overwrite the new temporaries, which come after every other one, so loops with calls are left alone.
+        std::vector<int> loop_def_counts (m_temp_count, 0);
+
+        for (const auto block_id : loop.block_ids) {
+            for (const auto step_ref : blocks[block_id].steps) {
+                const auto& step = cfg.get_bb(step_ref.bb_id).value()->steps[step_ref.pos];
+
+                if (Steps::step_op(step) == Op::call) {
+                    return false;
+                }
+
+                visit_defs(step, [&loop_def_counts](int temp_id) {
+                    ++loop_def_counts[temp_id];
+                });
+            }
+        }
+
+        const auto inner_flags = find_inner_blocks(blocks, loop, loops);
+
+        auto dominates = [&blocks](int dom_id, int block_id) noexcept {
+            for (auto next_id = block_id; next_id != SSAForm::dud_block_id; next_id = (next_id == SSAForm::entry_block_id) ? SSAForm::dud_block_id : blocks[next_id].idom) {
+                if (next_id == dom_id) {
+                    return true;
+                }
+            }
+
+            return false;
+        };
+
+        /// NOTE: Blocks dominating every back edge run once per iteration.
+        auto runs_each_iteration = [&](int block_id) {
+            return !inner_flags[block_id] && std::ranges::all_of(header.preds, [&](int pred_id) {
+                return std::ranges::find(loop.block_ids, pred_id) == loop.block_ids.end() || dominates(block_id, pred_id);
+            });
+        };
+
+        auto is_invariant_int = [&, this](AbsAddress aa) noexcept {
+            return is_int(aa) && (aa.tag != AbsAddrTag::temp || loop_def_counts[aa.id] == 0);
+        };
+
+        for (const auto& counter_step : find_counter_steps(cfg, blocks, loop, loop_def_counts)) {
+            if (inner_flags[counter_step.block_id] || is_marked_step(cfg, counter_step.write_ref)) {
+                continue;
+            }
+
+            const auto counter = counter_step.counter;
+
+            /// NOTE: Each link reads the counter or the previous link's result, with an invariant integer as the other operand. Only the first may scale by `mul`, and subtraction only takes the invariant from its input.
+            auto is_link = [&, this](const TACBinary& calc, AbsAddress input, bool first) {
+                const auto dest = calc.dest;
+
+                if (dest.tag != AbsAddrTag::temp || dest == counter || m_def_counts[dest.id] != 1 || m_pinned_ids.contains(dest.id)) {
+                    return false;
+                }
+
+                switch (calc.op) {
+                case Op::mul:
+                    if (!first) {
+                        return false;
+                    }
+                    [[fallthrough]];
+                case Op::add:
+                    return (calc.arg_0 == input && is_invariant_int(calc.arg_1)) || (calc.arg_1 == input && is_invariant_int(calc.arg_0));
+                case Op::sub:
+                    return calc.arg_0 == input && is_invariant_int(calc.arg_1);
+                default:
+                    return false;
+                }
+            };
+
+            // 3. Gather the runs computing from the counter. Neither a run nor the later reads of its result may pass the counter's write, where the counter changes.
+            std::vector<DerivedRun> runs;
+
+            for (const auto block_id : loop.block_ids) {
+                const auto& block_steps = blocks[block_id].steps;
+                const int block_step_count = block_steps.size();
+
+                auto step_at = [&cfg, &block_steps](int step_n) -> Step& {
+                    return cfg.get_bb(block_steps[step_n].bb_id).value()->steps[block_steps[step_n].pos];
+                };
+
+                auto writes_counter = [&](int step_n) {
+                    return Steps::step_dest(step_at(step_n)) == counter;
+                };
+
+                for (auto step_n = 0; step_n < block_step_count; ++step_n) {
+                    const auto root_p = std::get_if<TACBinary>(&step_at(step_n));
+
+                    if (!root_p || is_same_ref(block_steps[step_n], counter_step.sum_ref) || !is_link(*root_p, counter, true)) {
+                        continue;
+                    }
+
+                    DerivedRun run {
+                        .step_ns = {step_n},
+                        .shape = {},
+                        .block_id = block_id,
+                        .renamable = false,
+                    };
+                    auto result = root_p->dest;
+
+                    if (root_p->op == Op::mul && m_use_counts[result.id] == 1) {
+                        for (auto next_n = step_n + 1; next_n < block_step_count && !writes_counter(next_n); ++next_n) {
+                            if (!Steps::step_mentions(step_at(next_n), result)) {
+                                continue;
+                            }
+
+                            if (const auto offset_p = std::get_if<TACBinary>(&step_at(next_n)); offset_p && is_link(*offset_p, result, false)) {
+                                run.step_ns.push_back(next_n);
+                                result = offset_p->dest;
+                            }
+
+                            break;
+                        }
+                    }
+
+                    // The result's reads may take the new temporary instead if they all come before the counter changes. Only steps which then go away must not be marked.
+                    auto later_use_count = 0;
+
+                    for (auto next_n = run.step_ns.back() + 1; next_n < block_step_count && !writes_counter(next_n); ++next_n) {
+                        for (const auto use_p : Steps::step_uses(step_at(next_n))) {
+                            later_use_count += (use_p && *use_p == result) ? 1 : 0;
+                        }
+                    }
+
+                    run.renamable = later_use_count == m_use_counts[result.id] && !is_marked_step(cfg, block_steps[run.step_ns.back()]);
+
+                    if (std::ranges::any_of(run.step_ns.begin(), run.step_ns.end() - 1, [&](int link_n) { return is_marked_step(cfg, block_steps[link_n]); })) {
+                        continue;
+                    }
+
+                    // Runs computing the same value have the same shape, which reads the counter and writes it in place of their own temporaries.
+                    auto input = counter;
+
+                    for (const auto link_n : run.step_ns) {
+                        auto link = std::get<TACBinary>(step_at(link_n));
+                        const auto link_result = link.dest;
+
+                        link.arg_0 = (link.arg_0 == input) ? counter : link.arg_0;
+                        link.arg_1 = (link.arg_1 == input) ? counter : link.arg_1;
+                        link.dest = counter;
+                        input = link_result;
+                        run.shape.push_back(link);
+                    }
+
+                    runs.emplace_back(std::move(run));
+                }
+            }
+
+            // 4. Take the first shape whose runs save steps, as the new temporary's own step runs once per counter step.
+            for (const auto& lead_run : runs) {
+                std::vector<const DerivedRun*> group;
+                auto saved_count = 0;
+                auto is_hot = false;
+
+                for (const auto& run : runs) {
+                    if (run.shape.size() != lead_run.shape.size() || !std::ranges::equal(run.shape, lead_run.shape, is_same_link)) {
+                        continue;
+                    }
+
+                    group.push_back(&run);
+
+                    if (inner_flags[run.block_id]) {
+                        is_hot = true;
+                    } else if (runs_each_iteration(run.block_id)) {
+                        saved_count += static_cast<int>(run.step_ns.size()) - ((run.renamable) ? 0 : 1);
+                    }
+                }
+
+                if (!is_hot && saved_count <= 1) {
+                    continue;
+                }
+
+                if (m_temp_count + 2 >= std::numeric_limits<int16_t>::max()) {
+                    return false;
+                }
+
+                const AbsAddress derived_aa {
+                    .tag = AbsAddrTag::temp,
+                    .id = static_cast<int16_t>(m_temp_count),
+                };
+                std::vector<Step> entry_steps;
+                std::optional<AbsAddress> delta_opt;
+
+                // The new temporary's step is the counter's, scaled by the run's `mul` operand if it has one. Products of constants wrap like the VM's `int32` arithmetic.
+                if (const auto& scale_link = lead_run.shape.front(); scale_link.op != Op::mul) {
+                    delta_opt = intern_int_constant(counter_step.delta);
+                } else if (const auto scale_aa = (scale_link.arg_0 == counter) ? scale_link.arg_1 : scale_link.arg_0; const auto scale_opt = get_int_constant(scale_aa)) {
+                    delta_opt = intern_int_constant(static_cast<int32_t>(static_cast<uint32_t>(scale_opt.value()) * static_cast<uint32_t>(counter_step.delta)));
+                } else if (counter_step.delta == 1) {
+                    delta_opt = scale_aa;
+                } else if (const auto step_opt = intern_int_constant(counter_step.delta); step_opt) {
+                    delta_opt = AbsAddress {
+                        .tag = AbsAddrTag::temp,
+                        .id = static_cast<int16_t>(m_temp_count + 1),
+                    };
+                    entry_steps.emplace_back(TACBinary {
+                        .dest = delta_opt.value(),
+                        .arg_0 = scale_aa,
+                        .arg_1 = step_opt.value(),
+                        .op = Op::mul,
+                    });
+                }
+
+                if (!delta_opt) {
+                    return false;
+                }
+
+                for (auto link_n = 0UL; link_n < lead_run.shape.size(); ++link_n) {
+                    auto link = lead_run.shape[link_n];
+
+                    if (link_n > 0) {
+                        link.arg_0 = (link.arg_0 == counter) ? derived_aa : link.arg_0;
+                        link.arg_1 = (link.arg_1 == counter) ? derived_aa : link.arg_1;
+                    }
+
+                    link.dest = derived_aa;
+                    entry_steps.emplace_back(link);
+                }
+
+                // 5. Rewrite each run: reads of a renamable result take the new temporary, and otherwise its last step copies from it. Other steps of the runs go away.
+                std::vector<StepRef> doomed_refs;
+
+                for (const auto run_p : group) {
+                    const auto& block_steps = blocks[run_p->block_id].steps;
+                    const int block_step_count = block_steps.size();
+
+                    auto step_at = [&cfg, &block_steps](int step_n) -> Step& {
+                        return cfg.get_bb(block_steps[step_n].bb_id).value()->steps[block_steps[step_n].pos];
+                    };
+
+                    const auto last_n = run_p->step_ns.back();
+                    const auto result = std::get<TACBinary>(step_at(last_n)).dest;
+
+                    for (const auto link_n : run_p->step_ns) {
+                        if (link_n != last_n || run_p->renamable) {
+                            doomed_refs.push_back(block_steps[link_n]);
+                        }
+                    }
+
+                    if (!run_p->renamable) {
+                        step_at(last_n) = TACUnary {
+                            .dest = result,
+                            .arg_0 = derived_aa,
+                            .op = Op::nop,
+                        };
+                        continue;
+                    }
+
+                    for (auto next_n = last_n + 1; next_n < block_step_count && Steps::step_dest(step_at(next_n)) != counter; ++next_n) {
+                        for (const auto use_p : Steps::step_uses(step_at(next_n))) {
+                            if (use_p && *use_p == result) {
+                                *use_p = derived_aa;
+                            }
+                        }
+                    }
+                }
+
+                // 6. Erase the doomed steps and put the new temporary's step right after the counter's write, going backward through each block so that positions stay valid. At the same position, the erasure goes first.
+                std::vector<std::pair<StepRef, bool>> edits;
+
+                for (const auto doomed_ref : doomed_refs) {
+                    edits.emplace_back(doomed_ref, false);
+                }
+
+                edits.emplace_back(StepRef {.bb_id = counter_step.write_ref.bb_id, .pos = counter_step.write_ref.pos + 1}, true);
+
+                std::ranges::sort(edits, [](const std::pair<StepRef, bool>& lhs, const std::pair<StepRef, bool>& rhs) noexcept {
+                    if (lhs.first.bb_id != rhs.first.bb_id) {
+                        return lhs.first.bb_id < rhs.first.bb_id;
+                    } else if (lhs.first.pos != rhs.first.pos) {
+                        return lhs.first.pos > rhs.first.pos;
+                    }
+
+                    return !lhs.second && rhs.second;
+                });
+
+                for (const auto& [edit_ref, inserts] : edits) {
+                    auto& steps = cfg.get_bb(edit_ref.bb_id).value()->steps;
+
+                    if (!inserts) {
+                        steps.erase(steps.begin() + edit_ref.pos);
+                        continue;
+                    }
+
+                    steps.insert(steps.begin() + edit_ref.pos, TACBinary {
+                        .dest = derived_aa,
+                        .arg_0 = derived_aa,
+                        .arg_1 = delta_opt.value(),
+                        .op = Op::add,
+                    });
+                }
+
+                /// NOTE: Every changed step came after the marker, so its position stayed the same.
+                auto& head_steps = cfg.get_bb(head_bb_id).value()->steps;
+
+                head_steps.insert(head_steps.begin() + head_pos - 1, std::make_move_iterator(entry_steps.begin()), std::make_move_iterator(entry_steps.end()));
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    auto StrengthReducer::find_guarded_sums(const CFG::CFG& cfg, const std::vector<FlowBlock>& blocks, const std::vector<NaturalLoop>& loops) const -> std::set<std::pair<int, int>> {
+        std::set<std::pair<int, int>> sum_positions;
+
+        auto step_at = [&cfg](StepRef ref) -> const Step& {
+            return cfg.get_bb(ref.bb_id).value()->steps[ref.pos];
+        };
+
+        for (const auto& loop : loops) {
+            const auto& header = blocks[loop.header_id];
+            const int header_step_count = header.steps.size();
+
+            // 1. The header must end with `jump_else` out of the loop on `i < n` or `n > i`, which only passes for two integers (or an item reference to one as `n`) when `i + 1` can't overflow.
+            if (header_step_count < 2 || header.succs.size() != 2 || std::ranges::find(loop.block_ids, header.succs[1]) != loop.block_ids.end()) {
+                continue;
+            }
+
+            const auto exit_p = std::get_if<OperBinary>(&step_at(header.steps[header_step_count - 1]));
+            const auto check_p = std::get_if<TACBinary>(&step_at(header.steps[header_step_count - 2]));
+
+            if (!exit_p || exit_p->op != Op::jump_else || !check_p || check_p->dest != exit_p->arg_0) {
+                continue;
+            }
+
+            const auto counter = (check_p->op == Op::lt) ? check_p->arg_0 : ((check_p->op == Op::gt) ? check_p->arg_1 : AbsAddress {});
+
+            if (counter.tag != AbsAddrTag::temp || !m_int_flags[counter.id]) {
+                continue;
+            }
+
+            // 2. The counter's only write in the loop must be a step by `1` outside the header and any inner loop, so that each one follows a passing check of the same value.
+            std::vector<int> loop_def_counts (m_temp_count, 0);
+
+            for (const auto block_id : loop.block_ids) {
+                for (const auto step_ref : blocks[block_id].steps) {
+                    visit_defs(step_at(step_ref), [&loop_def_counts](int temp_id) {
+                        ++loop_def_counts[temp_id];
+                    });
+                }
+            }
+
+            const auto inner_flags = find_inner_blocks(blocks, loop, loops);
+
+            for (const auto& counter_step : find_counter_steps(cfg, blocks, loop, loop_def_counts)) {
+                if (counter_step.counter == counter && counter_step.delta == 1 && counter_step.block_id != loop.header_id && !inner_flags[counter_step.block_id]) {
+                    sum_positions.emplace(counter_step.sum_ref.bb_id, counter_step.sum_ref.pos);
+                }
+            }
+        }
+
+        return sum_positions;
+    }
+
+    void StrengthReducer::narrow_divisions(CFG::CFG& cfg) {
+        auto blocks_opt = SSAConstruction::trace_flow(cfg);
+
+        if (!blocks_opt) {
+            return;
+        }
+
+        auto& blocks = blocks_opt.value();
+
+        SSAConstruction::find_dominators(blocks);
+
+        const auto guarded_sums = find_guarded_sums(cfg, blocks, SSAConstruction::find_loops(blocks));
+
+        // 1. Flag the integers whose every write is a copy, quotient, or remainder of non-negative values, or a guarded counter step by `1`. Products and other sums may overflow.
+        auto nonneg_flags = m_int_flags;
+
+        auto is_nonneg = [&, this](AbsAddress aa) noexcept {
+            if (const auto constant_opt = get_int_constant(aa); constant_opt) {
+                return constant_opt.value() >= 0;
+            }
+
+            return aa.tag == AbsAddrTag::temp && nonneg_flags[aa.id];
+        };
+
+        for (auto changed = true; changed; ) {
+            changed = false;
+
+            for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+                const auto& steps = cfg.get_bb(bb_id).value()->steps;
+
+                for (auto pos = 0; pos < static_cast<int>(steps.size()); ++pos) {
+                    const auto& step = steps[pos];
+                    const auto copy_p = std::get_if<TACUnary>(&step);
+                    const auto calc_p = std::get_if<TACBinary>(&step);
+                    const auto keeps_sign = calc_p && (calc_p->op == Op::div || calc_p->op == Op::mod || calc_p->op == Op::shr || calc_p->op == Op::bit_and || guarded_sums.contains({bb_id, pos}));
+                    const auto is_nonneg_def = (copy_p && copy_p->op == Op::nop && is_nonneg(copy_p->arg_0)) || (keeps_sign && is_nonneg(calc_p->arg_0) && is_nonneg(calc_p->arg_1));
+
+                    visit_defs(step, [&](int temp_id) {
+                        if (!is_nonneg_def && nonneg_flags[temp_id]) {
+                            nonneg_flags[temp_id] = false;
+                            changed = true;
+                        }
+                    });
+                }
+            }
+        }
+
+        // 2. Truncating division and remainder of a non-negative integer by `2^k` are just a right shift by `k` and a mask of the low `k` bits.
+        for (auto bb_id = 0; bb_id < cfg.bb_count(); ++bb_id) {
+            for (auto& step : cfg.get_bb(bb_id).value()->steps) {
+                const auto calc_p = std::get_if<TACBinary>(&step);
+
+                if (!calc_p || (calc_p->op != Op::div && calc_p->op != Op::mod) || !is_nonneg(calc_p->arg_0)) {
+                    continue;
+                }
+
+                const auto divisor_opt = get_int_constant(calc_p->arg_1);
+
+                if (!divisor_opt || divisor_opt.value() <= 0 || !std::has_single_bit(static_cast<uint32_t>(divisor_opt.value()))) {
+                    continue;
+                }
+
+                const auto divisor = static_cast<uint32_t>(divisor_opt.value());
+                const auto operand_opt = (calc_p->op == Op::div) ? intern_int_constant(std::countr_zero(divisor)) : intern_int_constant(static_cast<int>(divisor - 1));
+
+                if (!operand_opt) {
+                    continue;
+                }
+
+                calc_p->arg_1 = operand_opt.value();
+                calc_p->op = (calc_p->op == Op::div) ? Op::shr : Op::bit_and;
+            }
+        }
+    }
+
+    auto StrengthReducer::apply([[maybe_unused]] const CFG::CFG& cfg) -> bool {
+        return true;
+    }
+
+    auto StrengthReducer::apply(CFG::CFG& cfg) -> bool {
+        index_temps(cfg);
+
+        /// NOTE: Rewriting a loop changes the traced flow, so the loops are found again after each rewrite. Every rewrite takes steps out of a loop for fewer new ones, so this ends.
+        for (;;) {
+            auto blocks_opt = SSAConstruction::trace_flow(cfg);
+
+            if (!blocks_opt) {
+                return true;
+            }
+
+            auto& blocks = blocks_opt.value();
+
+            SSAConstruction::find_dominators(blocks);
+
+            const auto loops = SSAConstruction::find_loops(blocks);
+
+            if (std::ranges::none_of(loops, [&, this](const NaturalLoop& loop) { return reduce_counter_runs(cfg, blocks, loop, loops); })) {
+                break;
+            }
+
+            index_temps(cfg);
+        }
+
+        narrow_divisions(cfg);
+
+        return true;
+    }
+}
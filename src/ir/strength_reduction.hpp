@@ -0,0 +1,69 @@
+#ifndef MINUET_IR_STRENGTH_REDUCTION_HPP
+#define MINUET_IR_STRENGTH_REDUCTION_HPP
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "ir/pass.hpp"
+#include "ir/ssa.hpp"
+#include "runtime/fast_value.hpp"
+
+namespace Minuet::IR::Pass {
+    /**
+     * @brief Induction variable analysis over a CFG's natural loops, which strength-reduces arithmetic on loop counters. A counter is an integer temporary whose only write within its loop is one constant step, and runs of steps computing `i * scale`, `i ± offset`, or `i * scale ± offset` from it are replaced by a new temporary. That one is computed once before the loop, then grows by `step * scale` right after each step of the counter. Divisions and modulos of proven non-negative integers by constant powers of two also become `shr` and `bit_and` steps.
+     * @note Scales and offsets must be integer constants or integer invariants of the loop, so the running sum wraps just like the product would. Since `mul` dispatches no slower than `add` in the VM, counter arithmetic is only reduced where that saves steps per iteration: a scaled and offset counter, the same value computed more than once, or one computed in an inner loop. A counter is only non-negative while every write of it is a copy, a quotient or remainder of non-negative values, or a step by `1` guarded by the loop check `i < n`, which can't pass for an `i` at the `int32` maximum.
+     */
+    class StrengthReducer : public PassBase<bool> {
+    private:
+        /// NOTE: Locates a counter's only write within a loop, the step `i = i ± c` or a sum `s = i ± c` copied back by `i = s` right after it.
+        struct CounterStep {
+            Steps::AbsAddress counter;
+            int delta;
+            SSA::StepRef sum_ref;
+            SSA::StepRef write_ref;
+            int block_id;
+        };
+
+        /// NOTE: Steps of one flow block, which compute a value from a counter's current value. Each step after the first reads its predecessor's result as the only use of it.
+        struct DerivedRun {
+            std::vector<int> step_ns;
+            std::vector<Steps::TACBinary> shape;
+            int block_id;
+            bool renamable;
+        };
+
+        std::vector<Runtime::FastValue>* m_constants_p;
+        std::set<int16_t> m_pinned_ids;
+        std::vector<int> m_def_counts;
+        std::vector<int> m_use_counts;
+        std::vector<bool> m_int_flags;
+        int m_temp_count;
+
+        [[nodiscard]] auto get_int_constant(Steps::AbsAddress aa) const noexcept -> std::optional<int>;
+        [[nodiscard]] auto intern_int_constant(int value) -> std::optional<Steps::AbsAddress>;
+        [[nodiscard]] auto is_int(Steps::AbsAddress aa) const noexcept -> bool;
+
+        void index_temps(const CFG::CFG& cfg);
+        [[nodiscard]] auto find_counter_steps(const CFG::CFG& cfg, const std::vector<SSA::FlowBlock>& blocks, const SSA::NaturalLoop& loop, const std::vector<int>& loop_def_counts) const -> std::vector<CounterStep>;
+        [[nodiscard]] auto reduce_counter_runs(CFG::CFG& cfg, const std::vector<SSA::FlowBlock>& blocks, const SSA::NaturalLoop& loop, const std::vector<SSA::NaturalLoop>& loops) -> bool;
+        [[nodiscard]] auto find_guarded_sums(const CFG::CFG& cfg, const std::vector<SSA::FlowBlock>& blocks, const std::vector<SSA::NaturalLoop>& loops) const -> std::set<std::pair<int, int>>;
+        void narrow_divisions(CFG::CFG& cfg);
+
+    public:
+        /**
+         * @brief Constructs the pass.
+         *
+         * @param constants The program's constants, which may get new ones for scaled steps, shift counts, and masks.
+         */
+        StrengthReducer(std::vector<Runtime::FastValue>& constants) noexcept;
+
+        /// NOTE: A read-only CFG can't be rewritten, so this just succeeds.
+        [[nodiscard]] auto apply(const CFG::CFG& cfg) -> bool override;
+        [[nodiscard]] auto apply(CFG::CFG& cfg) -> bool override;
+    };
+}
+
+#endif
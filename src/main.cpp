@@ -1,10 +1,15 @@
+#include <charconv>
 #include <iostream>
+#include <optional>
 #include <print>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "mintrinsics/mnl_stdio.hpp"
 #include "mintrinsics/mnl_lists.hpp"
+#include "mintrinsics/mnl_arrays.hpp"
+#include "mintrinsics/mnl_dicts.hpp"
 #include "mintrinsics/mnl_strings.hpp"
 #include "mintrinsics/mnl_utils.hpp"
 #include "driver/driver.hpp"
@@ -14,19 +19,22 @@
 constexpr auto minuet_version_major = 0;
 constexpr auto minuet_version_minor = 8;
 constexpr auto minuet_version_patch = 0;
-constexpr auto minuet_run_argv_offset = 3;
+constexpr auto minuet_run_argv_offset = 2;
 
 using namespace Minuet;
 
 
 class DriverBuilder {
 private:
+    std::string m_heap_snapshot_path;
+    Runtime::HeapConfig m_heap_config;
+    int m_opt_level;
     bool m_ir_printer_on;
     bool m_bc_printer_on;
 
 public:
     DriverBuilder() noexcept
-    : m_ir_printer_on {false}, m_bc_printer_on {false} {}
+    : m_heap_snapshot_path {}, m_heap_config {Runtime::HeapStorage::default_config()}, m_opt_level {Driver::Driver::max_opt_level}, m_ir_printer_on {false}, m_bc_printer_on {false} {}
 
     [[nodiscard]] auto config_ir_dumper(bool enabled_flag) noexcept -> DriverBuilder* {
         m_ir_printer_on = enabled_flag;
@@ -40,6 +48,30 @@ public:
         return this;
     }
 
+    [[nodiscard]] auto config_heap_size(std::size_t gc_threshold) noexcept -> DriverBuilder* {
+        m_heap_config.gc_threshold = gc_threshold;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_heap_growth(double growth_factor) noexcept -> DriverBuilder* {
+        m_heap_config.growth_factor = growth_factor;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_heap_snapshot(std::string_view snapshot_path) -> DriverBuilder* {
+        m_heap_snapshot_path = snapshot_path;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_opt_level(int opt_level) noexcept -> DriverBuilder* {
+        m_opt_level = opt_level;
+
+        return this;
+    }
+
     [[nodiscard]] auto build() noexcept -> Driver::Driver {
         Driver::Driver interpreter_driver;
 
@@ -50,21 +82,118 @@ public:
 
         interpreter_driver.add_ir_dumper(ir_printer);
         interpreter_driver.add_disassembler(bc_printer);
+        interpreter_driver.set_heap_config(m_heap_config);
+        interpreter_driver.set_heap_snapshot_path(m_heap_snapshot_path);
+        interpreter_driver.set_opt_level(m_opt_level);
 
         return interpreter_driver;
     }
 };
 
+void print_usage() {
+    std::println("minuetm v{}.{}.{}\n\nUsage: ./minuetm [info | compile-only [options...] <main-file> | run [options...] <main-file> [args...]]\n\tinfo []: shows usage info and version.\n\nOptions:\n\t--heap-size=<bytes>: heap usage which triggers the first GC.\n\t--heap-growth=<factor>: multiplier of live bytes after a GC for the next GC threshold.\n\t--heap-snapshot=<file>: appends JSON heap snapshots from exit and from dump_heap() calls to a file.\n\t--opt-level=<0-2>: 0 skips IR optimizations, 1 optimizes each function alone, 2 (default) also inlines small functions.", minuet_version_major, minuet_version_minor, minuet_version_patch);
+}
+
 /**
- * @brief Stringifies the native main function's `argv` strings from argument 3 and after, stopping at the terminating `nullptr`. The resulting `std::vector<std::string>` will then be injected into the interpreter via builder.
+ * @brief Applies one `--name=value` interpreter option to the builder.
+ *
+ * @param option_text The whole option argument.
+ * @param builder
+ * @return true if the option is known and its value is valid.
+ */
+[[nodiscard]] auto apply_option(std::string_view option_text, DriverBuilder& builder) -> bool {
+    const auto value_delim_pos = option_text.find('=');
+
+    if (value_delim_pos == std::string_view::npos) {
+        return false;
+    }
+
+    const auto option_name = option_text.substr(0, value_delim_pos);
+    const auto option_value = option_text.substr(value_delim_pos + 1);
+    const auto value_end = option_value.data() + option_value.size();
+
+    if (option_name == "--heap-size") {
+        std::size_t heap_size = 0;
+
+        if (auto [parse_end, parse_err] = std::from_chars(option_value.data(), value_end, heap_size); parse_err != std::errc {} || parse_end != value_end) {
+            return false;
+        }
+
+        [[maybe_unused]] auto builder_p = builder.config_heap_size(heap_size);
+
+        return true;
+    } else if (option_name == "--heap-growth") {
+        double growth_factor = 0.0;
+
+        if (auto [parse_end, parse_err] = std::from_chars(option_value.data(), value_end, growth_factor); parse_err != std::errc {} || parse_end != value_end || growth_factor < 1.0) {
+            return false;
+        }
+
+        [[maybe_unused]] auto builder_p = builder.config_heap_growth(growth_factor);
+
+        return true;
+    } else if (option_name == "--heap-snapshot") {
+        if (option_value.empty()) {
+            return false;
+        }
+
+        [[maybe_unused]] auto builder_p = builder.config_heap_snapshot(option_value);
+
+        return true;
+    } else if (option_name == "--opt-level") {
+        auto opt_level = 0;
+
+        if (auto [parse_end, parse_err] = std::from_chars(option_value.data(), value_end, opt_level); parse_err != std::errc {} || parse_end != value_end || opt_level < 0 || opt_level > Driver::Driver::max_opt_level) {
+            return false;
+        }
+
+        [[maybe_unused]] auto builder_p = builder.config_opt_level(opt_level);
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Applies leading `--` options after the command to the builder, stopping at the first other argument which must be the main file.
+ *
+ * @param argv
+ * @param full_argc
+ * @param builder
+ * @return std::optional<int> The position of the main file argument, or nothing if an option was invalid.
+ */
+[[nodiscard]] auto consume_options(char* argv[], int full_argc, DriverBuilder& builder) -> std::optional<int> {
+    auto arg_pos = minuet_run_argv_offset;
+
+    for (; arg_pos < full_argc; ++arg_pos) {
+        std::string_view arg_text {argv[arg_pos]};
+
+        if (!arg_text.starts_with("--")) {
+            break;
+        }
+
+        if (!apply_option(arg_text, builder)) {
+            std::println(std::cerr, "Invalid option '{}', try 'minuetm info' for help.", arg_text);
+
+            return {};
+        }
+    }
+
+    return arg_pos;
+}
+
+/**
+ * @brief Stringifies the native main function's `argv` strings after the main file, stopping at the terminating `nullptr`. The resulting `std::vector<std::string>` will then be injected into the interpreter via builder.
  * 
- * @param argv Pointer to `argv[3]` for `int main()`.
+ * @param argv Pointer to `argv` for `int main()`.
+ * @param first_arg_pos Position of the first program argument.
  * @return std::vector<std::string> 
  */
-[[nodiscard]] auto consume_running_args(char* argv[], int full_argc) -> std::vector<std::string> {
+[[nodiscard]] auto consume_running_args(char* argv[], int first_arg_pos, int full_argc) -> std::vector<std::string> {
     std::vector<std::string> program_args;
 
-    for (auto arg_pos = minuet_run_argv_offset; arg_pos < full_argc; ++arg_pos) {
+    for (auto arg_pos = first_arg_pos; arg_pos < full_argc; ++arg_pos) {
         program_args.emplace_back(argv[arg_pos]);
     }
 
@@ -78,22 +207,28 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    std::string arg_1 {argv[1]};
-    std::string arg_2 { (argc >= 3) ? argv[2] : ""};
-
     DriverBuilder driver_builder;
     Driver::Driver app;
 
+    std::string arg_1 {argv[1]};
+    const auto main_file_pos = consume_options(argv, argc, driver_builder);
+
+    if (!main_file_pos) {
+        return 1;
+    }
+
+    std::string main_file {(main_file_pos.value() < argc) ? argv[main_file_pos.value()] : ""};
+
     if (arg_1 == "info") {
-        std::println("minuetm v{}.{}.{}\n\nUsage: ./minuetm [info | compile-only <main-file> | run <main-file>]\n\tinfo []: shows usage info and version.", minuet_version_major, minuet_version_minor, minuet_version_patch);
+        print_usage();
 
         return 0;
-    } else if (arg_1 == "compile-only" && !arg_2.empty()) {
+    } else if (arg_1 == "compile-only" && !main_file.empty()) {
         app = driver_builder.config_ir_dumper(true)->config_bc_dumper(true)->build();
-    } else if (arg_1 == "run" && !arg_2.empty()) {
+    } else if (arg_1 == "run" && !main_file.empty()) {
         app = driver_builder.config_ir_dumper(false)->config_bc_dumper(false)->build();
     } else {
-        std::println("minuetm v{}.{}.{}\n\nUsage: ./minuetm [info | compile-only <main-file> | run <main-file>]\n\tinfo []: shows usage info and version.", minuet_version_major, minuet_version_minor, minuet_version_patch);
+        print_usage();
 
         return 1;
     }
@@ -110,16 +245,39 @@ int main(int argc, char* argv[]) {
     app.register_native_proc({"list_pop_back", Intrinsics::native_list_pop_back});
     app.register_native_proc({"list_pop_front", Intrinsics::native_list_pop_front});
     app.register_native_proc({"list_concat", Intrinsics::native_list_concat});
+    app.register_native_proc({"list_sort", Intrinsics::native_list_sort});
+    app.register_native_proc({"list_sort_desc", Intrinsics::native_list_sort_desc});
+
+    // stdlib arrays
+    app.register_native_proc({"int_array", Intrinsics::native_int_array});
+    app.register_native_proc({"float_array", Intrinsics::native_float_array});
+    app.register_native_proc({"arr_sum", Intrinsics::native_arr_sum});
+    app.register_native_proc({"arr_min", Intrinsics::native_arr_min});
+    app.register_native_proc({"arr_max", Intrinsics::native_arr_max});
+    app.register_native_proc({"arr_dot", Intrinsics::native_arr_dot});
+    app.register_native_proc({"arr_scale", Intrinsics::native_arr_scale});
+    app.register_native_proc({"arr_add", Intrinsics::native_arr_add});
+
+    // stdlib dicts
+    app.register_native_proc({"dict_has", Intrinsics::native_dict_has});
+    app.register_native_proc({"dict_del", Intrinsics::native_dict_del});
+    app.register_native_proc({"dict_keys", Intrinsics::native_dict_keys});
 
     // stdlib strings
     app.register_native_proc({"strlen", Intrinsics::native_strlen});
     app.register_native_proc({"strcat", Intrinsics::native_strcat});
     app.register_native_proc({"substr", Intrinsics::native_substr});
+    app.register_native_proc({"str_find", Intrinsics::native_str_find});
+    app.register_native_proc({"str_count", Intrinsics::native_str_count});
+    app.register_native_proc({"str_split", Intrinsics::native_str_split});
+    app.register_native_proc({"str_replace", Intrinsics::native_str_replace});
+    app.register_native_proc({"intern", Intrinsics::native_intern});
 
     // stdlib utils
     app.register_native_proc({"stoi", Intrinsics::native_stoi});
     app.register_native_proc({"stof", Intrinsics::native_stof});
     app.register_native_proc({"get_argv", Intrinsics::native_get_argv});
+    app.register_native_proc({"dump_heap", Intrinsics::native_dump_heap});
 
-    return app(arg_2, consume_running_args(argv, argc)) ? 0 : 1 ;
+    return app(main_file, consume_running_args(argv, main_file_pos.value() + 1, argc)) ? 0 : 1 ;
 }
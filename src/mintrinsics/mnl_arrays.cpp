@@ -0,0 +1,490 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define MINUET_HAS_X86_SIMD 1
+#endif
+
+#include "mintrinsics/mnl_arrays.hpp"
+#include "runtime/packed_array_value.hpp"
+
+namespace Minuet::Intrinsics {
+    /// NOTE: Integer kernels wrap around on overflow like 2's complement hardware, which keeps the scalar and AVX2 results the same. Float sums and dot products may round differently between the two since AVX2 adds 4 lanes at a time.
+    [[nodiscard]] static auto wrap_add(int32_t lhs, int32_t rhs) noexcept -> int32_t {
+        return static_cast<int32_t>(static_cast<uint32_t>(lhs) + static_cast<uint32_t>(rhs));
+    }
+
+    [[nodiscard]] static auto wrap_mul(int32_t lhs, int32_t rhs) noexcept -> int32_t {
+        return static_cast<int32_t>(static_cast<uint32_t>(lhs) * static_cast<uint32_t>(rhs));
+    }
+
+    [[nodiscard]] static auto sum_scalar(std::span<const int32_t> elems, int32_t acc) noexcept -> int32_t {
+        for (const auto elem : elems) {
+            acc = wrap_add(acc, elem);
+        }
+
+        return acc;
+    }
+
+    [[nodiscard]] static auto sum_scalar(std::span<const double> elems, double acc) noexcept -> double {
+        for (const auto elem : elems) {
+            acc += elem;
+        }
+
+        return acc;
+    }
+
+    [[nodiscard]] static auto dot_scalar(std::span<const int32_t> lhs, std::span<const int32_t> rhs, int32_t acc) noexcept -> int32_t {
+        for (std::size_t pos = 0; pos < lhs.size(); ++pos) {
+            acc = wrap_add(acc, wrap_mul(lhs[pos], rhs[pos]));
+        }
+
+        return acc;
+    }
+
+    [[nodiscard]] static auto dot_scalar(std::span<const double> lhs, std::span<const double> rhs, double acc) noexcept -> double {
+        for (std::size_t pos = 0; pos < lhs.size(); ++pos) {
+            acc += lhs[pos] * rhs[pos];
+        }
+
+        return acc;
+    }
+
+    template <typename Elem>
+    [[nodiscard]] static auto min_scalar(std::span<const Elem> elems, Elem acc) noexcept -> Elem {
+        for (const auto elem : elems) {
+            acc = std::min(acc, elem);
+        }
+
+        return acc;
+    }
+
+    template <typename Elem>
+    [[nodiscard]] static auto max_scalar(std::span<const Elem> elems, Elem acc) noexcept -> Elem {
+        for (const auto elem : elems) {
+            acc = std::max(acc, elem);
+        }
+
+        return acc;
+    }
+
+    static void scale_scalar(std::span<int32_t> elems, int32_t factor) noexcept {
+        for (auto& elem : elems) {
+            elem = wrap_mul(elem, factor);
+        }
+    }
+
+    static void scale_scalar(std::span<double> elems, double factor) noexcept {
+        for (auto& elem : elems) {
+            elem *= factor;
+        }
+    }
+
+    static void add_scalar(std::span<int32_t> dest, std::span<const int32_t> src) noexcept {
+        for (std::size_t pos = 0; pos < dest.size(); ++pos) {
+            dest[pos] = wrap_add(dest[pos], src[pos]);
+        }
+    }
+
+    static void add_scalar(std::span<double> dest, std::span<const double> src) noexcept {
+        for (std::size_t pos = 0; pos < dest.size(); ++pos) {
+            dest[pos] += src[pos];
+        }
+    }
+
+#ifdef MINUET_HAS_X86_SIMD
+    /// NOTE: Each AVX2 kernel handles whole 256-bit blocks, leaving the remaining tail elements to its scalar counterpart.
+    static constexpr std::size_t i32_lanes = 8;
+    static constexpr std::size_t f64_lanes = 4;
+
+    __attribute__((target("avx2")))
+    [[nodiscard]] static auto sum_avx2(std::span<const int32_t> elems) noexcept -> int32_t {
+        auto acc = _mm256_setzero_si256();
+        std::size_t pos = 0;
+
+        for (; pos + i32_lanes <= elems.size(); pos += i32_lanes) {
+            acc = _mm256_add_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(elems.data() + pos)));
+        }
+
+        std::array<int32_t, i32_lanes> lanes;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.data()), acc);
+
+        return sum_scalar(elems.subspan(pos), sum_scalar(lanes, 0));
+    }
+
+    __attribute__((target("avx2")))
+    [[nodiscard]] static auto sum_avx2(std::span<const double> elems) noexcept -> double {
+        auto acc = _mm256_setzero_pd();
+        std::size_t pos = 0;
+
+        for (; pos + f64_lanes <= elems.size(); pos += f64_lanes) {
+            acc = _mm256_add_pd(acc, _mm256_loadu_pd(elems.data() + pos));
+        }
+
+        std::array<double, f64_lanes> lanes;
+        _mm256_storeu_pd(lanes.data(), acc);
+
+        return sum_scalar(elems.subspan(pos), sum_scalar(lanes, 0.0));
+    }
+
+    __attribute__((target("avx2")))
+    [[nodiscard]] static auto dot_avx2(std::span<const int32_t> lhs, std::span<const int32_t> rhs) noexcept -> int32_t {
+        auto acc = _mm256_setzero_si256();
+        std::size_t pos = 0;
+
+        for (; pos + i32_lanes <= lhs.size(); pos += i32_lanes) {
+            acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs.data() + pos)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs.data() + pos))
+            ));
+        }
+
+        std::array<int32_t, i32_lanes> lanes;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.data()), acc);
+
+        return dot_scalar(lhs.subspan(pos), rhs.subspan(pos), sum_scalar(lanes, 0));
+    }
+
+    __attribute__((target("avx2")))
+    [[nodiscard]] static auto dot_avx2(std::span<const double> lhs, std::span<const double> rhs) noexcept -> double {
+        auto acc = _mm256_setzero_pd();
+        std::size_t pos = 0;
+
+        for (; pos + f64_lanes <= lhs.size(); pos += f64_lanes) {
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(lhs.data() + pos), _mm256_loadu_pd(rhs.data() + pos)));
+        }
+
+        std::array<double, f64_lanes> lanes;
+        _mm256_storeu_pd(lanes.data(), acc);
+
+        return dot_scalar(lhs.subspan(pos), rhs.subspan(pos), sum_scalar(lanes, 0.0));
+    }
+
+    /// NOTE: The min & max kernels start every lane from the first element, so empty arrays must be rejected beforehand.
+    __attribute__((target("avx2")))
+    [[nodiscard]] static auto min_avx2(std::span<const int32_t> elems) noexcept -> int32_t {
+        auto acc = _mm256_set1_epi32(elems[0]);
+        std::size_t pos = 0;
+
+        for (; pos + i32_lanes <= elems.size(); pos += i32_lanes) {
+            acc = _mm256_min_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(elems.data() + pos)));
+        }
+
+        std::array<int32_t, i32_lanes> lanes;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.data()), acc);
+
+        return min_scalar(elems.subspan(pos), min_scalar<int32_t>(lanes, elems[0]));
+    }
+
+    __attribute__((target("avx2")))
+    [[nodiscard]] static auto min_avx2(std::span<const double> elems) noexcept -> double {
+        auto acc = _mm256_set1_pd(elems[0]);
+        std::size_t pos = 0;
+
+        for (; pos + f64_lanes <= elems.size(); pos += f64_lanes) {
+            acc = _mm256_min_pd(acc, _mm256_loadu_pd(elems.data() + pos));
+        }
+
+        std::array<double, f64_lanes> lanes;
+        _mm256_storeu_pd(lanes.data(), acc);
+
+        return min_scalar(elems.subspan(pos), min_scalar<double>(lanes, elems[0]));
+    }
+
+    __attribute__((target("avx2")))
+    [[nodiscard]] static auto max_avx2(std::span<const int32_t> elems) noexcept -> int32_t {
+        auto acc = _mm256_set1_epi32(elems[0]);
+        std::size_t pos = 0;
+
+        for (; pos + i32_lanes <= elems.size(); pos += i32_lanes) {
+            acc = _mm256_max_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(elems.data() + pos)));
+        }
+
+        std::array<int32_t, i32_lanes> lanes;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.data()), acc);
+
+        return max_scalar(elems.subspan(pos), max_scalar<int32_t>(lanes, elems[0]));
+    }
+
+    __attribute__((target("avx2")))
+    [[nodiscard]] static auto max_avx2(std::span<const double> elems) noexcept -> double {
+        auto acc = _mm256_set1_pd(elems[0]);
+        std::size_t pos = 0;
+
+        for (; pos + f64_lanes <= elems.size(); pos += f64_lanes) {
+            acc = _mm256_max_pd(acc, _mm256_loadu_pd(elems.data() + pos));
+        }
+
+        std::array<double, f64_lanes> lanes;
+        _mm256_storeu_pd(lanes.data(), acc);
+
+        return max_scalar(elems.subspan(pos), max_scalar<double>(lanes, elems[0]));
+    }
+
+    __attribute__((target("avx2")))
+    static void scale_avx2(std::span<int32_t> elems, int32_t factor) noexcept {
+        const auto factors = _mm256_set1_epi32(factor);
+        std::size_t pos = 0;
+
+        for (; pos + i32_lanes <= elems.size(); pos += i32_lanes) {
+            auto block_p = reinterpret_cast<__m256i*>(elems.data() + pos);
+            _mm256_storeu_si256(block_p, _mm256_mullo_epi32(_mm256_loadu_si256(block_p), factors));
+        }
+
+        scale_scalar(elems.subspan(pos), factor);
+    }
+
+    __attribute__((target("avx2")))
+    static void scale_avx2(std::span<double> elems, double factor) noexcept {
+        const auto factors = _mm256_set1_pd(factor);
+        std::size_t pos = 0;
+
+        for (; pos + f64_lanes <= elems.size(); pos += f64_lanes) {
+            _mm256_storeu_pd(elems.data() + pos, _mm256_mul_pd(_mm256_loadu_pd(elems.data() + pos), factors));
+        }
+
+        scale_scalar(elems.subspan(pos), factor);
+    }
+
+    __attribute__((target("avx2")))
+    static void add_avx2(std::span<int32_t> dest, std::span<const int32_t> src) noexcept {
+        std::size_t pos = 0;
+
+        for (; pos + i32_lanes <= dest.size(); pos += i32_lanes) {
+            auto block_p = reinterpret_cast<__m256i*>(dest.data() + pos);
+            _mm256_storeu_si256(block_p, _mm256_add_epi32(
+                _mm256_loadu_si256(block_p),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src.data() + pos))
+            ));
+        }
+
+        add_scalar(dest.subspan(pos), src.subspan(pos));
+    }
+
+    __attribute__((target("avx2")))
+    static void add_avx2(std::span<double> dest, std::span<const double> src) noexcept {
+        std::size_t pos = 0;
+
+        for (; pos + f64_lanes <= dest.size(); pos += f64_lanes) {
+            _mm256_storeu_pd(dest.data() + pos, _mm256_add_pd(_mm256_loadu_pd(dest.data() + pos), _mm256_loadu_pd(src.data() + pos)));
+        }
+
+        add_scalar(dest.subspan(pos), src.subspan(pos));
+    }
+#endif
+
+    [[nodiscard]] static auto has_avx2() noexcept -> bool {
+#ifdef MINUET_HAS_X86_SIMD
+        static const auto cpu_has_avx2 = __builtin_cpu_supports("avx2") != 0;
+
+        return cpu_has_avx2;
+#else
+        return false;
+#endif
+    }
+
+    /// NOTE: These pick the AVX2 kernel when the CPU supports it, or else the scalar one.
+    template <typename Elem>
+    [[nodiscard]] static auto sum_elems(std::span<const Elem> elems) noexcept -> Elem {
+#ifdef MINUET_HAS_X86_SIMD
+        if (has_avx2()) {
+            return sum_avx2(elems);
+        }
+#endif
+        return sum_scalar(elems, Elem {});
+    }
+
+    template <typename Elem>
+    [[nodiscard]] static auto dot_elems(std::span<const Elem> lhs, std::span<const Elem> rhs) noexcept -> Elem {
+#ifdef MINUET_HAS_X86_SIMD
+        if (has_avx2()) {
+            return dot_avx2(lhs, rhs);
+        }
+#endif
+        return dot_scalar(lhs, rhs, Elem {});
+    }
+
+    template <typename Elem>
+    [[nodiscard]] static auto min_elems(std::span<const Elem> elems) noexcept -> Elem {
+#ifdef MINUET_HAS_X86_SIMD
+        if (has_avx2()) {
+            return min_avx2(elems);
+        }
+#endif
+        return min_scalar(elems, elems[0]);
+    }
+
+    template <typename Elem>
+    [[nodiscard]] static auto max_elems(std::span<const Elem> elems) noexcept -> Elem {
+#ifdef MINUET_HAS_X86_SIMD
+        if (has_avx2()) {
+            return max_avx2(elems);
+        }
+#endif
+        return max_scalar(elems, elems[0]);
+    }
+
+    template <typename Elem>
+    static void scale_elems(std::span<Elem> elems, Elem factor) noexcept {
+#ifdef MINUET_HAS_X86_SIMD
+        if (has_avx2()) {
+            scale_avx2(elems, factor);
+            return;
+        }
+#endif
+        scale_scalar(elems, factor);
+    }
+
+    template <typename Elem>
+    static void add_elems(std::span<Elem> dest, std::span<const Elem> src) noexcept {
+#ifdef MINUET_HAS_X86_SIMD
+        if (has_avx2()) {
+            add_avx2(dest, src);
+            return;
+        }
+#endif
+        add_scalar(dest, src);
+    }
+
+    /// @brief Gives a native's argument as a packed array of `Elem`, or `nullptr` if it isn't one.
+    template <typename Elem>
+    [[nodiscard]] static auto access_array_arg(Runtime::VM::Engine& vm, int16_t argc, int16_t arg_pos) -> Runtime::PackedArrayValue<Elem>* {
+        auto arg_obj_p = vm.handle_native_fn_access(argc, arg_pos).to_object_ptr();
+
+        if (!arg_obj_p || arg_obj_p->get_tag() != Runtime::PackedArrayValue<Elem>::cm_object_tag) {
+            return nullptr;
+        }
+
+        return static_cast<Runtime::PackedArrayValue<Elem>*>(arg_obj_p);
+    }
+
+    template <typename Elem>
+    [[nodiscard]] static auto make_array_from(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        auto source_obj_p = vm.handle_native_fn_access(argc, 0).to_object_ptr();
+
+        if (!source_obj_p || source_obj_p->get_tag() != Runtime::ObjectTag::sequence) {
+            return false;
+        }
+
+        std::vector<Elem> elems;
+        elems.reserve(source_obj_p->items().size());
+
+        for (const auto& item : source_obj_p->items()) {
+            if (const auto elem_opt = Runtime::PackedArrayValue<Elem>::to_elem(item); elem_opt) {
+                elems.push_back(elem_opt.value());
+            } else {
+                return false;
+            }
+        }
+
+        if (auto result_obj_p = vm.handle_native_fn_access_heap().try_create_value<Runtime::PackedArrayValue<Elem>>(std::move(elems)).get(); result_obj_p) {
+            vm.handle_native_fn_return(result_obj_p->as_fast_value(), argc);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    template <typename Elem>
+    [[nodiscard]] static auto reduce_array(Runtime::VM::Engine& vm, int16_t argc, auto reducer) -> bool {
+        if (const auto array_p = access_array_arg<Elem>(vm, argc, 0); array_p) {
+            vm.handle_native_fn_return(Runtime::FastValue {reducer(std::span<const Elem> {array_p->elems()})}, argc);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    auto native_int_array(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        return make_array_from<int32_t>(vm, argc);
+    }
+
+    auto native_float_array(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        return make_array_from<double>(vm, argc);
+    }
+
+    auto native_arr_sum(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        return reduce_array<int32_t>(vm, argc, sum_elems<int32_t>)
+            || reduce_array<double>(vm, argc, sum_elems<double>);
+    }
+
+    auto native_arr_min(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        if (auto array_obj_p = vm.handle_native_fn_access(argc, 0).to_object_ptr(); !array_obj_p || array_obj_p->get_size() == 0) {
+            return false;
+        }
+
+        return reduce_array<int32_t>(vm, argc, min_elems<int32_t>)
+            || reduce_array<double>(vm, argc, min_elems<double>);
+    }
+
+    auto native_arr_max(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        if (auto array_obj_p = vm.handle_native_fn_access(argc, 0).to_object_ptr(); !array_obj_p || array_obj_p->get_size() == 0) {
+            return false;
+        }
+
+        return reduce_array<int32_t>(vm, argc, max_elems<int32_t>)
+            || reduce_array<double>(vm, argc, max_elems<double>);
+    }
+
+    template <typename Elem>
+    [[nodiscard]] static auto dot_arrays(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto lhs_p = access_array_arg<Elem>(vm, argc, 0);
+        const auto rhs_p = access_array_arg<Elem>(vm, argc, 1);
+
+        if (!lhs_p || !rhs_p || lhs_p->get_size() != rhs_p->get_size()) {
+            return false;
+        }
+
+        vm.handle_native_fn_return(Runtime::FastValue {dot_elems<Elem>(lhs_p->elems(), rhs_p->elems())}, argc);
+
+        return true;
+    }
+
+    auto native_arr_dot(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        return dot_arrays<int32_t>(vm, argc) || dot_arrays<double>(vm, argc);
+    }
+
+    template <typename Elem>
+    [[nodiscard]] static auto scale_array(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto target_p = access_array_arg<Elem>(vm, argc, 0);
+        const auto factor_opt = Runtime::PackedArrayValue<Elem>::to_elem(vm.handle_native_fn_access(argc, 1));
+
+        if (!target_p || !factor_opt || target_p->is_frozen()) {
+            return false;
+        }
+
+        scale_elems<Elem>(target_p->elems(), factor_opt.value());
+        vm.handle_native_fn_return(target_p->as_fast_value(), argc);
+
+        return true;
+    }
+
+    auto native_arr_scale(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        return scale_array<int32_t>(vm, argc) || scale_array<double>(vm, argc);
+    }
+
+    template <typename Elem>
+    [[nodiscard]] static auto add_arrays(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto target_p = access_array_arg<Elem>(vm, argc, 0);
+        const auto source_p = access_array_arg<Elem>(vm, argc, 1);
+
+        if (!target_p || !source_p || target_p->is_frozen() || target_p->get_size() != source_p->get_size()) {
+            return false;
+        }
+
+        add_elems<Elem>(target_p->elems(), std::span<const Elem> {source_p->elems()});
+        vm.handle_native_fn_return(target_p->as_fast_value(), argc);
+
+        return true;
+    }
+
+    auto native_arr_add(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        return add_arrays<int32_t>(vm, argc) || add_arrays<double>(vm, argc);
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef MINUET_MINTRINSICS_ARRAYS_HPP
+#define MINUET_MINTRINSICS_ARRAYS_HPP
+
+#include "runtime/vm.hpp"
+
+namespace Minuet::Intrinsics {
+    /// @brief Makes a packed `int_array` from a list of integers.
+    [[nodiscard]] auto native_int_array(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Makes a packed `float_array` from a list of numbers, widening any integers.
+    [[nodiscard]] auto native_float_array(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Sums a packed array's elements. Integer sums wrap around on overflow.
+    [[nodiscard]] auto native_arr_sum(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Gets the least element of a non-empty packed array.
+    [[nodiscard]] auto native_arr_min(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Gets the greatest element of a non-empty packed array.
+    [[nodiscard]] auto native_arr_max(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Gets the dot product of two packed arrays with the same type and length.
+    [[nodiscard]] auto native_arr_dot(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Multiplies each element of a packed array by a number in place, then gives the array.
+    [[nodiscard]] auto native_arr_scale(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Adds a packed array's elements onto a referenced array with the same type and length, then gives the referenced array.
+    [[nodiscard]] auto native_arr_add(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+}
+
+#endif
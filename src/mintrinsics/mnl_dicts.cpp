@@ -0,0 +1,78 @@
+#include <utility>
+
+#include "mintrinsics/mnl_dicts.hpp"
+#include "runtime/dict_value.hpp"
+#include "runtime/sequence_value.hpp"
+
+namespace Minuet::Intrinsics {
+    [[nodiscard]] static auto access_dict_arg(Runtime::VM::Engine& vm, int16_t argc, int16_t pos) noexcept -> Runtime::DictValue* {
+        auto arg_obj_p = vm.handle_native_fn_access(argc, pos).to_object_ptr();
+
+        if (!arg_obj_p || arg_obj_p->get_tag() != Runtime::ObjectTag::dict) {
+            return nullptr;
+        }
+
+        return static_cast<Runtime::DictValue*>(arg_obj_p);
+    }
+
+    auto native_dict_has(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto dict_p = access_dict_arg(vm, argc, 0);
+
+        if (!dict_p) {
+            return false;
+        }
+
+        const auto has_key = dict_p->find(vm.handle_native_fn_access(argc, 1).deref()) != nullptr;
+
+        vm.handle_native_fn_return(Runtime::FastValue {has_key}, argc);
+
+        return true;
+    }
+
+    auto native_dict_del(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto dict_p = access_dict_arg(vm, argc, 0);
+
+        if (!dict_p || dict_p->is_frozen()) {
+            return false;
+        }
+
+        const auto had_key = dict_p->erase(vm.handle_native_fn_access(argc, 1).deref());
+
+        vm.handle_native_fn_return(Runtime::FastValue {had_key}, argc);
+
+        return true;
+    }
+
+    auto native_dict_keys(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto dict_p = access_dict_arg(vm, argc, 0);
+
+        if (!dict_p) {
+            return false;
+        }
+
+        auto& heap = vm.handle_native_fn_access_heap();
+        auto keys_obj_p = heap.try_create_value<Runtime::SequenceValue>().get();
+
+        if (!keys_obj_p) {
+            return false;
+        }
+
+        const auto old_score = keys_obj_p->get_memory_score();
+
+        for (auto& key : dict_p->keys()) {
+            [[maybe_unused]] const auto pushed = keys_obj_p->push_value(std::move(key));
+        }
+
+        heap.track_resize(old_score, keys_obj_p->get_memory_score());
+
+        vm.handle_native_fn_return(
+            Runtime::FastValue {
+                keys_obj_p,
+                Runtime::FVTag::sequence,
+            },
+            argc
+        );
+
+        return true;
+    }
+}
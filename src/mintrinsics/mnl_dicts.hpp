@@ -0,0 +1,17 @@
+#ifndef MINUET_MINTRINSICS_DICTS_HPP
+#define MINUET_MINTRINSICS_DICTS_HPP
+
+#include "runtime/vm.hpp"
+
+namespace Minuet::Intrinsics {
+    /// @brief Checks if a dict has a key, without adding it like an access would.
+    [[nodiscard]] auto native_dict_has(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Removes a key and its value from a dict, giving whether the key was there.
+    [[nodiscard]] auto native_dict_del(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Makes a list of a dict's keys in insertion order.
+    [[nodiscard]] auto native_dict_keys(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+}
+
+#endif
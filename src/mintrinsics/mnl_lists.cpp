@@ -1,7 +1,21 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <span>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
 #include "mintrinsics/mnl_lists.hpp"
+#include "runtime/string_value.hpp"
 
 namespace Minuet::Intrinsics {
+    /// NOTE: Packed arrays support the same pushes & pops as lists, but only for elements of their number type.
+    [[nodiscard]] static auto is_list_like(Runtime::ObjectTag tag) noexcept -> bool {
+        return tag == Runtime::ObjectTag::sequence || tag == Runtime::ObjectTag::int_array || tag == Runtime::ObjectTag::float_array;
+    }
+
     auto native_len_of(Runtime::VM::Engine& vm, int16_t argc) -> bool {
         auto arg_0 = vm.handle_native_fn_access(argc, 0);
         
@@ -22,8 +36,11 @@ namespace Minuet::Intrinsics {
         }
 
         if (auto obj_ptr = target_arg.to_object_ptr(); obj_ptr) {
-            if (obj_ptr->get_tag() == Runtime::ObjectTag::sequence && !obj_ptr->is_frozen()) {
+            if (is_list_like(obj_ptr->get_tag()) && !obj_ptr->is_frozen()) {
+                const auto old_score = obj_ptr->get_memory_score();
+
                 if (obj_ptr->push_value(std::move(new_item_arg))) {
+                    vm.handle_native_fn_access_heap().track_resize(old_score, obj_ptr->get_memory_score());
                     vm.handle_native_fn_return(std::move(target_arg), argc);
 
                     return true;
@@ -42,8 +59,11 @@ namespace Minuet::Intrinsics {
         }
 
         if (auto obj_ptr = target_arg.to_object_ptr(); obj_ptr) {
-            if (obj_ptr->get_tag() == Runtime::ObjectTag::sequence && !obj_ptr->is_frozen()) {
+            if (is_list_like(obj_ptr->get_tag()) && !obj_ptr->is_frozen()) {
+                const auto old_score = obj_ptr->get_memory_score();
+
                 if (auto old_back = obj_ptr->pop_value(Runtime::SequenceOpPolicy::back); !old_back.is_none()) {
+                    vm.handle_native_fn_access_heap().track_resize(old_score, obj_ptr->get_memory_score());
                     vm.handle_native_fn_return(std::move(old_back), argc);
 
                     return true;
@@ -62,8 +82,11 @@ namespace Minuet::Intrinsics {
         }
 
         if (auto obj_ptr = target_arg.to_object_ptr(); obj_ptr) {
-            if (obj_ptr->get_tag() == Runtime::ObjectTag::sequence && !obj_ptr->is_frozen()) {
+            if (is_list_like(obj_ptr->get_tag()) && !obj_ptr->is_frozen()) {
+                const auto old_score = obj_ptr->get_memory_score();
+
                 if (auto old_front = obj_ptr->pop_value(Runtime::SequenceOpPolicy::front); !old_front.is_none()) {
+                    vm.handle_native_fn_access_heap().track_resize(old_score, obj_ptr->get_memory_score());
                     vm.handle_native_fn_return(std::move(old_front), argc);
 
                     return true;
@@ -86,12 +109,173 @@ namespace Minuet::Intrinsics {
             return false;
         }
 
-        for (const auto& source_items = source_arg_p->items(); const auto& item : source_items) {
-            if (!target_arg_p->push_value(item)) {
-                return false;
+        const auto old_score = target_arg_p->get_memory_score();
+        auto all_pushed = true;
+
+        /// NOTE: A string source has no FastValue items, so its characters are pushed as `chr8` values.
+        if (source_arg_p->get_tag() == Runtime::ObjectTag::string) {
+            for (const auto c : static_cast<const Runtime::StringValue*>(source_arg_p)->view()) {
+                if (!target_arg_p->push_value(Runtime::FastValue {c})) {
+                    all_pushed = false;
+                    break;
+                }
+            }
+        } else {
+            /// NOTE: The source's items are re-viewed per push since concatenating a list onto itself may reallocate them.
+            for (std::size_t item_pos = 0, source_len = source_arg_p->items().size(); item_pos < source_len; ++item_pos) {
+                if (!target_arg_p->push_value(source_arg_p->items()[item_pos])) {
+                    all_pushed = false;
+                    break;
+                }
+            }
+        }
+
+        vm.handle_native_fn_access_heap().track_resize(old_score, target_arg_p->get_memory_score());
+
+        return all_pushed;
+    }
+
+    /// NOTE: lists at least this long are sorted in chunks across threads, which are then merged pairwise
+    static constexpr std::size_t parallel_sort_threshold = 65536;
+    static constexpr std::size_t max_sort_threads = 8;
+
+    template <typename Elem, typename Compare>
+    static void sort_elems(std::span<Elem> elems, Compare cmp) {
+        const auto chunk_count = std::min<std::size_t>(std::thread::hardware_concurrency(), max_sort_threads);
+
+        if (elems.size() < parallel_sort_threshold || chunk_count < 2) {
+            std::sort(elems.begin(), elems.end(), cmp);
+            return;
+        }
+
+        std::vector<std::size_t> chunk_bounds;
+
+        for (std::size_t chunk_id = 0; chunk_id <= chunk_count; ++chunk_id) {
+            chunk_bounds.push_back(elems.size() * chunk_id / chunk_count);
+        }
+
+        const auto elems_begin = elems.begin();
+
+        {
+            std::vector<std::jthread> sorters;
+
+            for (std::size_t chunk_id = 0; chunk_id < chunk_count; ++chunk_id) {
+                sorters.emplace_back([&, chunk_id] {
+                    std::sort(elems_begin + chunk_bounds[chunk_id], elems_begin + chunk_bounds[chunk_id + 1], cmp);
+                });
+            }
+        }
+
+        /// NOTE: Each round merges neighboring runs twice as wide as before, with the merges of one round running in parallel.
+        for (std::size_t run_width = 1; run_width < chunk_count; run_width *= 2) {
+            std::vector<std::jthread> mergers;
+
+            for (std::size_t chunk_id = 0; chunk_id + run_width < chunk_count; chunk_id += run_width * 2) {
+                const auto run_end_id = std::min(chunk_id + run_width * 2, chunk_count);
+
+                mergers.emplace_back([&, chunk_id, run_width, run_end_id] {
+                    std::inplace_merge(elems_begin + chunk_bounds[chunk_id], elems_begin + chunk_bounds[chunk_id + run_width], elems_begin + chunk_bounds[run_end_id], cmp);
+                });
+            }
+        }
+    }
+
+    /// @brief Sorts the values of scalar items as plain keys, then writes them back with their original tag.
+    template <typename Key, bool Descending>
+    static void sort_by_keys(std::span<Runtime::FastValue> items, auto to_key, auto from_key) {
+        std::vector<Key> keys;
+        keys.reserve(items.size());
+
+        for (const auto& item : items) {
+            keys.push_back(to_key(item));
+        }
+
+        if constexpr (std::is_floating_point_v<Key>) {
+            /// NOTE: NaNs are ordered after all numbers so that the comparison stays a strict weak order.
+            auto key_less = [](Key lhs, Key rhs) noexcept {
+                return (std::isnan(rhs)) ? !std::isnan(lhs) : lhs < rhs;
+            };
+
+            if constexpr (Descending) {
+                sort_elems(std::span {keys}, [&key_less](Key lhs, Key rhs) noexcept { return key_less(rhs, lhs); });
+            } else {
+                sort_elems(std::span {keys}, key_less);
+            }
+        } else if constexpr (Descending) {
+            sort_elems(std::span {keys}, std::greater<Key> {});
+        } else {
+            sort_elems(std::span {keys}, std::less<Key> {});
+        }
+
+        for (std::size_t item_pos = 0; item_pos < items.size(); ++item_pos) {
+            items[item_pos] = from_key(keys[item_pos]);
+        }
+    }
+
+    template <bool Descending>
+    [[nodiscard]] static auto sort_list(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        auto target_arg = vm.handle_native_fn_access(argc, 0);
+        auto target_obj_p = target_arg.to_object_ptr();
+
+        if (!target_obj_p || target_obj_p->get_tag() != Runtime::ObjectTag::sequence || target_obj_p->is_frozen()) {
+            return false;
+        }
+
+        auto items = target_obj_p->items();
+
+        /// NOTE: Only lists of one item type have a total order, which then picks a comparator on unboxed keys.
+        const auto item_tag = (items.empty()) ? Runtime::FVTag::dud : items.front().tag();
+
+        if (!std::ranges::all_of(items, [item_tag](const Runtime::FastValue& item) noexcept { return item.tag() == item_tag; })) {
+            return false;
+        }
+
+        auto to_int_key = [](const Runtime::FastValue& item) noexcept { return item.to_scalar().value_or(0); };
+
+        switch (item_tag) {
+        case Runtime::FVTag::dud:
+            break;
+        case Runtime::FVTag::boolean:
+            sort_by_keys<int, Descending>(items, to_int_key, [](int key) noexcept { return Runtime::FastValue {key != 0}; });
+            break;
+        case Runtime::FVTag::chr8:
+            sort_by_keys<int, Descending>(items, to_int_key, [](int key) noexcept { return Runtime::FastValue {static_cast<char>(key)}; });
+            break;
+        case Runtime::FVTag::int32:
+            sort_by_keys<int, Descending>(items, to_int_key, [](int key) noexcept { return Runtime::FastValue {key}; });
+            break;
+        case Runtime::FVTag::flt64:
+            sort_by_keys<double, Descending>(
+                items,
+                [](const Runtime::FastValue& item) noexcept { return item.to_real().value_or(0.0); },
+                [](double key) noexcept { return Runtime::FastValue {key}; }
+            );
+            break;
+        case Runtime::FVTag::string:
+            {
+                auto view_of = [](const Runtime::FastValue& item) noexcept {
+                    return static_cast<const Runtime::StringValue*>(Runtime::FastValue {item}.to_object_ptr())->view();
+                };
+
+                sort_elems(items, [&view_of](const Runtime::FastValue& lhs, const Runtime::FastValue& rhs) noexcept {
+                    return (Descending) ? view_of(rhs) < view_of(lhs) : view_of(lhs) < view_of(rhs);
+                });
             }
+            break;
+        default:
+            return false;
         }
 
+        vm.handle_native_fn_return(std::move(target_arg), argc);
+
         return true;
     }
+
+    auto native_list_sort(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        return sort_list<false>(vm, argc);
+    }
+
+    auto native_list_sort_desc(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        return sort_list<true>(vm, argc);
+    }
 }
@@ -18,6 +18,12 @@ namespace Minuet::Intrinsics {
 
     /// @brief Joins a list's items in sequence to a referenced list. If the target sequence is frozen, this will fail.
     [[nodiscard]] auto native_list_concat(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Sorts a referenced list in ascending order, then gives it. The items must all be of one type: booleans, characters, integers, floats or strings.
+    [[nodiscard]] auto native_list_sort(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Sorts a referenced list in descending order, with the same requirements as `list_sort`.
+    [[nodiscard]] auto native_list_sort_desc(Runtime::VM::Engine& vm, int16_t argc) -> bool;
 }
 
 #endif
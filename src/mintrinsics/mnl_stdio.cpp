@@ -1,5 +1,7 @@
+#include <cstdio>
 #include <iostream>
 #include <print>
+#include <string>
 #include <utility>
 
 #include "mintrinsics/mnl_stdio.hpp"
@@ -7,9 +9,25 @@
 
 namespace Minuet::Intrinsics {
     auto native_print_value(Runtime::VM::Engine& vm, int16_t argc) -> bool {
-        const auto& argument_value = vm.handle_native_fn_access(argc, 0);
+        auto& argument_value = vm.handle_native_fn_access(argc, 0);
 
-        std::println("{}", argument_value.to_string());
+        /// NOTE: Strings are printed straight from their bytes to skip copying what may be a large output buffer.
+        if (argument_value.tag() == Runtime::FVTag::string) {
+            if (auto str_obj_p = argument_value.to_object_ptr(); str_obj_p) {
+                std::println("{}", static_cast<const Runtime::StringValue*>(str_obj_p)->view());
+
+                return true;
+            }
+        }
+
+        /// NOTE: Other values are formatted into one reused line buffer, so printing numbers allocates nothing in the steady state.
+        static std::string line_buffer;
+
+        line_buffer.clear();
+        argument_value.append_to(line_buffer);
+        line_buffer.push_back('\n');
+
+        std::fwrite(line_buffer.data(), 1, line_buffer.size(), stdout);
 
         return true;
     }
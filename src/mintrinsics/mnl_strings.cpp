@@ -1,7 +1,127 @@
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define MINUET_HAS_X86_SIMD 1
+#endif
+
 #include "mintrinsics/mnl_strings.hpp"
+#include "runtime/sequence_value.hpp"
 #include "runtime/string_value.hpp"
 
 namespace Minuet::Intrinsics {
+    /// NOTE: Every kernel gives the position of the first `needle` at or after `from`, or `npos`. The needle must be non-empty.
+    using find_bytes_fn = std::size_t(*)(std::string_view hay, std::string_view needle, std::size_t from) noexcept;
+
+    [[nodiscard]] static auto find_bytes_scalar(std::string_view hay, std::string_view needle, std::size_t from) noexcept -> std::size_t {
+        return hay.find(needle, from);
+    }
+
+#ifdef MINUET_HAS_X86_SIMD
+    /// NOTE: A block of candidate positions is found by matching the needle's first and last bytes at once, so only those candidates need a full compare of the middle bytes.
+    [[nodiscard]] static auto find_bytes_sse2(std::string_view hay, std::string_view needle, std::size_t from) noexcept -> std::size_t {
+        const auto hay_len = hay.size();
+        const auto needle_len = needle.size();
+        const auto hay_p = hay.data();
+        const auto needle_p = needle.data();
+
+        const auto first_bytes = _mm_set1_epi8(needle_p[0]);
+        const auto last_bytes = _mm_set1_epi8(needle_p[needle_len - 1]);
+        auto pos = from;
+
+        for (; pos + needle_len + 15 <= hay_len; pos += 16) {
+            const auto block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay_p + pos));
+            const auto block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay_p + pos + needle_len - 1));
+            auto candidates = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(
+                _mm_cmpeq_epi8(block_first, first_bytes),
+                _mm_cmpeq_epi8(block_last, last_bytes)
+            )));
+
+            while (candidates != 0) {
+                const auto candidate_pos = pos + static_cast<std::size_t>(__builtin_ctz(candidates));
+
+                if (needle_len <= 2 || std::memcmp(hay_p + candidate_pos + 1, needle_p + 1, needle_len - 2) == 0) {
+                    return candidate_pos;
+                }
+
+                candidates &= candidates - 1;
+            }
+        }
+
+        return find_bytes_scalar(hay, needle, pos);
+    }
+
+    __attribute__((target("avx2")))
+    [[nodiscard]] static auto find_bytes_avx2(std::string_view hay, std::string_view needle, std::size_t from) noexcept -> std::size_t {
+        const auto hay_len = hay.size();
+        const auto needle_len = needle.size();
+        const auto hay_p = hay.data();
+        const auto needle_p = needle.data();
+
+        const auto first_bytes = _mm256_set1_epi8(needle_p[0]);
+        const auto last_bytes = _mm256_set1_epi8(needle_p[needle_len - 1]);
+        auto pos = from;
+
+        for (; pos + needle_len + 31 <= hay_len; pos += 32) {
+            const auto block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay_p + pos));
+            const auto block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay_p + pos + needle_len - 1));
+            auto candidates = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(
+                _mm256_cmpeq_epi8(block_first, first_bytes),
+                _mm256_cmpeq_epi8(block_last, last_bytes)
+            )));
+
+            while (candidates != 0) {
+                const auto candidate_pos = pos + static_cast<std::size_t>(__builtin_ctz(candidates));
+
+                if (needle_len <= 2 || std::memcmp(hay_p + candidate_pos + 1, needle_p + 1, needle_len - 2) == 0) {
+                    return candidate_pos;
+                }
+
+                candidates &= candidates - 1;
+            }
+        }
+
+        return find_bytes_sse2(hay, needle, pos);
+    }
+#endif
+
+    /// NOTE: SSE2 is baseline on x86-64, so only AVX2 needs a runtime check. Other targets use the library search.
+    [[nodiscard]] static auto pick_find_bytes() noexcept -> find_bytes_fn {
+#ifdef MINUET_HAS_X86_SIMD
+        if (__builtin_cpu_supports("avx2")) {
+            return find_bytes_avx2;
+        }
+
+        return find_bytes_sse2;
+#else
+        return find_bytes_scalar;
+#endif
+    }
+
+    [[nodiscard]] static auto find_bytes(std::string_view hay, std::string_view needle, std::size_t from) noexcept -> std::size_t {
+        static const auto chosen_find_bytes = pick_find_bytes();
+
+        if (needle.size() > hay.size() || from > hay.size() - needle.size()) {
+            return std::string_view::npos;
+        }
+
+        return chosen_find_bytes(hay, needle, from);
+    }
+
+    /// @brief Gives a native's argument as a string, or `nullptr` if it isn't one.
+    [[nodiscard]] static auto access_string_arg(Runtime::VM::Engine& vm, int16_t argc, int16_t arg_pos) -> const Runtime::StringValue* {
+        auto arg_obj_p = vm.handle_native_fn_access(argc, arg_pos).to_object_ptr();
+
+        if (!arg_obj_p || arg_obj_p->get_tag() != Runtime::ObjectTag::string) {
+            return nullptr;
+        }
+
+        return static_cast<const Runtime::StringValue*>(arg_obj_p);
+    }
+
     auto native_strlen(Runtime::VM::Engine& vm, int16_t argc) -> bool {
         auto arg_0 = vm.handle_native_fn_access(argc, 0);
         
@@ -13,7 +133,7 @@ namespace Minuet::Intrinsics {
         return false;
     }
 
-    /// @brief Joins a string with another string, pushing the source's characters to the destination in sequence.
+    /// @brief Joins a string with another string, appending the source's bytes to the destination.
     auto native_strcat(Runtime::VM::Engine& vm, int16_t argc) -> bool {
         auto source_arg_p = vm.handle_native_fn_access(argc, 1).to_object_ptr();
         auto target_arg_p = vm.handle_native_fn_access(argc, 0).to_object_ptr();
@@ -22,45 +142,204 @@ namespace Minuet::Intrinsics {
             return false;
         }
 
-        if (source_arg_p->get_tag() != Runtime::ObjectTag::string || target_arg_p->get_tag() != Runtime::ObjectTag::string) {
+        if (source_arg_p->get_tag() != Runtime::ObjectTag::string || target_arg_p->get_tag() != Runtime::ObjectTag::string || target_arg_p->is_frozen()) {
             return false;
         }
 
-        for (const auto& source_items = source_arg_p->items(); const auto& item : source_items) {
-            if (!target_arg_p->push_value(item)) {
-                return false;
-            }
-        }
+        const auto old_score = target_arg_p->get_memory_score();
+
+        static_cast<Runtime::StringValue*>(target_arg_p)->append(
+            static_cast<const Runtime::StringValue*>(source_arg_p)->view()
+        );
+
+        vm.handle_native_fn_access_heap().track_resize(old_score, target_arg_p->get_memory_score());
 
         return true;
     }
 
-    /// @brief Slices a substring copy from a source string by `begin` ahead by `length`.
+    /// @brief Slices a substring from a source string by `begin` ahead by `length`. The result shares the source's characters until either string is mutated.
     auto native_substr(Runtime::VM::Engine& vm, int16_t argc) -> bool {
-        auto source_arg_p = vm.handle_native_fn_access(argc, 0).to_object_ptr();
+        const auto source_str_p = access_string_arg(vm, argc, 0);
         const auto slice_begin = vm.handle_native_fn_access(argc, 1).to_scalar().value_or(0);
         const auto slice_len = vm.handle_native_fn_access(argc, 2).to_scalar().value_or(0);
 
-        if (!source_arg_p || slice_len == 0) {
+        if (!source_str_p || slice_begin < 0 || slice_len <= 0) {
             return false;
         }
 
-        if (source_arg_p->get_tag() != Runtime::ObjectTag::string) {
+        if (const auto source_len = source_str_p->get_size(); slice_begin + slice_len > source_len) {
+            return false;
+        }
+
+        if (auto result_obj_p = vm.handle_native_fn_access_heap().try_create_value<Runtime::StringValue>(
+            *source_str_p,
+            static_cast<std::size_t>(slice_begin),
+            static_cast<std::size_t>(slice_len)
+        ).get(); result_obj_p) {
+            vm.handle_native_fn_return(
+                Runtime::FastValue {
+                    result_obj_p,
+                    Runtime::FVTag::string,
+                },
+                argc
+            );
+
+            return true;
+        }
+
+        return false;
+    }
+
+    auto native_str_find(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto source_str_p = access_string_arg(vm, argc, 0);
+        const auto needle_str_p = access_string_arg(vm, argc, 1);
+
+        if (!source_str_p || !needle_str_p) {
             return false;
         }
 
-        const auto slice_end = slice_begin + slice_len;
+        const auto source_text = source_str_p->view();
+        const auto needle_text = needle_str_p->view();
+
+        if (needle_text.empty()) {
+            vm.handle_native_fn_return({0}, argc);
+            return true;
+        }
+
+        const auto match_pos = find_bytes(source_text, needle_text, 0);
+
+        vm.handle_native_fn_return(
+            {(match_pos != std::string_view::npos) ? static_cast<int>(match_pos) : -1},
+            argc
+        );
+
+        return true;
+    }
+
+    auto native_str_count(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto source_str_p = access_string_arg(vm, argc, 0);
+        const auto needle_str_p = access_string_arg(vm, argc, 1);
+
+        if (!source_str_p || !needle_str_p || needle_str_p->view().empty()) {
+            return false;
+        }
+
+        const auto source_text = source_str_p->view();
+        const auto needle_text = needle_str_p->view();
+        int match_count = 0;
+
+        for (auto match_pos = find_bytes(source_text, needle_text, 0); match_pos != std::string_view::npos; match_pos = find_bytes(source_text, needle_text, match_pos + needle_text.size())) {
+            ++match_count;
+        }
+
+        vm.handle_native_fn_return({match_count}, argc);
+
+        return true;
+    }
+
+    auto native_str_split(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto source_str_p = access_string_arg(vm, argc, 0);
+        const auto delim_str_p = access_string_arg(vm, argc, 1);
+
+        if (!source_str_p || !delim_str_p || delim_str_p->view().empty()) {
+            return false;
+        }
+
+        auto& heap = vm.handle_native_fn_access_heap();
+
+        /// NOTE: The pieces are slices sharing the source's characters. Creating them may grow the object table, so only the list's address is kept and not its (then stale) table slot.
+        auto pieces_obj_p = heap.try_create_value<Runtime::SequenceValue>().get();
+
+        if (!pieces_obj_p) {
+            return false;
+        }
+
+        const auto old_score = pieces_obj_p->get_memory_score();
+        const auto source_text = source_str_p->view();
+        const auto delim_text = delim_str_p->view();
+        std::size_t piece_begin = 0;
+
+        while (true) {
+            const auto piece_end = find_bytes(source_text, delim_text, piece_begin);
+            const auto piece_len = ((piece_end != std::string_view::npos) ? piece_end : source_text.size()) - piece_begin;
+            auto piece_obj_p = heap.try_create_value<Runtime::StringValue>(*source_str_p, piece_begin, piece_len).get();
+
+            if (!piece_obj_p || !pieces_obj_p->push_value({piece_obj_p, Runtime::FVTag::string})) {
+                return false;
+            }
+
+            if (piece_end == std::string_view::npos) {
+                break;
+            }
+
+            piece_begin = piece_end + delim_text.size();
+        }
+
+        heap.track_resize(old_score, pieces_obj_p->get_memory_score());
+
+        vm.handle_native_fn_return(
+            Runtime::FastValue {
+                pieces_obj_p,
+                Runtime::FVTag::sequence,
+            },
+            argc
+        );
+
+        return true;
+    }
+
+    auto native_str_replace(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto source_str_p = access_string_arg(vm, argc, 0);
+        const auto needle_str_p = access_string_arg(vm, argc, 1);
+        const auto replacement_str_p = access_string_arg(vm, argc, 2);
+
+        if (!source_str_p || !needle_str_p || !replacement_str_p || needle_str_p->view().empty()) {
+            return false;
+        }
+
+        const auto source_text = source_str_p->view();
+        const auto needle_text = needle_str_p->view();
+        const auto replacement_text = replacement_str_p->view();
+
+        std::string result_text;
+        result_text.reserve(source_text.size());
+
+        std::size_t copy_begin = 0;
+
+        for (auto match_pos = find_bytes(source_text, needle_text, 0); match_pos != std::string_view::npos; match_pos = find_bytes(source_text, needle_text, copy_begin)) {
+            result_text.append(source_text.substr(copy_begin, match_pos - copy_begin));
+            result_text.append(replacement_text);
+            copy_begin = match_pos + needle_text.size();
+        }
+
+        result_text.append(source_text.substr(copy_begin));
+
+        if (auto result_obj_p = vm.handle_native_fn_access_heap().try_create_value<Runtime::StringValue>(std::move(result_text)).get(); result_obj_p) {
+            vm.handle_native_fn_return(
+                Runtime::FastValue {
+                    result_obj_p,
+                    Runtime::FVTag::string,
+                },
+                argc
+            );
+
+            return true;
+        }
+
+        return false;
+    }
+
+    auto native_intern(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto source_str_p = access_string_arg(vm, argc, 0);
 
-        if (const auto source_len = source_arg_p->get_size(); slice_end >= source_len) {
+        if (!source_str_p) {
             return false;
         }
 
-        if (auto& result_obj_p = vm.handle_native_fn_access_heap().try_create_value<Runtime::StringValue>(
-            source_arg_p->to_string().substr(slice_begin, slice_len)
-        ); result_obj_p) {
+        if (auto interned_p = vm.handle_native_fn_access_heap().intern_string(source_str_p->view()); interned_p) {
             vm.handle_native_fn_return(
                 Runtime::FastValue {
-                    result_obj_p.get(),
+                    interned_p,
                     Runtime::FVTag::string,
                 },
                 argc
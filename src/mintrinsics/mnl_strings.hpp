@@ -7,11 +7,26 @@ namespace Minuet::Intrinsics {
     /// @brief Gets the count of a list's items.
     [[nodiscard]] auto native_strlen(Runtime::VM::Engine& vm, int16_t argc) -> bool;
 
-    /// @brief Joins a string with another string, pushing the source's characters to the destination in sequence.
+    /// @brief Joins a string with another string, appending the source's bytes to the destination.
     [[nodiscard]] auto native_strcat(Runtime::VM::Engine& vm, int16_t argc) -> bool;
 
-    /// @brief Slices a substring copy from a source string by `begin` ahead by `length`.
+    /// @brief Slices a substring from a source string by `begin` ahead by `length`, sharing the source's characters.
     [[nodiscard]] auto native_substr(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Gets the position of a needle's first occurrence in a string, or `-1` if there's none.
+    [[nodiscard]] auto native_str_find(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Counts the non-overlapping occurrences of a non-empty needle in a string.
+    [[nodiscard]] auto native_str_count(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Splits a string by a non-empty delimiter into a list of substrings, keeping empty pieces.
+    [[nodiscard]] auto native_str_split(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Makes a new string where every non-overlapping occurrence of a non-empty needle is replaced.
+    [[nodiscard]] auto native_str_replace(Runtime::VM::Engine& vm, int16_t argc) -> bool;
+
+    /// @brief Gives the canonical, read-only copy of a string's contents. Interned strings compare by identity and can't be mutated.
+    [[nodiscard]] auto native_intern(Runtime::VM::Engine& vm, int16_t argc) -> bool;
 }
 
 #endif
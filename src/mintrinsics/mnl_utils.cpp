@@ -1,64 +1,91 @@
+#include <algorithm>
+#include <charconv>
 #include <iostream>
+#include <optional>
 #include <print>
-#include <string>
-#include <stdexcept>
+#include <string_view>
+#include <system_error>
 
 #include "mintrinsics/mnl_utils.hpp"
+#include "runtime/string_value.hpp"
 
 namespace Minuet::Intrinsics {
-    auto native_stoi(Runtime::VM::Engine& vm, int16_t argc) -> bool {
-        auto& source_ref = vm.handle_native_fn_access(argc, 0);
+    static constexpr std::string_view number_spaces = " \t\n\r\f\v";
 
-        if (auto source_as_obj_p = source_ref.to_object_ptr(); source_as_obj_p) {
-            std::string source_text = source_as_obj_p->to_string();
+    /// @brief Gets the numeric text of a string argument: leading whitespace and a `+` sign are skipped.
+    [[nodiscard]] static auto access_number_text(Runtime::VM::Engine& vm, int16_t argc) -> std::optional<std::string_view> {
+        auto source_obj_p = vm.handle_native_fn_access(argc, 0).to_object_ptr();
 
-            try {
-                vm.handle_native_fn_return(Runtime::FastValue {
-                    std::stoi(source_text)
-                }, argc);
-            } catch (const std::invalid_argument& parse_error) {
-                std::println(std::cerr, "NativeError: {}", parse_error.what());
+        if (!source_obj_p || source_obj_p->get_tag() != Runtime::ObjectTag::string) {
+            return {};
+        }
 
-                return false;
-            } catch (const std::out_of_range& repr_error) {
-                std::println(std::cerr, "NativeError: {}", repr_error.what());
+        auto source_text = static_cast<const Runtime::StringValue*>(source_obj_p)->view();
 
-                return false;
-            }
+        source_text.remove_prefix(std::min(source_text.find_first_not_of(number_spaces), source_text.size()));
 
-            return true;
+        /// NOTE: `std::from_chars` takes a leading `-` itself, so the `+` of text like `+-5` is kept for the parse to reject.
+        if (source_text.starts_with('+') && source_text.find_first_of("+-", 1) != 1) {
+            source_text.remove_prefix(1);
         }
 
-        return false;
+        return source_text;
     }
 
-    auto native_stof(Runtime::VM::Engine& vm, int16_t argc) -> bool {
-        auto& source_ref = vm.handle_native_fn_access(argc, 0);
+    /// NOTE: Only whitespace may follow the number, so text like `12abc` is invalid instead of giving `12`.
+    [[nodiscard]] static auto check_parse(std::from_chars_result parse_result, std::string_view number_text) -> bool {
+        const auto [parse_end, parse_status] = parse_result;
+        const auto rest_text = number_text.substr(static_cast<std::size_t>(parse_end - number_text.data()));
+
+        if (parse_status == std::errc::invalid_argument || rest_text.find_first_not_of(number_spaces) != std::string_view::npos) {
+            std::println(std::cerr, "NativeError: invalid number text '{}'", number_text);
+            return false;
+        } else if (parse_status == std::errc::result_out_of_range) {
+            std::println(std::cerr, "NativeError: number out of range '{}'", number_text);
+            return false;
+        }
+
+        return true;
+    }
+
+    auto native_stoi(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto number_text = access_number_text(vm, argc);
+
+        if (!number_text) {
+            return false;
+        }
+
+        int result = 0;
+
+        if (!check_parse(std::from_chars(number_text->data(), number_text->data() + number_text->size(), result), *number_text)) {
+            return false;
+        }
 
-        if (auto source_as_obj_p = source_ref.to_object_ptr(); source_as_obj_p) {
-            std::string source_text = source_as_obj_p->to_string();
+        vm.handle_native_fn_return(Runtime::FastValue {result}, argc);
 
-            try {
-                vm.handle_native_fn_return(Runtime::FastValue {
-                    std::stof(source_text)
-                }, argc);
-            } catch (const std::invalid_argument& parse_error) {
-                std::println(std::cerr, "NativeError: {}", parse_error.what());
+        return true;
+    }
 
-                return false;
-            } catch (const std::out_of_range& repr_error) {
-                std::println(std::cerr, "NativeError: {}", repr_error.what());
+    /// NOTE: The text is parsed straight to a `double`, so no precision is lost by narrowing to `float`.
+    auto native_stof(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto number_text = access_number_text(vm, argc);
 
-                return false;
-            }
+        if (!number_text) {
+            return false;
+        }
+
+        double result = 0.0;
 
-            return true;
+        if (!check_parse(std::from_chars(number_text->data(), number_text->data() + number_text->size(), result), *number_text)) {
+            return false;
         }
 
-        return false;
+        vm.handle_native_fn_return(Runtime::FastValue {result}, argc);
+
+        return true;
     }
 
-    /// TODO: Fix a possible bug of the arguments sequence being garbage collected early if its reference prematurely becomes unreachable. One possible solution could be to rewrite the heap to contain the argv separately from the usual object pool. Then `fun main: [argv]` would have the arguments reference implicitly passed.
+    /// NOTE: The arguments sequence is always a GC root, so it's safe to fetch it again after its previous reference becomes unreachable.
     auto native_get_argv(Runtime::VM::Engine& vm, int16_t argc) -> bool {
         auto argv_list_ptr = vm.handle_native_fn_access_argv();
 
@@ -69,4 +96,13 @@ namespace Minuet::Intrinsics {
 
         return true;
     }
-}
\ No newline at end of file
+
+    /// @brief Writes a heap snapshot on demand (see `--heap-snapshot`), giving `true` if it was written.
+    auto native_dump_heap(Runtime::VM::Engine& vm, int16_t argc) -> bool {
+        const auto dumped_ok = vm.dump_heap_snapshot();
+
+        vm.handle_native_fn_return(Runtime::FastValue {dumped_ok}, argc);
+
+        return true;
+    }
+}
@@ -10,7 +10,15 @@ namespace Minuet::Runtime::Code {
         "seq_obj_push",
         "seq_obj_pop",
         "seq_obj_get",
+        "seq_obj_get_unchecked",
+        "seq_obj_set",
         "frz_seq_obj",
+        "make_dict",
+        "dict_get",
+        "dict_set",
+        "load_obj",
+        "iter_init",
+        "iter_next_or_jump",
         "load_const",
         "mov",
         "neg",
@@ -19,6 +27,8 @@ namespace Minuet::Runtime::Code {
         "mul",
         "div",
         "mod",
+        "shr",
+        "bit_and",
         "add",
         "sub",
         "equ",
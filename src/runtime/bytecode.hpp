@@ -17,7 +17,15 @@ namespace Minuet::Runtime::Code {
         seq_obj_push,
         seq_obj_pop,
         seq_obj_get,
+        seq_obj_get_unchecked,
+        seq_obj_set,
         frz_seq_obj,
+        make_dict,
+        dict_get,
+        dict_set,
+        load_obj,
+        iter_init,
+        iter_next_or_jump,
         load_const,
         mov,
         neg,
@@ -26,6 +34,8 @@ namespace Minuet::Runtime::Code {
         mul,
         div,
         mod,
+        shr,
+        bit_and,
         add,
         sub,
         equ,
@@ -76,6 +86,9 @@ namespace Minuet::Runtime::Code {
         return 0;
     }
 
+    /// NOTE: 2nd argument of a `jump` which marks it as a loop back-edge, a.k.a a GC safepoint.
+    constexpr int16_t jump_safepoint_flag = 1;
+
     using Chunk = std::vector<Instruction>;
 
     struct Program {
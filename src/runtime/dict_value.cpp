@@ -0,0 +1,371 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "runtime/dict_value.hpp"
+#include "runtime/string_value.hpp"
+
+namespace Minuet::Runtime {
+    /// NOTE: spreads the low-entropy hashes of small integers & pointers over all bits (the SplitMix64 finalizer), since buckets are picked by the low bits.
+    [[nodiscard]] static constexpr auto mix_hash(uint64_t hash) noexcept -> std::size_t {
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebULL;
+        hash ^= hash >> 31;
+
+        return static_cast<std::size_t>(hash);
+    }
+
+    /// NOTE: keeps the bucket table at most 7/8 full.
+    [[nodiscard]] static constexpr auto over_load(std::size_t entry_count, std::size_t bucket_count) noexcept -> bool {
+        return entry_count * 8 > bucket_count * 7;
+    }
+
+    DictValue::DictValue()
+    : m_entries {}, m_hashes {}, m_buckets {}, m_count {0UL}, m_frozen {false} {}
+
+    auto DictValue::hash_key(const FastValue& key) noexcept -> std::size_t {
+        const auto key_tag = key.tag();
+        const auto tag_salt = static_cast<uint64_t>(key_tag) << 56;
+
+        switch (key_tag) {
+        case FVTag::boolean:
+        case FVTag::chr8:
+        case FVTag::int32:
+            return mix_hash(tag_salt ^ static_cast<uint32_t>(key.to_scalar().value_or(0)));
+        case FVTag::flt64:
+            {
+                /// NOTE: `-0.0 == 0.0`, so both must hash alike.
+                const auto real = key.to_real().value_or(0.0);
+
+                return mix_hash(tag_salt ^ std::bit_cast<uint64_t>((real == 0.0) ? 0.0 : real));
+            }
+        case FVTag::string:
+            return static_cast<const StringValue*>(key.to_object_ptr())->get_hash();
+        case FVTag::sequence:
+            return mix_hash(reinterpret_cast<uintptr_t>(key.to_object_ptr()));
+        case FVTag::val_ref:
+            return hash_key(key.deref());
+        case FVTag::dud:
+        default:
+            return 0;
+        }
+    }
+
+    auto DictValue::keys_equal(const FastValue& lhs, const FastValue& rhs) noexcept -> bool {
+        if (lhs.tag() != rhs.tag()) {
+            return false;
+        }
+
+        switch (lhs.tag()) {
+        case FVTag::string:
+            {
+                const auto lhs_obj_p = lhs.to_object_ptr();
+                const auto rhs_obj_p = rhs.to_object_ptr();
+
+                return lhs_obj_p == rhs_obj_p || *lhs_obj_p == *rhs_obj_p;
+            }
+        case FVTag::sequence:
+            return lhs.to_object_ptr() == rhs.to_object_ptr();
+        case FVTag::dud:
+            return true;
+        default:
+            return lhs == rhs;
+        }
+    }
+
+    auto DictValue::find_bucket(const FastValue& key, std::size_t hash) const noexcept -> std::optional<std::size_t> {
+        if (m_buckets.empty()) {
+            return {};
+        }
+
+        const auto bucket_mask = m_buckets.size() - 1;
+        auto bucket_pos = hash & bucket_mask;
+
+        /// NOTE: Robin Hood invariant- once a bucket is closer to its home than the key would be here, the key can't be any further along.
+        for (uint32_t probe_len = 1; ; ++probe_len) {
+            const auto [entry_id, bucket_probe_len] = m_buckets[bucket_pos];
+
+            if (bucket_probe_len < probe_len) {
+                return {};
+            }
+
+            if (m_hashes[entry_id] == hash && keys_equal(m_entries[entry_id * 2], key)) {
+                return bucket_pos;
+            }
+
+            bucket_pos = (bucket_pos + 1) & bucket_mask;
+        }
+    }
+
+    void DictValue::place_bucket(Bucket bucket, std::size_t hash) noexcept {
+        const auto bucket_mask = m_buckets.size() - 1;
+        auto bucket_pos = hash & bucket_mask;
+
+        bucket.probe_len = 1;
+
+        /// NOTE: Robin Hood insertion- the incoming bucket takes the place of any bucket nearer to its home, which then moves along instead.
+        while (m_buckets[bucket_pos].probe_len != 0) {
+            if (m_buckets[bucket_pos].probe_len < bucket.probe_len) {
+                std::swap(m_buckets[bucket_pos], bucket);
+            }
+
+            bucket_pos = (bucket_pos + 1) & bucket_mask;
+            ++bucket.probe_len;
+        }
+
+        m_buckets[bucket_pos] = bucket;
+    }
+
+    void DictValue::reindex(std::size_t pair_capacity) {
+        auto bucket_count = cm_min_bucket_count;
+
+        while (over_load(pair_capacity, bucket_count)) {
+            bucket_count *= 2;
+        }
+
+        /// NOTE: A fresh table is swapped in so that a smaller one also releases the old capacity.
+        m_buckets = std::vector<Bucket>(bucket_count, Bucket {0, 0});
+
+        for (std::size_t entry_id = 0; entry_id < m_hashes.size(); ++entry_id) {
+            if (!m_entries[entry_id * 2].is_none()) {
+                place_bucket(Bucket {static_cast<uint32_t>(entry_id), 0}, m_hashes[entry_id]);
+            }
+        }
+    }
+
+    void DictValue::rehash(std::size_t pair_capacity) {
+        /// 1. Slide the live pairs down over any erased ones.
+        std::size_t live_id = 0;
+
+        for (std::size_t entry_id = 0; entry_id < m_hashes.size(); ++entry_id) {
+            if (m_entries[entry_id * 2].is_none()) {
+                continue;
+            }
+
+            if (entry_id != live_id) {
+                m_entries[live_id * 2] = m_entries[entry_id * 2];
+                m_entries[live_id * 2 + 1] = m_entries[entry_id * 2 + 1];
+                m_hashes[live_id] = m_hashes[entry_id];
+            }
+
+            ++live_id;
+        }
+
+        m_entries.resize(live_id * 2);
+        m_hashes.resize(live_id);
+
+        /// 2. Re-index every live pair into a fresh bucket table.
+        reindex(pair_capacity);
+    }
+
+    auto DictValue::find(const FastValue& key) noexcept -> FastValue* {
+        if (const auto bucket_pos_opt = find_bucket(key, hash_key(key)); bucket_pos_opt) {
+            return &m_entries[m_buckets[bucket_pos_opt.value()].entry_id * 2 + 1];
+        }
+
+        return nullptr;
+    }
+
+    auto DictValue::find(const FastValue& key) const noexcept -> const FastValue* {
+        if (const auto bucket_pos_opt = find_bucket(key, hash_key(key)); bucket_pos_opt) {
+            return &m_entries[m_buckets[bucket_pos_opt.value()].entry_id * 2 + 1];
+        }
+
+        return nullptr;
+    }
+
+    auto DictValue::insert(FastValue key, FastValue value) -> FastValue* {
+        if (m_frozen || key.is_none()) {
+            return nullptr;
+        }
+
+        /// NOTE: Erased pairs still count against the load here, so a table churned by erasures gets compacted rather than grown.
+        if (over_load(m_hashes.size() + 1, m_buckets.size())) {
+            rehash(m_count + 1);
+        }
+
+        const auto key_hash = hash_key(key);
+        const auto entry_id = static_cast<uint32_t>(m_hashes.size());
+
+        m_entries.emplace_back(key);
+        m_entries.emplace_back(value);
+        m_hashes.emplace_back(key_hash);
+        place_bucket(Bucket {entry_id, 0}, key_hash);
+        ++m_count;
+
+        return &m_entries[entry_id * 2 + 1];
+    }
+
+    auto DictValue::erase(const FastValue& key) noexcept -> bool {
+        const auto bucket_pos_opt = (m_frozen) ? std::nullopt : find_bucket(key, hash_key(key));
+
+        if (!bucket_pos_opt) {
+            return false;
+        }
+
+        const auto bucket_mask = m_buckets.size() - 1;
+        auto bucket_pos = bucket_pos_opt.value();
+        const auto entry_id = m_buckets[bucket_pos].entry_id;
+
+        /// NOTE: The pair is left as duds so that no other entry ids shift, and the GC can't find a stale reference there.
+        m_entries[entry_id * 2] = {};
+        m_entries[entry_id * 2 + 1] = {};
+        --m_count;
+
+        /// NOTE: backward-shift deletion- later buckets of the same probe run move one step closer to home, so no tombstone buckets are needed.
+        for (auto next_pos = (bucket_pos + 1) & bucket_mask; m_buckets[next_pos].probe_len > 1; next_pos = (next_pos + 1) & bucket_mask) {
+            m_buckets[bucket_pos] = m_buckets[next_pos];
+            --m_buckets[bucket_pos].probe_len;
+            bucket_pos = next_pos;
+        }
+
+        m_buckets[bucket_pos] = Bucket {0, 0};
+
+        return true;
+    }
+
+    auto DictValue::keys() const -> std::vector<FastValue> {
+        std::vector<FastValue> live_keys;
+
+        live_keys.reserve(m_count);
+
+        for (std::size_t entry_id = 0; entry_id < m_hashes.size(); ++entry_id) {
+            if (const auto& key = m_entries[entry_id * 2]; !key.is_none()) {
+                live_keys.emplace_back(key);
+            }
+        }
+
+        return live_keys;
+    }
+
+    auto DictValue::get_memory_score() const& noexcept -> std::size_t {
+        return sizeof(DictValue) + m_entries.capacity() * sizeof(FastValue) + m_hashes.capacity() * sizeof(std::size_t) + m_buckets.capacity() * sizeof(Bucket);
+    }
+
+    auto DictValue::get_tag() const& noexcept -> ObjectTag {
+        return ObjectTag::dict;
+    }
+
+    auto DictValue::get_size() const& noexcept -> int {
+        return static_cast<int>(m_count);
+    }
+
+    auto DictValue::is_frozen() const& noexcept -> bool {
+        return m_frozen;
+    }
+
+    auto DictValue::push_value([[maybe_unused]] FastValue arg) -> bool {
+        return false;
+    }
+
+    auto DictValue::pop_value([[maybe_unused]] SequenceOpPolicy mode) -> FastValue {
+        return {};
+    }
+
+    auto DictValue::set_value([[maybe_unused]] FastValue arg, [[maybe_unused]] std::size_t pos) -> bool {
+        return false;
+    }
+
+    auto DictValue::get_value([[maybe_unused]] std::size_t pos) -> std::optional<FastValue*> {
+        return {};
+    }
+
+    auto DictValue::get_packed_value([[maybe_unused]] std::size_t pos) const -> std::optional<FastValue> {
+        return {};
+    }
+
+    void DictValue::freeze() noexcept {
+        m_frozen = true;
+    }
+
+    /// NOTE: Erased pairs before the last live one stay put, since a for-in loop over this dict may be partway past them by position. Pairs are only reallocated if none holds an item reference, which must not move.
+    void DictValue::trim_storage([[maybe_unused]] std::span<FastValue*> item_refs) {
+        if (m_frozen) {
+            return;
+        }
+
+        while (!m_hashes.empty() && m_entries[m_entries.size() - 2].is_none()) {
+            m_entries.resize(m_entries.size() - 2);
+            m_hashes.pop_back();
+        }
+
+        if (m_buckets.size() > cm_min_bucket_count && m_hashes.size() * 8 < m_buckets.size()) {
+            reindex(m_hashes.size());
+        }
+
+        if (m_hashes.size() * 4 <= m_hashes.capacity() && std::ranges::none_of(m_entries, [](const FastValue& item) { return item.tag() == FVTag::val_ref; })) {
+            m_entries.shrink_to_fit();
+            m_hashes.shrink_to_fit();
+        }
+    }
+
+    auto DictValue::items() noexcept -> std::span<FastValue> {
+        return m_entries;
+    }
+
+    auto DictValue::items() const noexcept -> std::span<const FastValue> {
+        return m_entries;
+    }
+
+    auto DictValue::clone() -> std::unique_ptr<HeapValueBase> {
+        auto copy = std::make_unique<DictValue>(*this);
+
+        copy->m_frozen = false;
+
+        return copy;
+    }
+
+    auto DictValue::as_fast_value() noexcept -> FastValue {
+        return {this, FVTag::sequence};
+    }
+
+    auto DictValue::to_string() const& noexcept -> std::string {
+        std::string text;
+        auto needs_comma = false;
+
+        text.push_back('{');
+
+        for (std::size_t entry_id = 0; entry_id < m_hashes.size(); ++entry_id) {
+            if (m_entries[entry_id * 2].is_none()) {
+                continue;
+            }
+
+            if (needs_comma) {
+                text.append(", ");
+            }
+
+            m_entries[entry_id * 2].append_to(text);
+            text.append(": ");
+            m_entries[entry_id * 2 + 1].append_to(text);
+            needs_comma = true;
+        }
+
+        text.push_back('}');
+
+        return text;
+    }
+
+    auto DictValue::operator==(const HeapValueBase& rhs) const noexcept -> bool {
+        if (rhs.get_tag() != ObjectTag::dict || rhs.get_size() != get_size()) {
+            return false;
+        }
+
+        const auto& rhs_dict = static_cast<const DictValue&>(rhs);
+
+        for (std::size_t entry_id = 0; entry_id < m_hashes.size(); ++entry_id) {
+            if (m_entries[entry_id * 2].is_none()) {
+                continue;
+            }
+
+            if (const auto rhs_value_p = rhs_dict.find(m_entries[entry_id * 2]); !rhs_value_p || !(*rhs_value_p == m_entries[entry_id * 2 + 1])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef MINUET_RUNTIME_DICT_VALUE_HPP
+#define MINUET_RUNTIME_DICT_VALUE_HPP
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "runtime/fast_value.hpp"
+
+namespace Minuet::Runtime {
+    /**
+     * @brief Maps FastValue keys to FastValues by Robin Hood open addressing. Keys and values are stored in insertion order as flat pairs, and a power-of-two bucket table indexes them by hash, so lookups probe a small contiguous array and the GC can trace every pair through `items()`.
+     * @note Scalars are keyed by value, strings by their characters, and other objects by identity. Erased pairs become duds until the next rehash compacts them away.
+     */
+    class DictValue : public HeapValueBase {
+    private:
+        static constexpr auto cm_min_bucket_count = 8UL;
+
+        /// NOTE: `probe_len` is one more than the bucket's distance from its home slot, so `0` marks an empty bucket.
+        struct Bucket {
+            uint32_t entry_id;
+            uint32_t probe_len;
+        };
+
+        std::vector<FastValue> m_entries;  // key, value, key, value, ...
+        std::vector<std::size_t> m_hashes; // hash of each entry's key
+        std::vector<Bucket> m_buckets;
+        std::size_t m_count;
+        bool m_frozen;
+
+        [[nodiscard]] auto find_bucket(const FastValue& key, std::size_t hash) const noexcept -> std::optional<std::size_t>;
+        void place_bucket(Bucket bucket, std::size_t hash) noexcept;
+
+        /// @brief Rebuilds the bucket table for the current pairs in place, sized to hold `pair_capacity` pairs. Erased pairs get no bucket.
+        void reindex(std::size_t pair_capacity);
+
+        /// @brief Drops erased pairs and rebuilds the bucket table, sized to hold `pair_capacity` pairs.
+        void rehash(std::size_t pair_capacity);
+
+    public:
+        static constexpr auto cm_object_tag = ObjectTag::dict;
+
+        DictValue();
+
+        /// @brief Hashes a key structurally: strings by their characters, other objects by address, and scalars by value.
+        [[nodiscard]] static auto hash_key(const FastValue& key) noexcept -> std::size_t;
+        [[nodiscard]] static auto keys_equal(const FastValue& lhs, const FastValue& rhs) noexcept -> bool;
+
+        /// @brief Gets the value slot of a key, or `nullptr` if the key is absent.
+        [[nodiscard]] auto find(const FastValue& key) noexcept -> FastValue*;
+        [[nodiscard]] auto find(const FastValue& key) const noexcept -> const FastValue*;
+
+        /**
+         * @brief Adds a new key with a value. The caller must check that the key is absent first, and string keys should be interned beforehand so that later mutations of the original string can't corrupt the table.
+         *
+         * @param key
+         * @param value
+         * @return FastValue* The new value slot, or `nullptr` if this dict is frozen. Any slot is invalidated by later insertions.
+         */
+        [[nodiscard]] auto insert(FastValue key, FastValue value) -> FastValue*;
+        [[nodiscard]] auto erase(const FastValue& key) noexcept -> bool;
+
+        /// NOTE: views the live keys in insertion order
+        [[nodiscard]] auto keys() const -> std::vector<FastValue>;
+
+        [[nodiscard]] auto get_memory_score() const& noexcept -> std::size_t override;
+        [[nodiscard]] auto get_tag() const& noexcept -> ObjectTag override;
+        [[nodiscard]] auto get_size() const& noexcept -> int override;
+        [[nodiscard]] auto is_frozen() const& noexcept -> bool override;
+
+        /// NOTE: dicts have no positions, so the sequence operations below always fail.
+        [[nodiscard]] auto push_value(FastValue arg) -> bool override;
+        [[nodiscard]] auto pop_value(SequenceOpPolicy mode) -> FastValue override;
+        [[nodiscard]] auto set_value(FastValue arg, std::size_t pos) -> bool override;
+        [[nodiscard]] auto get_value(std::size_t pos) -> std::optional<FastValue*> override;
+        [[nodiscard]] auto get_packed_value(std::size_t pos) const -> std::optional<FastValue> override;
+
+        void freeze() noexcept override;
+        void trim_storage(std::span<FastValue*> item_refs) override;
+        /// NOTE: views the flat key-value pairs, including dud pairs left by erasures
+        [[nodiscard]] auto items() noexcept -> std::span<FastValue> override;
+        [[nodiscard]] auto items() const noexcept -> std::span<const FastValue> override;
+        [[nodiscard]] auto clone() -> std::unique_ptr<HeapValueBase> override;
+
+        [[nodiscard]] auto as_fast_value() noexcept -> FastValue override;
+        [[nodiscard]] auto to_string() const& noexcept -> std::string override;
+
+        [[nodiscard]] auto operator==(const HeapValueBase& rhs) const noexcept -> bool override;
+    };
+}
+
+#endif
@@ -1,3 +1,5 @@
+#include <array>
+#include <charconv>
 #include <format>
 #include "runtime/fast_value.hpp"
 
@@ -38,6 +40,39 @@ namespace Minuet::Runtime {
         }
     }
 
+    auto FastValue::to_object_ptr() const noexcept -> const HeapValueBase* {
+        switch (m_tag) {
+            case FVTag::sequence:
+            case FVTag::string:
+                return m_data.obj_p;
+            default:
+                return nullptr;
+        }
+    }
+
+    auto FastValue::to_ref_ptr() const noexcept -> FastValue* {
+        return (m_tag == FVTag::val_ref) ? m_data.fv_p : nullptr;
+    }
+
+    auto FastValue::to_real() const noexcept -> std::optional<double> {
+        switch (m_tag) {
+        case FVTag::int32:
+            return static_cast<double>(m_data.scalar_v);
+        case FVTag::flt64:
+            return m_data.dbl_v;
+        default:
+            return {};
+        }
+    }
+
+    auto FastValue::deref() const noexcept -> const FastValue& {
+        if (m_tag == FVTag::val_ref && m_data.fv_p != nullptr) {
+            return m_data.fv_p->deref();
+        }
+
+        return *this;
+    }
+
     auto FastValue::negate() & -> bool {
         switch (tag()) {
         case FVTag::boolean:
@@ -469,25 +504,50 @@ namespace Minuet::Runtime {
         return false;
     }
 
-    [[nodiscard]] auto FastValue::to_string() const& -> std::string {
+    /// NOTE: holds the longest text of an int32 or a shortest round-trip flt64, e.g `-2.2250738585072014e-308`
+    static constexpr auto number_text_max = 32UL;
+
+    void FastValue::append_to(std::string& buffer) const& {
+        std::array<char, number_text_max> number_text;
+
         switch (tag()) {
         case FVTag::dud:
-            return "(dud)";
+            buffer.append("(dud)");
+            break;
         case FVTag::boolean:
-            return std::format("{}", m_data.scalar_v != 0);
+            buffer.append((m_data.scalar_v != 0) ? "true" : "false");
+            break;
         case FVTag::chr8:
-            return std::format("'{}'", static_cast<char>(m_data.scalar_v & 0x7f));
+            buffer.push_back('\'');
+            buffer.push_back(static_cast<char>(m_data.scalar_v & 0x7f));
+            buffer.push_back('\'');
+            break;
         case FVTag::int32:
-            return std::format("{}", m_data.scalar_v);
+            buffer.append(number_text.data(), std::to_chars(number_text.data(), number_text.data() + number_text.size(), m_data.scalar_v).ptr);
+            break;
         case FVTag::flt64:
-            return std::format("{}", m_data.dbl_v);
+            buffer.append(number_text.data(), std::to_chars(number_text.data(), number_text.data() + number_text.size(), m_data.dbl_v).ptr);
+            break;
         case FVTag::val_ref:
-            return std::format("ref(FastValue({}))", m_data.fv_p->to_string());
+            buffer.append("ref(FastValue(");
+            m_data.fv_p->append_to(buffer);
+            buffer.append("))");
+            break;
         case FVTag::string:
         case FVTag::sequence:
-            return m_data.obj_p->to_string();
+            buffer.append(m_data.obj_p->to_string());
+            break;
         default:
-            return "(unknown)";
+            buffer.append("(unknown)");
+            break;
         }
     }
+
+    [[nodiscard]] auto FastValue::to_string() const& -> std::string {
+        std::string text;
+
+        append_to(text);
+
+        return text;
+    }
 }
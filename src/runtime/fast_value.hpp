@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <vector>
 #include <string>
 
@@ -20,6 +21,9 @@ namespace Minuet::Runtime {
         dud,
         sequence,
         string,
+        int_array,
+        float_array,
+        dict,
     };
 
     class HeapValueBase {
@@ -36,10 +40,15 @@ namespace Minuet::Runtime {
         virtual auto pop_value(SequenceOpPolicy mode) -> FastValue = 0;
         virtual auto set_value(FastValue arg, std::size_t pos) -> bool = 0;
         virtual auto get_value(std::size_t pos) -> std::optional<FastValue*> = 0;
+        /// NOTE: gives an item by value for objects that don't store their items as FastValues (e.g string characters), or nothing otherwise
+        virtual auto get_packed_value(std::size_t pos) const -> std::optional<FastValue> = 0;
 
         virtual void freeze() noexcept = 0;
-        virtual auto items() noexcept -> std::vector<FastValue>& = 0;
-        virtual auto items() const noexcept -> const std::vector<FastValue>& = 0;
+        /// NOTE: releases excess storage left behind by pops, called by the GC after a sweep. `item_refs` holds every item reference the GC found, sorted by the item each refers to, and any into this object must follow items that move or become duds if their items were popped.
+        virtual void trim_storage(std::span<FastValue*> item_refs) = 0;
+        /// NOTE: views only the live items, in order
+        virtual auto items() noexcept -> std::span<FastValue> = 0;
+        virtual auto items() const noexcept -> std::span<const FastValue> = 0;
         virtual auto clone() -> std::unique_ptr<HeapValueBase> = 0;
 
         virtual auto as_fast_value() noexcept -> FastValue = 0;
@@ -117,6 +126,14 @@ namespace Minuet::Runtime {
         [[nodiscard]] auto to_scalar() noexcept -> std::optional<int>;
         [[nodiscard]] auto to_scalar() const noexcept -> std::optional<int>;
         [[nodiscard]] auto to_object_ptr() noexcept -> HeapValuePtr;
+        [[nodiscard]] auto to_object_ptr() const noexcept -> const HeapValueBase*;
+        /// NOTE: gives the item a `val_ref` refers to, or `nullptr` for any other value
+        [[nodiscard]] auto to_ref_ptr() const noexcept -> FastValue*;
+        /// NOTE: gives a `flt64` or an `int32` widened to a double
+        [[nodiscard]] auto to_real() const noexcept -> std::optional<double>;
+
+        /// NOTE: follows a `val_ref` to the value it references, or gives this value otherwise
+        [[nodiscard]] auto deref() const noexcept -> const FastValue&;
 
         [[nodiscard]] constexpr auto is_none() const& -> bool {
             return m_tag == FVTag::dud;
@@ -157,6 +174,9 @@ namespace Minuet::Runtime {
         [[nodiscard]] auto operator<=(const FastValue& arg) const& -> bool;
         [[nodiscard]] auto operator>=(const FastValue& arg) const& -> bool;
 
+        /// @brief Appends this value's text to `buffer`, formatting numbers in place by `std::to_chars` (shortest round-trip for floats).
+        void append_to(std::string& buffer) const&;
+
         [[nodiscard]] auto to_string() const& -> std::string;
     };
 }
@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <array>
+#include <format>
+#include <limits>
+#include <print>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "runtime/heap_snapshot.hpp"
+
+namespace Minuet::Runtime {
+    static constexpr std::array<std::string_view, 6> object_tag_names = {
+        "dud",
+        "sequence",
+        "string",
+        "int_array",
+        "float_array",
+        "dict",
+    };
+
+    /// NOTE: marks an unvisited node or an unknown dominator while computing the dominator tree.
+    static constexpr auto no_node = std::numeric_limits<std::size_t>::max();
+
+    auto object_tag_name(ObjectTag tag) -> std::string_view {
+        return object_tag_names[static_cast<std::size_t>(tag)];
+    }
+
+    HeapSnapshot::HeapSnapshot(const HeapStorage& heap, const std::vector<HeapValuePtr>& roots)
+    : m_entries {}, m_overhead {heap.get_overhead()}, m_live_bytes {0UL}, m_garbage_bytes {0UL} {
+        const auto& heap_cells = heap.get_objects();
+        std::unordered_map<HeapValuePtr, std::size_t> entry_ids;
+
+        for (std::size_t cell_id = 0; cell_id < heap_cells.size(); ++cell_id) {
+            if (const auto& heap_cell = heap_cells[cell_id]; heap_cell) {
+                entry_ids.emplace(heap_cell.get(), m_entries.size());
+                m_entries.emplace_back(HeapSnapshotEntry {
+                    .referrers = {},
+                    .idom = {},
+                    .id = cell_id,
+                    .score = heap_cell->get_memory_score(),
+                    .retained = 0UL,
+                    .size = heap_cell->get_size(),
+                    .tag = heap_cell->get_tag(),
+                    .reachable = false,
+                    .preloaded = cell_id < heap.get_preload_count(),
+                });
+            }
+        }
+
+        /// 1. Gather the outgoing references of each object: only sequences and dicts can hold references to other objects.
+        std::vector<std::vector<std::size_t>> successors (m_entries.size());
+
+        for (auto& entry : m_entries) {
+            const auto& heap_cell = heap_cells[entry.id];
+
+            if (entry.tag != ObjectTag::sequence && entry.tag != ObjectTag::dict) {
+                continue;
+            }
+
+            const auto from_entry = entry_ids.at(heap_cell.get());
+
+            for (auto item_value : heap_cell->items()) {
+                if (auto to_entry_it = entry_ids.find(item_value.to_object_ptr()); to_entry_it != entry_ids.end()) {
+                    successors[from_entry].push_back(to_entry_it->second);
+                    m_entries[to_entry_it->second].referrers.push_back(entry.id);
+                }
+            }
+        }
+
+        for (auto& entry : m_entries) {
+            std::ranges::sort(entry.referrers);
+            const auto [dupes_begin, dupes_end] = std::ranges::unique(entry.referrers);
+            entry.referrers.erase(dupes_begin, dupes_end);
+        }
+
+        /// 2. Only references to objects still in the heap are roots, besides preloaded literals which are never collected.
+        std::vector<std::size_t> root_entries;
+
+        for (std::size_t entry_pos = 0; entry_pos < m_entries.size(); ++entry_pos) {
+            if (m_entries[entry_pos].preloaded) {
+                root_entries.push_back(entry_pos);
+            }
+        }
+
+        for (const auto root_p : roots) {
+            if (auto root_entry_it = entry_ids.find(root_p); root_entry_it != entry_ids.end()) {
+                root_entries.push_back(root_entry_it->second);
+            }
+        }
+
+        std::ranges::sort(root_entries);
+        const auto [dupes_begin, dupes_end] = std::ranges::unique(root_entries);
+        root_entries.erase(dupes_begin, dupes_end);
+
+        compute_dominators(successors, root_entries);
+
+        for (const auto& entry : m_entries) {
+            if (entry.reachable) {
+                m_live_bytes += entry.score;
+            } else {
+                m_garbage_bytes += entry.score;
+            }
+        }
+    }
+
+    /**
+     * @brief Finds reachable objects and their immediate dominators by the Cooper-Harvey-Kennedy algorithm, using a virtual node above all roots. Retained sizes are then summed bottom-up over the dominator tree.
+     *
+     * @param successors
+     * @param root_entries
+     */
+    void HeapSnapshot::compute_dominators(const std::vector<std::vector<std::size_t>>& successors, const std::vector<std::size_t>& root_entries) {
+        const auto virtual_root = m_entries.size();
+        const auto node_count = m_entries.size() + 1;
+
+        auto node_successors = [&](std::size_t node) -> const std::vector<std::size_t>& {
+            return (node == virtual_root) ? root_entries : successors[node];
+        };
+
+        /// 1. Number the reachable nodes in DFS post-order, without recursion since object graphs can be deep.
+        std::vector<std::size_t> post_order_ids (node_count, no_node);
+        std::vector<std::size_t> post_order;
+        std::vector<bool> visited (node_count, false);
+        std::vector<std::pair<std::size_t, std::size_t>> dfs_stack;
+
+        visited[virtual_root] = true;
+        dfs_stack.emplace_back(virtual_root, 0UL);
+
+        while (!dfs_stack.empty()) {
+            auto& [node, next_succ_pos] = dfs_stack.back();
+            const auto& node_succs = node_successors(node);
+
+            if (next_succ_pos < node_succs.size()) {
+                const auto succ = node_succs[next_succ_pos++];
+
+                if (!visited[succ]) {
+                    visited[succ] = true;
+                    dfs_stack.emplace_back(succ, 0UL);
+                }
+
+                continue;
+            }
+
+            post_order_ids[node] = post_order.size();
+            post_order.push_back(node);
+            dfs_stack.pop_back();
+        }
+
+        std::vector<std::vector<std::size_t>> predecessors (node_count);
+
+        for (const auto node : post_order) {
+            for (const auto succ : node_successors(node)) {
+                predecessors[succ].push_back(node);
+            }
+        }
+
+        /// 2. Iterate in reverse post-order until the immediate dominators settle.
+        std::vector<std::size_t> idoms (node_count, no_node);
+        idoms[virtual_root] = virtual_root;
+
+        auto intersect = [&](std::size_t lhs, std::size_t rhs) noexcept -> std::size_t {
+            while (lhs != rhs) {
+                while (post_order_ids[lhs] < post_order_ids[rhs]) {
+                    lhs = idoms[lhs];
+                }
+
+                while (post_order_ids[rhs] < post_order_ids[lhs]) {
+                    rhs = idoms[rhs];
+                }
+            }
+
+            return lhs;
+        };
+
+        for (auto changed = true; changed;) {
+            changed = false;
+
+            for (auto node_it = post_order.rbegin(); node_it != post_order.rend(); ++node_it) {
+                const auto node = *node_it;
+
+                if (node == virtual_root) {
+                    continue;
+                }
+
+                auto next_idom = no_node;
+
+                for (const auto pred : predecessors[node]) {
+                    if (idoms[pred] == no_node) {
+                        continue;
+                    }
+
+                    next_idom = (next_idom == no_node) ? pred : intersect(pred, next_idom);
+                }
+
+                if (idoms[node] != next_idom) {
+                    idoms[node] = next_idom;
+                    changed = true;
+                }
+            }
+        }
+
+        /// 3. A dominator always comes after the nodes it dominates in post-order, so one pass sums up the retained sizes.
+        for (auto& entry : m_entries) {
+            entry.retained = entry.score;
+        }
+
+        for (const auto node : post_order) {
+            if (node == virtual_root) {
+                continue;
+            }
+
+            auto& entry = m_entries[node];
+
+            entry.reachable = true;
+
+            if (const auto idom = idoms[node]; idom != virtual_root) {
+                entry.idom = m_entries[idom].id;
+                m_entries[idom].retained += entry.retained;
+            }
+        }
+    }
+
+    void HeapSnapshot::write_json(std::ostream& out) const {
+        std::string json_text = std::format(
+            R"({{"overhead":{},"live_bytes":{},"garbage_bytes":{},"objects":[)",
+            m_overhead,
+            m_live_bytes,
+            m_garbage_bytes
+        );
+
+        for (auto entry_it = m_entries.begin(); entry_it != m_entries.end(); ++entry_it) {
+            const auto& [referrers, idom, id, score, retained, size, tag, reachable, preloaded] = *entry_it;
+
+            if (entry_it != m_entries.begin()) {
+                json_text += ',';
+            }
+
+            json_text += std::format(
+                R"({{"id":{},"tag":"{}","size":{},"score":{},"retained":{},"reachable":{},"preloaded":{},"idom":{},"referrers":[)",
+                id,
+                object_tag_name(tag),
+                size,
+                score,
+                retained,
+                reachable,
+                preloaded,
+                (idom) ? std::to_string(idom.value()) : std::string {"null"}
+            );
+
+            for (auto referrer_it = referrers.begin(); referrer_it != referrers.end(); ++referrer_it) {
+                if (referrer_it != referrers.begin()) {
+                    json_text += ',';
+                }
+
+                json_text += std::to_string(*referrer_it);
+            }
+
+            json_text += "]}";
+        }
+
+        json_text += "]}";
+
+        std::println(out, "{}", json_text);
+    }
+}
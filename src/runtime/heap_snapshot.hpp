@@ -0,0 +1,48 @@
+#ifndef MINUET_RUNTIME_HEAP_SNAPSHOT_HPP
+#define MINUET_RUNTIME_HEAP_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "runtime/fast_value.hpp"
+#include "runtime/heap_storage.hpp"
+
+namespace Minuet::Runtime {
+    [[nodiscard]] auto object_tag_name(ObjectTag tag) -> std::string_view;
+
+    struct HeapSnapshotEntry {
+        std::vector<std::size_t> referrers;  // heap IDs of objects holding a reference to this one
+        std::optional<std::size_t> idom;     // heap ID of the immediate dominator, empty for roots or unreachable objects
+        std::size_t id;
+        std::size_t score;
+        std::size_t retained;                // memory score of everything freed if this object was freed
+        int size;
+        ObjectTag tag;
+        bool reachable;
+        bool preloaded;
+    };
+
+    /**
+     * @brief Captures every object in the VM heap along with its referrers and its retained size. Retained sizes come from the dominator tree of the object graph, where an object dominates another if every path from the roots to that object passes through it.
+     */
+    class HeapSnapshot {
+    public:
+        HeapSnapshot(const HeapStorage& heap, const std::vector<HeapValuePtr>& roots);
+
+        /// @brief Writes the snapshot as one line of JSON, so repeated snapshots of a run can be appended to one file.
+        void write_json(std::ostream& out) const;
+
+    private:
+        void compute_dominators(const std::vector<std::vector<std::size_t>>& successors, const std::vector<std::size_t>& root_entries);
+
+        std::vector<HeapSnapshotEntry> m_entries;
+        std::size_t m_overhead;
+        std::size_t m_live_bytes;
+        std::size_t m_garbage_bytes;
+    };
+}
+
+#endif
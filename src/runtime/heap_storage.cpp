@@ -1,53 +1,86 @@
+#include <algorithm>
 #include <memory>
 #include <queue>
+#include <utility>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 #include "runtime/heap_storage.hpp"
 
 namespace Minuet::Runtime {
     auto HeapStorage::allocate_id() -> std::size_t {
-        std::size_t next_id = 0;
-
         if (!m_hole_list.empty()) {
-            next_id = m_hole_list.front();
+            const auto next_id = m_hole_list.front();
             m_hole_list.pop();
-        } else {
-            next_id = m_next_id;
-            ++m_next_id;
+
+            return next_id;
         }
 
-        return next_id;
-    }
+        /// NOTE: no holes are left, so the object table just grows by a slot.
+        m_objects.emplace_back();
 
-    HeapStorage::HeapStorage()
-    : m_hole_list {}, m_objects {}, m_dud {}, m_overhead {0UL}, m_next_id {0UL} {
-        m_objects.reserve(cm_normal_obj_capacity);
-        m_objects.resize(cm_normal_obj_capacity);
+        return m_objects.size() - 1;
     }
 
-    HeapStorage::HeapStorage(std::vector<std::unique_ptr<HeapValueBase>> preloads)
-    : m_hole_list {}, m_objects {}, m_dud {}, m_overhead {0UL}, m_next_id {0UL} {
-        m_objects.reserve(cm_normal_obj_capacity);
-        m_objects.resize(cm_normal_obj_capacity);
+    HeapStorage::HeapStorage()
+    : HeapStorage {{}, default_config()} {}
 
-        std::size_t preload_n = 0;
+    HeapStorage::HeapStorage(std::vector<std::unique_ptr<HeapValueBase>> preloads, HeapConfig config)
+    : m_hole_list {}, m_objects {}, m_dud {}, m_interned {}, m_overhead {0UL}, m_gc_threshold {std::max(config.gc_threshold, cm_min_gc_threshold)}, m_preload_count {preloads.size()}, m_growth_factor {std::max(config.growth_factor, 1.0)}, m_ripe {false} {
+        m_objects.reserve(preloads.size());
 
         for (auto& preloading_obj : preloads) {
-            m_objects[preload_n] = std::move(preloading_obj);
-            ++preload_n;
+            m_overhead += preloading_obj->get_memory_score();
+
+            /// NOTE: Only the first of any duplicate literals becomes canonical.
+            if (preloading_obj->get_tag() == ObjectTag::string) {
+                auto literal_p = static_cast<StringValue*>(preloading_obj.get());
+
+                if (m_interned.try_emplace(literal_p->view(), literal_p).second) {
+                    literal_p->mark_interned();
+                }
+            }
+
+            m_objects.emplace_back(std::move(preloading_obj));
         }
 
-        m_overhead = preload_n * cm_normal_obj_overhead;
-        m_next_id = preload_n; 
+        m_ripe = m_overhead >= m_gc_threshold;
     }
 
-    auto HeapStorage::is_ripe() const& noexcept -> bool {
-        return m_overhead >= cm_normal_gc_threshold;
+    auto HeapStorage::get_overhead() const& noexcept -> std::size_t {
+        return m_overhead;
+    }
+
+    auto HeapStorage::get_preload_count() const& noexcept -> std::size_t {
+        return m_preload_count;
+    }
+
+    void HeapStorage::track_resize(std::size_t old_score, std::size_t new_score) noexcept {
+        if (new_score >= old_score) {
+            m_overhead += new_score - old_score;
+        } else {
+            m_overhead -= std::min(m_overhead, old_score - new_score);
+        }
+
+        m_ripe = m_overhead >= m_gc_threshold;
     }
 
     [[nodiscard]] auto HeapStorage::try_destroy_value(std::size_t id) noexcept -> bool {
+        if (id < m_preload_count || id >= m_objects.size()) {
+            return false;
+        }
+
         if (auto& object_cell = m_objects[id]; object_cell) {
+            if (object_cell->get_tag() == ObjectTag::string) {
+                if (const auto dead_str_p = static_cast<const StringValue*>(object_cell.get()); dead_str_p->is_interned()) {
+                    m_interned.erase(dead_str_p->view());
+                }
+            }
+
+            m_overhead -= std::min(m_overhead, object_cell->get_memory_score());
             object_cell = {};
-            m_overhead -= cm_normal_obj_overhead;
             m_hole_list.emplace(id);
 
             return true;
@@ -56,7 +89,78 @@ namespace Minuet::Runtime {
         return false;
     }
 
+    auto HeapStorage::intern_string(std::string_view text) -> StringValue* {
+        if (auto interned_it = m_interned.find(text); interned_it != m_interned.end()) {
+            return interned_it->second;
+        }
+
+        /// NOTE: The interned copy owns its bytes, so its key can't be invalidated by a mutation of whichever string it came from.
+        auto interned_p = static_cast<StringValue*>(try_create_value<StringValue>(std::string {text}).get());
+
+        if (!interned_p) {
+            return nullptr;
+        }
+
+        interned_p->mark_interned();
+        m_interned.emplace(interned_p->view(), interned_p);
+
+        return interned_p;
+    }
+
+    void HeapStorage::adapt_threshold() noexcept {
+        std::size_t live_bytes = 0;
+
+        for (const auto& object_cell : m_objects) {
+            if (object_cell) {
+                live_bytes += object_cell->get_memory_score();
+            }
+        }
+
+        const auto next_threshold = static_cast<std::size_t>(static_cast<double>(live_bytes) * m_growth_factor);
+
+        m_overhead = live_bytes;
+        m_gc_threshold = std::max(next_threshold, cm_min_gc_threshold);
+        m_ripe = false; // NOTE: a collection just finished, so the next one waits for more allocation.
+    }
+
+    auto HeapStorage::try_compact() -> bool {
+        const auto collectable_slots = m_objects.size() - m_preload_count;
+
+        if (m_hole_list.empty() || m_hole_list.size() * 2 < collectable_slots) {
+            return false;
+        }
+
+        auto live_end = m_preload_count;
+
+        for (auto cell_id = m_preload_count; cell_id < m_objects.size(); ++cell_id) {
+            if (!m_objects[cell_id]) {
+                continue;
+            }
+
+            if (cell_id != live_end) {
+                m_objects[live_end] = std::move(m_objects[cell_id]);
+            }
+
+            ++live_end;
+        }
+
+        m_objects.resize(live_end);
+        m_objects.shrink_to_fit();
+        m_hole_list = {};
+
+#ifdef __GLIBC__
+        /// NOTE: most of the heap just died, so glibc is asked to hand its free pages back to the OS instead of keeping them cached.
+        malloc_trim(0);
+#endif
+
+        return true;
+    }
+
     auto HeapStorage::get_objects() noexcept -> std::vector<std::unique_ptr<HeapValueBase>>& {
         return m_objects;
     }
+
+    auto HeapStorage::get_objects() const noexcept -> const std::vector<std::unique_ptr<HeapValueBase>>& {
+        return m_objects;
+    }
 }
@@ -5,40 +5,69 @@
 #include <utility>
 #include <memory>
 #include <queue>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "runtime/fast_value.hpp"
+#include "runtime/string_value.hpp"
 
 namespace Minuet::Runtime {
+    /**
+     * @brief Tuning knobs of the VM heap's GC policy. The first collection happens once `gc_threshold` bytes are in use, and every later threshold is `growth_factor` times the live bytes left after the previous collection.
+     */
+    struct HeapConfig {
+        std::size_t gc_threshold;
+        double growth_factor;
+    };
+
     class HeapStorage {
     private:
-        /// NOTE: stores constant for default memory "capacity" of VM heap
-        static constexpr auto cm_normal_max_overhead = 16384UL;
-        static constexpr auto cm_normal_gc_threshold = 8192UL;
-        static constexpr auto cm_normal_obj_overhead = 16UL;
-        static constexpr auto cm_normal_obj_capacity = cm_normal_max_overhead / cm_normal_obj_overhead;
+        /// NOTE: stores defaults for the byte-based GC policy of the VM heap
+        static constexpr auto cm_normal_gc_threshold = 1048576UL;
+        static constexpr auto cm_normal_growth_factor = 2.0;
+        static constexpr auto cm_min_gc_threshold = 16384UL;
 
         /// NOTE: tracks freed object slots in the VM "heap" remaining between live slots
         std::queue<std::size_t> m_hole_list;
 
-        /// NOTE: tracks actual object slots (live / unreachable)
+        /// NOTE: tracks actual object slots (live / unreachable), growing on demand
         std::vector<std::unique_ptr<HeapValueBase>> m_objects;
 
         /// NOTE: holds a null dud for invalid object references
         std::unique_ptr<HeapValueBase> m_dud;
 
-        std::size_t m_overhead;
-        std::size_t m_next_id;
+        /// NOTE: weakly maps string contents to their interned string, keyed by views of the interned bytes. Entries aren't GC roots and get dropped once their string is swept.
+        std::unordered_map<std::string_view, StringValue*> m_interned;
+
+        std::size_t m_overhead;       // bytes currently charged against the heap
+        std::size_t m_gc_threshold;   // bytes at which the next collection is due
+        std::size_t m_preload_count;  // preloaded literals occupy the lowest slots and are never collected
+        double m_growth_factor;
+        bool m_ripe;                  // set once m_overhead reaches m_gc_threshold, so safepoints only test this flag
 
         [[nodiscard]] auto allocate_id() -> std::size_t;
 
     public:
+        [[nodiscard]] static constexpr auto default_config() noexcept -> HeapConfig {
+            return {
+                .gc_threshold = cm_normal_gc_threshold,
+                .growth_factor = cm_normal_growth_factor,
+            };
+        }
+
         /// NOTE: preload "heap literals" from IR & codegen stages here!
         HeapStorage();
 
-        HeapStorage(std::vector<std::unique_ptr<HeapValueBase>> preloads);
+        HeapStorage(std::vector<std::unique_ptr<HeapValueBase>> preloads, HeapConfig config = default_config());
+
+        [[nodiscard]] auto is_ripe() const& noexcept -> bool {
+            return m_ripe;
+        }
+
+        [[nodiscard]] auto get_overhead() const& noexcept -> std::size_t;
 
-        [[nodiscard]] auto is_ripe() const& noexcept -> bool;
+        [[nodiscard]] auto get_preload_count() const& noexcept -> std::size_t;
 
         template <typename ObjectType, typename ... Args> requires (std::is_constructible_v<ObjectType, Args...> && std::is_base_of_v<HeapValueBase, ObjectType>)
         [[nodiscard]] auto try_create_value(Args&& ... args) noexcept (std::is_nothrow_constructible_v<ObjectType, Args...>) -> std::unique_ptr<HeapValueBase>& {
@@ -47,14 +76,37 @@ namespace Minuet::Runtime {
             const auto next_object_id = allocate_id();
 
             m_objects[next_object_id] = std::make_unique<naked_object_type>(std::forward<Args>(args)...);
-            m_overhead += cm_normal_obj_overhead;
+            m_overhead += m_objects[next_object_id]->get_memory_score();
+            m_ripe = m_overhead >= m_gc_threshold;
 
             return m_objects[next_object_id];
         }
 
+        /// @brief Charges or refunds the difference of an object's memory score after it was mutated in place, e.g by a push onto a sequence.
+        void track_resize(std::size_t old_score, std::size_t new_score) noexcept;
+
         [[nodiscard]] auto try_destroy_value(std::size_t id) noexcept -> bool;
 
+        /**
+         * @brief Gets the interned string of some contents, creating a frozen copy of them if there's none yet. Preloaded string literals are interned up front.
+         *
+         * @param text
+         * @return StringValue* The canonical string, or `nullptr` if allocation failed.
+         */
+        [[nodiscard]] auto intern_string(std::string_view text) -> StringValue*;
+
+        /// @brief Recounts the exact live bytes after a sweep and schedules the next collection at `growth_factor` times that amount.
+        void adapt_threshold() noexcept;
+
+        /**
+         * @brief Compacts the object table if at least half of the non-preloaded slots are holes: live objects slide down over the holes so the table can shrink, which shortens every later sweep and live-byte recount. Only the owning pointers move, never the objects or their items, so neither object references nor item references need any fixups. Where glibc is the allocator, its free pages are then returned to the OS.
+         *
+         * @return true if the heap was compacted.
+         */
+        [[nodiscard]] auto try_compact() -> bool;
+
         [[nodiscard]] auto get_objects() noexcept -> std::vector<std::unique_ptr<HeapValueBase>>&;
+        [[nodiscard]] auto get_objects() const noexcept -> const std::vector<std::unique_ptr<HeapValueBase>>&;
     };
 }
 
@@ -0,0 +1,177 @@
+#include <type_traits>
+#include <utility>
+
+#include "runtime/packed_array_value.hpp"
+
+namespace Minuet::Runtime {
+    template <typename Elem>
+    PackedArrayValue<Elem>::PackedArrayValue()
+    : m_elems {}, m_frozen {false} {}
+
+    template <typename Elem>
+    PackedArrayValue<Elem>::PackedArrayValue(std::vector<Elem> elems) noexcept
+    : m_elems (std::move(elems)), m_frozen {false} {}
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::to_elem(const FastValue& arg) noexcept -> std::optional<Elem> {
+        if constexpr (std::is_same_v<Elem, double>) {
+            return arg.to_real();
+        } else {
+            if (arg.tag() != FVTag::int32) {
+                return {};
+            }
+
+            return arg.to_scalar();
+        }
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::elems() noexcept -> std::span<Elem> {
+        return m_elems;
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::elems() const noexcept -> std::span<const Elem> {
+        return m_elems;
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::get_memory_score() const& noexcept -> std::size_t {
+        return sizeof(PackedArrayValue) + m_elems.capacity() * sizeof(Elem);
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::get_tag() const& noexcept -> ObjectTag {
+        return cm_object_tag;
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::get_size() const& noexcept -> int {
+        return static_cast<int>(m_elems.size());
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::is_frozen() const& noexcept -> bool {
+        return m_frozen;
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::push_value(FastValue arg) -> bool {
+        const auto elem_opt = to_elem(arg);
+
+        if (!elem_opt || m_frozen) {
+            return false;
+        }
+
+        m_elems.push_back(elem_opt.value());
+
+        return true;
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::pop_value(SequenceOpPolicy mode) -> FastValue {
+        if (m_elems.empty() || m_frozen) {
+            return {};
+        }
+
+        const auto target_elem = (mode == SequenceOpPolicy::back)
+            ? m_elems.back()
+            : m_elems.front();
+
+        if (mode == SequenceOpPolicy::back) {
+            m_elems.pop_back();
+        } else {
+            m_elems.erase(m_elems.begin());
+        }
+
+        return FastValue {target_elem};
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::set_value(FastValue arg, std::size_t pos) -> bool {
+        const auto elem_opt = to_elem(arg);
+
+        if (!elem_opt || pos >= m_elems.size() || m_frozen) {
+            return false;
+        }
+
+        m_elems[pos] = elem_opt.value();
+
+        return true;
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::get_value([[maybe_unused]] std::size_t pos) -> std::optional<FastValue*> {
+        return {};
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::get_packed_value(std::size_t pos) const -> std::optional<FastValue> {
+        if (pos >= m_elems.size()) {
+            return {};
+        }
+
+        return FastValue {m_elems[pos]};
+    }
+
+    template <typename Elem>
+    void PackedArrayValue<Elem>::freeze() noexcept {
+        m_frozen = true;
+    }
+
+    /// NOTE: Elements are only handed out by value, so no item references can point in here.
+    template <typename Elem>
+    void PackedArrayValue<Elem>::trim_storage([[maybe_unused]] std::span<FastValue*> item_refs) {
+        if (m_elems.capacity() >= cm_min_shrink_capacity && m_elems.size() * 4 <= m_elems.capacity()) {
+            m_elems.shrink_to_fit();
+        }
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::items() noexcept -> std::span<FastValue> {
+        return {};
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::items() const noexcept -> std::span<const FastValue> {
+        return {};
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::clone() -> std::unique_ptr<HeapValueBase> {
+        return std::make_unique<PackedArrayValue>(m_elems);
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::as_fast_value() noexcept -> FastValue {
+        return {this, FVTag::sequence};
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::to_string() const& noexcept -> std::string {
+        std::string text;
+
+        text.push_back((m_frozen) ? '[' : '{');
+
+        for (const auto elem : m_elems) {
+            FastValue {elem}.append_to(text);
+            text.push_back(' ');
+        }
+
+        text.push_back((m_frozen) ? ']' : '}');
+
+        return text;
+    }
+
+    template <typename Elem>
+    auto PackedArrayValue<Elem>::operator==(const HeapValueBase& rhs) const noexcept -> bool {
+        if (rhs.get_tag() != get_tag()) {
+            return false;
+        }
+
+        return m_elems == static_cast<const PackedArrayValue&>(rhs).m_elems;
+    }
+
+    template class PackedArrayValue<int32_t>;
+    template class PackedArrayValue<double>;
+}
@@ -0,0 +1,71 @@
+#ifndef MINUET_RUNTIME_PACKED_ARRAY_VALUE_HPP
+#define MINUET_RUNTIME_PACKED_ARRAY_VALUE_HPP
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "runtime/fast_value.hpp"
+
+namespace Minuet::Runtime {
+    /**
+     * @brief Contains numbers of one type as raw contiguous elements, without a FastValue tag per item. These never reference other objects, so the GC treats them as leaves.
+     *
+     * @tparam Elem Either `int32_t` for an `int_array` or `double` for a `float_array`.
+     */
+    template <typename Elem>
+    class PackedArrayValue : public HeapValueBase {
+    private:
+        static constexpr auto cm_min_shrink_capacity = 16UL;
+
+        std::vector<Elem> m_elems;
+        bool m_frozen;
+
+    public:
+        static constexpr auto cm_object_tag = std::is_same_v<Elem, double> ? ObjectTag::float_array : ObjectTag::int_array;
+
+        PackedArrayValue();
+        explicit PackedArrayValue(std::vector<Elem> elems) noexcept;
+
+        /// @brief Converts a FastValue to an element: `int_array` only takes `int32` values, while `float_array` also widens them.
+        [[nodiscard]] static auto to_elem(const FastValue& arg) noexcept -> std::optional<Elem>;
+
+        [[nodiscard]] auto elems() noexcept -> std::span<Elem>;
+        [[nodiscard]] auto elems() const noexcept -> std::span<const Elem>;
+
+        [[nodiscard]] auto get_memory_score() const& noexcept -> std::size_t override;
+        [[nodiscard]] auto get_tag() const& noexcept -> ObjectTag override;
+        [[nodiscard]] auto get_size() const& noexcept -> int override;
+        [[nodiscard]] auto is_frozen() const& noexcept -> bool override;
+
+        [[nodiscard]] auto push_value(FastValue arg) -> bool override;
+        [[nodiscard]] auto pop_value(SequenceOpPolicy mode) -> FastValue override;
+        [[nodiscard]] auto set_value(FastValue arg, std::size_t pos) -> bool override;
+        /// NOTE: always empty since elements aren't stored as FastValues, see `get_packed_value()`
+        [[nodiscard]] auto get_value(std::size_t pos) -> std::optional<FastValue*> override;
+        [[nodiscard]] auto get_packed_value(std::size_t pos) const -> std::optional<FastValue> override;
+
+        void freeze() noexcept override;
+        void trim_storage(std::span<FastValue*> item_refs) override;
+        /// NOTE: packed arrays have no FastValue items, so these give an empty sequence
+        [[nodiscard]] auto items() noexcept -> std::span<FastValue> override;
+        [[nodiscard]] auto items() const noexcept -> std::span<const FastValue> override;
+        [[nodiscard]] auto clone() -> std::unique_ptr<HeapValueBase> override;
+
+        [[nodiscard]] auto as_fast_value() noexcept -> FastValue override;
+        [[nodiscard]] auto to_string() const& noexcept -> std::string override;
+
+        [[nodiscard]] auto operator==(const HeapValueBase& rhs) const noexcept -> bool override;
+    };
+
+    extern template class PackedArrayValue<int32_t>;
+    extern template class PackedArrayValue<double>;
+
+    using IntArrayValue = PackedArrayValue<int32_t>;
+    using FloatArrayValue = PackedArrayValue<double>;
+}
+
+#endif
@@ -1,23 +1,25 @@
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <utility>
-#include <sstream>
 
 #include "runtime/sequence_value.hpp"
 
 namespace Minuet::Runtime {
     SequenceValue::SequenceValue()
-    : m_items {}, m_length {0}, m_frozen {false} {}
+    : m_items {}, m_head {0UL}, m_length {0}, m_frozen {false} {}
 
-    auto SequenceValue::items() noexcept -> std::vector<FastValue>& {
-        return m_items;
+    auto SequenceValue::items() noexcept -> std::span<FastValue> {
+        return std::span {m_items}.subspan(m_head);
     }
 
-    auto SequenceValue::items() const noexcept -> const std::vector<FastValue>& {
-        return m_items;
+    auto SequenceValue::items() const noexcept -> std::span<const FastValue> {
+        return std::span {m_items}.subspan(m_head);
     }
 
 
     auto SequenceValue::get_memory_score() const& noexcept -> std::size_t {
-        return m_length * cm_fast_val_memsize;
+        return sizeof(SequenceValue) + m_items.capacity() * cm_fast_val_memsize;
     }
 
     auto SequenceValue::get_tag() const& noexcept -> ObjectTag {
@@ -40,47 +42,94 @@ namespace Minuet::Runtime {
     }
 
     auto SequenceValue::pop_value(SequenceOpPolicy mode) -> FastValue {
-        if (m_items.empty() || m_frozen) {
+        if (m_length == 0 || m_frozen) {
             return {};
         }
 
         auto target_value = (mode == SequenceOpPolicy::back)
             ? m_items.back()
-            : m_items.front();
+            : m_items[m_head];
 
         if (mode == SequenceOpPolicy::back) {
             m_items.pop_back();
         } else {
-            m_items.erase(m_items.begin());
+            /// NOTE: The popped slot is cleared so that the GC can't find a stale reference there.
+            m_items[m_head] = {};
+            ++m_head;
         }
 
         --m_length;
 
+        /// NOTE: Clearing never reallocates, so item references still point into this sequence's storage.
+        if (m_length == 0) {
+            m_items.clear();
+            m_head = 0;
+        }
+
         return target_value;
     }
 
     auto SequenceValue::set_value(FastValue arg, std::size_t pos) -> bool {
-        m_items[pos] = std::move(arg);
+        if (pos >= static_cast<std::size_t>(m_length) || m_frozen) {
+            return false;
+        }
+
+        m_items[m_head + pos] = std::move(arg);
 
         return true;
     }
 
     auto SequenceValue::get_value(std::size_t pos) -> std::optional<FastValue*> {
-        if (pos < m_items.size()) {
-            return &m_items[pos];
+        if (pos < static_cast<std::size_t>(m_length)) {
+            return &m_items[m_head + pos];
         }
 
         return {};
     }
 
+    auto SequenceValue::get_packed_value([[maybe_unused]] std::size_t pos) const -> std::optional<FastValue> {
+        return {};
+    }
+
     void SequenceValue::freeze() noexcept {
         m_frozen = true;
     }
 
+    /// NOTE: Only trims sequences whose dead prefix is at least half of their items or which use under a quarter of their capacity, so that pushes right after a collection don't reallocate at once. Each erased dead item was popped at O(1) cost beforehand, which keeps front pops amortized O(1). A sequence holding item references itself is left as-is, since the GC found those references at their current addresses.
+    void SequenceValue::trim_storage(std::span<FastValue*> item_refs) {
+        const auto old_capacity = m_items.capacity();
+        const auto prefix_heavy = m_head >= cm_min_shrink_capacity && m_head * 2 >= m_items.size();
+        const auto mostly_unused = old_capacity >= cm_min_shrink_capacity && static_cast<std::size_t>(m_length) * 4 <= old_capacity;
+
+        if (!prefix_heavy && !mostly_unused) {
+            return;
+        }
+
+        if (std::ranges::any_of(m_items, [](const FastValue& item) { return item.tag() == FVTag::val_ref; })) {
+            return;
+        }
+
+        const auto old_items_p = m_items.data();
+        const auto ref_target = [](const FastValue* ref_holder_p) { return ref_holder_p->to_ref_ptr(); };
+        std::vector<FastValue> live_items (m_items.begin() + static_cast<std::ptrdiff_t>(m_head), m_items.end());
+
+        /// NOTE: The references into the old storage form one run since they're sorted by target. A reference to a popped slot is stale, so it becomes a dud.
+        for (auto ref_it = std::ranges::lower_bound(item_refs, old_items_p, std::less {}, ref_target); ref_it != item_refs.end() && std::less {}(ref_target(*ref_it), old_items_p + old_capacity); ++ref_it) {
+            const auto old_slot = static_cast<std::size_t>(ref_target(*ref_it) - old_items_p);
+
+            **ref_it = (old_slot >= m_head && old_slot < m_items.size())
+                ? FastValue {&live_items[old_slot - m_head]}
+                : FastValue {};
+        }
+
+        m_items = std::move(live_items);
+        m_head = 0;
+    }
+
     auto SequenceValue::clone() -> std::unique_ptr<HeapValueBase> {
         SequenceValue temp;
 
-        for (const auto& old_item : m_items) {
+        for (const auto& old_item : items()) {
             if (!temp.push_value(old_item)) {
                 return {};
             }
@@ -99,20 +148,21 @@ namespace Minuet::Runtime {
             char d_close;
         };
 
-        std::ostringstream sout;
+        std::string text;
         const auto [delim_open, delim_close] = (m_frozen)
             ? Delims { .d_open = '[', .d_close = ']' }
             : Delims { .d_open = '{', .d_close = '}' };
 
-        sout << delim_open;
+        text.push_back(delim_open);
 
-        for (const auto& item_v : m_items) {
-            sout << item_v.to_string() << ' ';
+        for (const auto& item_v : items()) {
+            item_v.append_to(text);
+            text.push_back(' ');
         }
 
-        sout << delim_close;
+        text.push_back(delim_close);
 
-        return sout.str();
+        return text;
     }
 
     [[nodiscard]] auto SequenceValue::operator==(const HeapValueBase& rhs) const noexcept -> bool {
@@ -123,7 +173,7 @@ namespace Minuet::Runtime {
         }
 
         for (auto item_idx = 0; item_idx < self_size; ++item_idx) {
-            if (const auto& rhs_item = rhs.items()[item_idx]; m_items[item_idx] != rhs_item) {
+            if (const auto& rhs_item = rhs.items()[item_idx]; items()[item_idx] != rhs_item) {
                 return false;
             }
         }
@@ -2,6 +2,7 @@
 #define MINUET_RUNTIME_SEQUENCE_VALUE_HPP
 
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -9,21 +10,23 @@
 
 namespace Minuet::Runtime {
     /**
-     * @brief Contains an index to FastValue map to simulate an array.
+     * @brief Contains an index to FastValue map to simulate an array. Items live in a vector past a head offset, so popping from either end is O(1): a front pop just clears its slot and advances the head. The GC erases the dead prefix later, moving any item references along.
      */
     class SequenceValue : public HeapValueBase {
     private:
-        static constexpr auto cm_fast_val_memsize = 16UL;
+        static constexpr auto cm_fast_val_memsize = sizeof(FastValue);
+        static constexpr auto cm_min_shrink_capacity = 16UL;
 
         std::vector<FastValue> m_items;
+        std::size_t m_head;  // position of the first live item in m_items
         int m_length;
         bool m_frozen;
 
     public:
         SequenceValue();
 
-        [[nodiscard]] auto items() noexcept -> std::vector<FastValue>& override;
-        auto items() const noexcept -> const std::vector<FastValue>& override;
+        [[nodiscard]] auto items() noexcept -> std::span<FastValue> override;
+        auto items() const noexcept -> std::span<const FastValue> override;
 
         [[nodiscard]] auto get_memory_score() const& noexcept -> std::size_t override;
         [[nodiscard]] auto get_tag() const& noexcept -> ObjectTag override;
@@ -35,7 +38,15 @@ namespace Minuet::Runtime {
         [[nodiscard]] auto set_value(FastValue arg, std::size_t pos) -> bool override;
         [[nodiscard]] auto get_value(std::size_t pos) -> std::optional<FastValue*> override;
 
+        /// NOTE: skips the bounds check of `get_value`, so `pos` must already be proven below `get_size()`.
+        [[nodiscard]] auto get_value_unchecked(std::size_t pos) noexcept -> FastValue* {
+            return &m_items[m_head + pos];
+        }
+
+        [[nodiscard]] auto get_packed_value(std::size_t pos) const -> std::optional<FastValue> override;
+
         void freeze() noexcept override;
+        void trim_storage(std::span<FastValue*> item_refs) override;
         [[nodiscard]] auto clone() -> std::unique_ptr<HeapValueBase> override;
 
         [[nodiscard]] auto as_fast_value() noexcept -> FastValue override;
@@ -1,22 +1,65 @@
+#include <functional>
 #include <utility>
-#include <sstream>
 
 #include "runtime/string_value.hpp"
 
 namespace Minuet::Runtime {
+    /// NOTE: char literals can be converted to their underlying integer BUT it must be masked against 127 for a valid ASCII representation.
+    [[nodiscard]] static auto to_ascii_char(const FastValue& arg) noexcept -> char {
+        return static_cast<char>(arg.to_scalar().value_or(0) & 0x7f);
+    }
+
     StringValue::StringValue()
-    : m_items {}, m_length {0} {}
+    : m_text_p {std::make_shared<TextBuffer>(std::string {}, this)}, m_offset {0UL}, m_length {0UL}, m_hash {0UL}, m_hash_ok {false}, m_frozen {false}, m_interned {false} {}
 
     StringValue::StringValue(std::string s) noexcept
-    : m_items {}, m_length {0} {
-        for (const auto c : s) {
-            m_items.emplace_back(c);
-            ++m_length;
+    : m_text_p {std::make_shared<TextBuffer>(std::move(s), this)}, m_offset {0UL}, m_length {m_text_p->text.size()}, m_hash {0UL}, m_hash_ok {false}, m_frozen {false}, m_interned {false} {}
+
+    StringValue::StringValue(const StringValue& other) noexcept
+    : m_text_p {other.m_text_p}, m_offset {other.m_offset}, m_length {other.m_length}, m_hash {other.m_hash}, m_hash_ok {other.m_hash_ok}, m_frozen {false}, m_interned {false} {}
+
+    StringValue::StringValue(const StringValue& parent, std::size_t offset, std::size_t length) noexcept
+    : m_text_p {parent.m_text_p}, m_offset {parent.m_offset + offset}, m_length {length}, m_hash {0UL}, m_hash_ok {false}, m_frozen {false}, m_interned {false} {}
+
+    StringValue::~StringValue() {
+        if (m_text_p && m_text_p->owner_p == this) {
+            m_text_p->owner_p = nullptr;
+        }
+    }
+
+    auto StringValue::is_slice() const noexcept -> bool {
+        return m_offset != 0 || m_length != m_text_p->text.size();
+    }
+
+    void StringValue::detach_text(std::size_t extra_len) {
+        if (m_text_p.use_count() > 1 || is_slice()) {
+            auto own_text_p = std::make_shared<TextBuffer>(std::string {}, this);
+
+            own_text_p->text.reserve(m_length + extra_len);
+            own_text_p->text.append(view());
+
+            if (m_text_p->owner_p == this) {
+                m_text_p->owner_p = nullptr;
+            }
+
+            m_text_p = std::move(own_text_p);
+            m_offset = 0;
         }
+
+        m_hash_ok = false;
     }
 
+    /// NOTE: A fresh copy from `make_str` or a slice costs just its header while the string it came from still lives. Claiming orphaned characters here means the heap's live-byte recount after each sweep charges every buffer exactly once.
     auto StringValue::get_memory_score() const& noexcept -> std::size_t {
-        return cm_fast_val_memsize * m_items.size();
+        if (!m_text_p->owner_p) {
+            m_text_p->owner_p = this;
+        }
+
+        if (m_text_p->owner_p != this) {
+            return sizeof(StringValue);
+        }
+
+        return sizeof(StringValue) + m_text_p->text.capacity();
     }
 
     auto StringValue::get_tag() const& noexcept -> ObjectTag {
@@ -24,75 +67,94 @@ namespace Minuet::Runtime {
     }
 
     auto StringValue::get_size() const& noexcept -> int {
-        return m_length;
+        return static_cast<int>(m_length);
     }
 
     auto StringValue::is_frozen() const& noexcept -> bool {
-        return false;
+        return m_frozen;
     }
 
     // auto StringValue::size() const& noexcept -> int;
 
-    auto StringValue::push_value([[maybe_unused]] FastValue arg) -> bool {
-        // NOTE: char literals can be converted to their underlying integer BUT it must be masked against 127 for a valid ASCII representation.
-        const char arg_ascii_repr = static_cast<char>(arg.to_scalar().value_or(0) & 0x7f);
+    auto StringValue::push_value(FastValue arg) -> bool {
+        if (m_frozen) {
+            return false;
+        }
 
-        m_items.emplace_back(arg_ascii_repr);
-        ++m_length;
+        detach_text(1);
+        m_text_p->text.push_back(to_ascii_char(arg));
+        m_length = m_text_p->text.size();
 
         return true;
     }
 
     auto StringValue::pop_value(SequenceOpPolicy mode) -> FastValue {
-        if (m_items.empty()) {
+        if (m_length == 0 || m_frozen) {
             return {};
         }
 
-        auto target_value = (mode == SequenceOpPolicy::back)
-            ? m_items.back()
-            : m_items.front();
+        detach_text();
+
+        auto& text_ref = m_text_p->text;
+        const auto target_char = (mode == SequenceOpPolicy::back)
+            ? text_ref.back()
+            : text_ref.front();
 
         if (mode == SequenceOpPolicy::back) {
-            m_items.pop_back();
+            text_ref.pop_back();
         } else {
-            m_items.erase(m_items.begin());
+            text_ref.erase(text_ref.begin());
         }
 
-        --m_length;
+        m_length = text_ref.size();
 
-        return target_value;
+        return {target_char};
     }
 
     auto StringValue::set_value(FastValue arg, std::size_t pos) -> bool {
-        if (pos >= m_items.size()) {
+        if (pos >= m_length || m_frozen) {
             return false;
         }
 
-        m_items[pos] = std::move(arg);
+        detach_text();
+        m_text_p->text[pos] = to_ascii_char(arg);
 
         return true;
     }
 
-    auto StringValue::get_value(std::size_t pos) -> std::optional<FastValue*> {
-        if (pos >= m_items.size()) {
-            return {};
-        }
+    auto StringValue::get_value([[maybe_unused]] std::size_t pos) -> std::optional<FastValue*> {
+        return {};
+    }
+
+    auto StringValue::get_packed_value(std::size_t pos) const -> std::optional<FastValue> {
+        return char_at(pos);
+    }
 
-        return &m_items[pos];
+    void StringValue::freeze() noexcept {
+        m_frozen = true;
     }
 
-    void StringValue::freeze() noexcept {}
+    /// NOTE: Only trims characters which this string has to itself, so a buffer shared with copies or slices, or viewed by the intern table, never moves.
+    void StringValue::trim_storage([[maybe_unused]] std::span<FastValue*> item_refs) {
+        if (m_frozen || m_text_p.use_count() > 1 || is_slice()) {
+            return;
+        }
+
+        if (m_text_p->text.capacity() >= cm_min_shrink_capacity && m_length * 4 <= m_text_p->text.capacity()) {
+            m_text_p->text.shrink_to_fit();
+        }
+    }
 
-    auto StringValue::items() noexcept -> std::vector<FastValue>& {
-        return m_items;
+    auto StringValue::items() noexcept -> std::span<FastValue> {
+        return {};
     }
 
-    auto StringValue::items() const noexcept -> const std::vector<FastValue>& {
-        return m_items;
+    auto StringValue::items() const noexcept -> std::span<const FastValue> {
+        return {};
     }
 
     auto StringValue::clone() -> std::unique_ptr<HeapValueBase> {
-        return std::make_unique<StringValue>(to_string());
+        return std::make_unique<StringValue>(std::string {view()});
     }
 
     auto StringValue::as_fast_value() noexcept -> FastValue {
@@ -100,28 +162,77 @@ namespace Minuet::Runtime {
     }
 
     auto StringValue::to_string() const& noexcept -> std::string {
-        std::ostringstream sout;
+        return std::string {view()};
+    }
 
-        for (const auto& c_item : m_items) {
-            sout << static_cast<char>(c_item.to_scalar().value_or(0) & 0x7f);
+    auto StringValue::operator==(const HeapValueBase& rhs) const noexcept -> bool {
+        if (rhs.get_tag() != ObjectTag::string) {
+            return false;
         }
 
-        return sout.str();
-    }
+        const auto& rhs_str = static_cast<const StringValue&>(rhs);
 
-    auto StringValue::operator==(const HeapValueBase& rhs) const noexcept -> bool {
-        const auto self_len = get_size();
-        
-        if (get_tag() != rhs.get_tag() || self_len != rhs.get_size()) {
+        if (m_text_p == rhs_str.m_text_p && m_offset == rhs_str.m_offset && m_length == rhs_str.m_length) {
+            return true;
+        }
+
+        if (m_interned && rhs_str.m_interned) {
+            return this == &rhs_str;
+        }
+
+        if (m_hash_ok && rhs_str.m_hash_ok && m_hash != rhs_str.m_hash) {
             return false;
         }
 
-        for (auto item_idx = 0; item_idx < self_len; ++item_idx) {
-            if (const auto& rhs_item = rhs.items()[item_idx]; m_items[item_idx] != rhs_item) {
-                return false;
-            }
+        return view() == rhs_str.view();
+    }
+
+    auto StringValue::view() const noexcept -> std::string_view {
+        return std::string_view {m_text_p->text}.substr(m_offset, m_length);
+    }
+
+    auto StringValue::char_at(std::size_t pos) const noexcept -> std::optional<FastValue> {
+        if (pos >= m_length) {
+            return {};
         }
 
-        return true;
+        return FastValue {m_text_p->text[m_offset + pos]};
+    }
+
+    auto StringValue::get_hash() const noexcept -> std::size_t {
+        if (!m_hash_ok) {
+            m_hash = std::hash<std::string_view> {}(view());
+            m_hash_ok = true;
+        }
+
+        return m_hash;
+    }
+
+    void StringValue::append(std::string_view text) {
+        const auto old_text_begin = m_text_p->text.data();
+        const auto old_text_end = old_text_begin + m_text_p->text.size();
+
+        /// NOTE: text from this string's own buffer (e.g. itself or a slice of it) could move or be freed by the detach or growth below, so it's copied first.
+        if (std::less_equal<const char*> {}(old_text_begin, text.data()) && std::less<const char*> {}(text.data(), old_text_end)) {
+            const std::string overlap_copy {text};
+
+            append(overlap_copy);
+            return;
+        }
+
+        detach_text(text.size());
+        m_text_p->text.append(text);
+        m_length = m_text_p->text.size();
+    }
+
+    auto StringValue::is_interned() const noexcept -> bool {
+        return m_interned;
+    }
+
+    void StringValue::mark_interned() noexcept {
+        [[maybe_unused]] const auto hash = get_hash();
+
+        m_frozen = true;
+        m_interned = true;
     }
-}
\ No newline at end of file
+}
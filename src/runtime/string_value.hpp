@@ -1,16 +1,39 @@
 #ifndef MINUET_RUNTIME_STRING_VALUE_HPP
 #define MINUET_RUNTIME_STRING_VALUE_HPP
 
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include "runtime/fast_value.hpp"
 
 namespace Minuet::Runtime {
+    /**
+     * @brief Contains characters as contiguous bytes, with a lazily cached hash. Copies share the same bytes until either copy is mutated (copy-on-write), which makes `make_str` of a preloaded literal cost O(1). Substrings are slices of their parent's bytes by an offset and length, so they also share them until a mutation.
+     * @note Interned strings are the canonical copies of their contents held by the heap's intern table. They're frozen, so their bytes never move and two of them are equal only if they're the same object.
+     */
     class StringValue : public HeapValueBase {
+    private:
+        /// NOTE: The characters shared by a string and its copies or slices. Only the owner's memory score includes them, so the heap counts them once.
+        struct TextBuffer {
+            std::string text;
+            const StringValue* owner_p;
+        };
+
     public:
         StringValue();
         StringValue(std::string s) noexcept;
 
+        /// NOTE: shares the other string's characters until a mutation, but the copy is always mutable & not interned
+        StringValue(const StringValue& other) noexcept;
+
+        /// NOTE: makes a slice of `length` characters from `offset` in the parent, which must be in bounds
+        StringValue(const StringValue& parent, std::size_t offset, std::size_t length) noexcept;
+
+        /// NOTE: gives up ownership of shared characters, so that whichever sharer is scored next takes over their charge
+        ~StringValue() override;
+
         auto get_memory_score() const& noexcept -> std::size_t override;
         auto get_tag() const& noexcept -> ObjectTag override;
         auto get_size() const& noexcept -> int override;
@@ -20,11 +43,16 @@ namespace Minuet::Runtime {
         auto push_value(FastValue arg) -> bool override;
         auto pop_value(SequenceOpPolicy mode) -> FastValue override;
         auto set_value(FastValue arg, std::size_t pos) -> bool override;
+        /// NOTE: always empty since characters aren't stored as FastValues, see `char_at()`
         auto get_value(std::size_t pos) -> std::optional<FastValue*> override;
+        /// NOTE: same as `char_at()`
+        auto get_packed_value(std::size_t pos) const -> std::optional<FastValue> override;
 
         void freeze() noexcept override;
-        auto items() noexcept -> std::vector<FastValue>& override;
-        auto items() const noexcept -> const std::vector<FastValue>& override;
+        void trim_storage(std::span<FastValue*> item_refs) override;
+        /// NOTE: strings have no FastValue items, so these give an empty sequence
+        auto items() noexcept -> std::span<FastValue> override;
+        auto items() const noexcept -> std::span<const FastValue> override;
         auto clone() -> std::unique_ptr<HeapValueBase> override;
 
         auto as_fast_value() noexcept -> FastValue override;
@@ -32,11 +60,36 @@ namespace Minuet::Runtime {
 
         [[nodiscard]] auto operator==(const HeapValueBase& rhs) const noexcept -> bool override;
 
+        [[nodiscard]] auto view() const noexcept -> std::string_view;
+
+        /// @brief Gives the character at `pos` as a `chr8` value, or nothing if `pos` is out of bounds.
+        [[nodiscard]] auto char_at(std::size_t pos) const noexcept -> std::optional<FastValue>;
+
+        [[nodiscard]] auto get_hash() const noexcept -> std::size_t;
+
+        /// NOTE: the caller must check that this string isn't frozen
+        void append(std::string_view text);
+
+        [[nodiscard]] auto is_interned() const noexcept -> bool;
+
+        /// @brief Freezes this string as the canonical copy of its contents, precomputing its hash. Only `HeapStorage` should call this for its intern table.
+        void mark_interned() noexcept;
+
     private:
-        static constexpr auto cm_fast_val_memsize = 16UL;
+        static constexpr auto cm_min_shrink_capacity = 64UL;
+
+        [[nodiscard]] auto is_slice() const noexcept -> bool;
+
+        /// @brief Gives this string its own characters before any mutation if they're still shared or only a slice, reserving room for `extra_len` more bytes so that an append right after doesn't copy them again.
+        void detach_text(std::size_t extra_len = 0);
 
-        std::vector<FastValue> m_items;
-        int m_length;
+        std::shared_ptr<TextBuffer> m_text_p;
+        std::size_t m_offset;
+        std::size_t m_length;
+        mutable std::size_t m_hash;
+        mutable bool m_hash_ok;
+        bool m_frozen;
+        bool m_interned;
     };
 }
 
@@ -1,11 +1,16 @@
 #include <utility>
 #include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
 // #include <print>
 #include <queue>
 #include <set>
 
 #include "runtime/fast_value.hpp"
 #include "runtime/bytecode.hpp"
+#include "runtime/dict_value.hpp"
+#include "runtime/heap_snapshot.hpp"
 #include "runtime/sequence_value.hpp"
 #include "runtime/string_value.hpp"
 #include "runtime/vm.hpp"
@@ -16,8 +21,8 @@ namespace Minuet::Runtime::VM {
     static constexpr auto ok_res_value = static_cast<int>(Utils::ExecStatus::ok);
 
     Engine::Engine(Utils::EngineConfig config, Code::Program& prgm, std::any native_fn_table_wrap, std::vector<std::string> program_args)
-    : m_heap (std::exchange(prgm.pre_objects, {})), m_memory {}, m_call_frames {}, m_program_argv_p {nullptr}, m_chunk_view {}, m_const_view {}, m_call_frame_ptr {nullptr}, m_native_funcs {}, m_rfi {}, m_rip {}, m_rbp {}, m_rft {}, m_rsp {}, m_consts_n {}, m_rrd {}, m_res {} {
-        const auto [mem_limit, recur_depth_max] = config;
+    : m_heap (std::exchange(prgm.pre_objects, {}), config.heap_config), m_heap_snapshot_path {config.heap_snapshot_path}, m_memory {}, m_call_frames {}, m_program_argv_p {nullptr}, m_chunk_view {}, m_const_view {}, m_call_frame_ptr {nullptr}, m_native_funcs {}, m_rfi {}, m_rip {}, m_rbp {}, m_rft {}, m_rsp {}, m_native_base {}, m_consts_n {}, m_rrd {}, m_res {} {
+        const auto [heap_config, heap_snapshot_path, mem_limit, recur_depth_max] = config;
         const auto prgm_entry_fn_id = prgm.entry_id.value_or(-1);
 
         const auto mem_vec_size = static_cast<std::size_t>(mem_limit);
@@ -97,9 +102,33 @@ namespace Minuet::Runtime::VM {
                 case Code::Opcode::seq_obj_get:
                     handle_seq_obj_get(metadata, args[0], args[1], args[2]);
                     break;
+                case Code::Opcode::seq_obj_get_unchecked:
+                    handle_seq_obj_get_unchecked(metadata, args[0], args[1], args[2]);
+                    break;
+                case Code::Opcode::seq_obj_set:
+                    handle_seq_obj_set(metadata, args[0], args[1], args[2]);
+                    break;
                 case Code::Opcode::frz_seq_obj:
                     handle_frz_seq_obj(args[0]);
                     break;
+                case Code::Opcode::make_dict:
+                    handle_make_dict(args[0]);
+                    break;
+                case Code::Opcode::dict_get:
+                    handle_dict_get(metadata, args[0], args[1], args[2]);
+                    break;
+                case Code::Opcode::dict_set:
+                    handle_dict_set(metadata, args[0], args[1], args[2]);
+                    break;
+                case Code::Opcode::load_obj:
+                    handle_load_obj(args[0], args[1]);
+                    break;
+                case Code::Opcode::iter_init:
+                    handle_iter_init(metadata, args[0], args[1]);
+                    break;
+                case Code::Opcode::iter_next_or_jump:
+                    handle_iter_next_or_jump(args[0], args[1], args[2]);
+                    break;
                 case Code::Opcode::load_const:
                     handle_load_const(metadata, args[0], args[1]);
                     break;
@@ -124,6 +153,12 @@ namespace Minuet::Runtime::VM {
                 case Code::Opcode::mod:
                     handle_mod(metadata, args[0], args[1], args[2]);
                     break;
+                case Code::Opcode::shr:
+                    handle_shr(metadata, args[0], args[1], args[2]);
+                    break;
+                case Code::Opcode::bit_and:
+                    handle_bit_and(metadata, args[0], args[1], args[2]);
+                    break;
                 case Code::Opcode::add:
                     handle_add(metadata, args[0], args[1], args[2]);
                     break;
@@ -149,7 +184,7 @@ namespace Minuet::Runtime::VM {
                     handle_cmp_gte(metadata, args[0], args[1], args[2]);
                     break;
                 case Code::Opcode::jump:
-                    m_rip = args[0];
+                    handle_jmp(args[0], args[1]);
                     break;
                 case Code::Opcode::jump_if:
                     handle_jmp_if(args[0], args[1]);
@@ -158,13 +193,13 @@ namespace Minuet::Runtime::VM {
                     handle_jmp_else(args[0], args[1]);
                     break;
                 case Code::Opcode::call:
-                    handle_call(args[0], args[1]);
+                    handle_call(args[0], args[1], args[2]);
                     break;
                 case Code::Opcode::ret:
                     handle_ret(metadata, args[0]);
                     break;
                 case Code::Opcode::native_call:
-                    handle_native_call(args[0], args[1]);
+                    handle_native_call(args[0], args[1], args[2]);
                     break;
                 case Code::Opcode::halt:
                 default:
@@ -188,25 +223,77 @@ namespace Minuet::Runtime::VM {
         return m_heap;
     }
 
-    auto Engine::handle_native_fn_access(int16_t arg_count, int16_t offset) & noexcept -> Runtime::FastValue& {
-        if (const auto native_call_base_slot = m_rft - arg_count; arg_count > 0) {
-            return m_memory[native_call_base_slot + offset + 1];
-        } else {
-            return m_memory[native_call_base_slot + offset];
+    auto Engine::handle_native_fn_access([[maybe_unused]] int16_t arg_count, int16_t offset) & noexcept -> Runtime::FastValue& {
+        return m_memory[m_native_base + offset];
+    }
+
+    void Engine::handle_native_fn_return(Runtime::FastValue&& result, [[maybe_unused]] int16_t arg_count) noexcept {
+        m_memory[m_native_base] = std::move(result);
+        m_rft = std::max(m_rft, m_native_base);
+    }
+
+    auto Engine::dump_heap_snapshot() -> bool {
+        const HeapSnapshot snapshot {m_heap, collect_gc_roots()};
+
+        if (m_heap_snapshot_path.empty()) {
+            snapshot.write_json(std::cerr);
+
+            return true;
+        }
+
+        std::ofstream snapshot_file {m_heap_snapshot_path, std::ios::app};
+
+        if (!snapshot_file.is_open()) {
+            return false;
         }
+
+        snapshot.write_json(snapshot_file);
+
+        return snapshot_file.good();
     }
 
-    void Engine::handle_native_fn_return(Runtime::FastValue&& result, int16_t arg_count) noexcept {
-        if (const auto native_call_result_slot = m_rft - arg_count; arg_count > 0) {
-            m_memory[native_call_result_slot + 1] = std::move(result);
-        } else {
-            m_memory[native_call_result_slot] = std::move(result);
-            ++m_rft;
+    /**
+     * @brief Gathers the references to heap objects which the program can still use: the argv list and any live register values.
+     */
+    auto Engine::collect_gc_roots() -> std::vector<HeapValuePtr> {
+        std::vector<HeapValuePtr> roots;
+
+        /// NOTE: The program's argv is only reachable through `get_argv()`, so it's always a root.
+        if (m_program_argv_p) {
+            roots.emplace_back(m_program_argv_p);
+        }
+
+        const auto reg_scan_end = std::min(m_rft, static_cast<int>(m_memory.size()) - 1);
+
+        /// NOTE: Only the live frames up to RFT are scanned. Returning callees clear their registers (see `handle_ret`), so no register here refers to an already swept object.
+        for (auto abs_reg_id = 0; abs_reg_id <= reg_scan_end; ++abs_reg_id) {
+            if (HeapValuePtr object_p = m_memory[abs_reg_id].to_object_ptr(); object_p) {
+                roots.emplace_back(object_p);
+            }
         }
+
+        return roots;
+    }
+
+    /**
+     * @brief Gathers the live registers which hold item references, so that the GC can move them along with their items when trimming sequences.
+     */
+    auto Engine::collect_item_refs() -> std::vector<FastValue*> {
+        std::vector<FastValue*> ref_holders;
+
+        const auto reg_scan_end = std::min(m_rft, static_cast<int>(m_memory.size()) - 1);
+
+        for (auto abs_reg_id = 0; abs_reg_id <= reg_scan_end; ++abs_reg_id) {
+            if (m_memory[abs_reg_id].tag() == FVTag::val_ref) {
+                ref_holders.emplace_back(&m_memory[abs_reg_id]);
+            }
+        }
+
+        return ref_holders;
     }
 
     /**
-     * @brief Implements the bulk of garbage collection. Specifically, the logic will base itself on craftinginterpreters.com: the GC will stop-the-world for each collection if the heap has a certain "overhead score" given by
+     * @brief Implements the bulk of garbage collection. Specifically, the logic will base itself on craftinginterpreters.com: the GC will stop-the-world for each collection once the heap's live bytes (by each object's memory score) pass its adaptive threshold.
      */
     void Engine::try_mark_and_sweep() {
         if (!m_heap.is_ripe()) {
@@ -214,13 +301,11 @@ namespace Minuet::Runtime::VM {
         }
 
         std::set<HeapValuePtr> live_object_ptrs;
-        std::set<HeapValuePtr> visited;
         std::queue<HeapValuePtr> frontier;
+        auto item_ref_holders = collect_item_refs();
 
-        for (auto abs_reg_id = 0; abs_reg_id <= m_rft; ++abs_reg_id) {
-            if (HeapValuePtr object_p = m_memory[abs_reg_id].to_object_ptr(); object_p) {
-                frontier.emplace(object_p);
-            }
+        for (auto root_p : collect_gc_roots()) {
+            frontier.emplace(root_p);
         }
 
         // 1. Use a BFS traversal to mark all heap values that are reachable from the register frames. During this stage, every marked address will be stored in a "reachable" set...
@@ -228,42 +313,73 @@ namespace Minuet::Runtime::VM {
             auto next_ptr = frontier.front();
             frontier.pop();
 
+            if (live_object_ptrs.contains(next_ptr)) {
+                continue;
+            }
+
             live_object_ptrs.emplace(next_ptr);
 
-            if (next_ptr->get_tag() == ObjectTag::sequence) {
-                SequenceValue* sequence_ptr = dynamic_cast<SequenceValue*>(next_ptr);
+            /// NOTE: a dict's items are its keys and values, so both are traced.
+            if (const auto next_tag = next_ptr->get_tag(); next_tag == ObjectTag::sequence || next_tag == ObjectTag::dict) {
+                for (auto& item_value : next_ptr->items()) {
+                    if (item_value.tag() == FVTag::val_ref) {
+                        item_ref_holders.emplace_back(&item_value);
+                    }
 
-                for (auto& item_value : sequence_ptr->items()) {
-                    if (HeapValuePtr item_obj_ptr = item_value.to_object_ptr(); item_obj_ptr != nullptr && !visited.contains(item_obj_ptr)) {
+                    if (HeapValuePtr item_obj_ptr = item_value.to_object_ptr(); item_obj_ptr != nullptr && !live_object_ptrs.contains(item_obj_ptr)) {
                         frontier.emplace(item_obj_ptr);
                     }
                 }
             }
-
-            visited.emplace(next_ptr);
         }
 
-        // 2. Linearly scan through the heap cells for anything NOT in the reachable set... If the value is unmarked, the VM can collect it.
-        for (auto cell_id = 0UL; auto& heap_cell : m_heap.get_objects()) {
-            if (heap_cell.get()->get_tag() != ObjectTag::dud) {
-                if (!m_heap.try_destroy_value(cell_id)) {
-                    break;
-                }
+        // 2. Linearly scan through the heap cells for anything NOT in the reachable set... If the value is unmarked, the VM can collect it. Preloaded literals are skipped by the heap itself.
+        const auto& heap_cells = m_heap.get_objects();
+
+        for (auto cell_id = m_heap.get_preload_count(); cell_id < heap_cells.size(); ++cell_id) {
+            if (const auto& heap_cell = heap_cells[cell_id]; heap_cell && !live_object_ptrs.contains(heap_cell.get())) {
+                [[maybe_unused]] const auto destroyed = m_heap.try_destroy_value(cell_id);
             }
+        }
 
-            ++cell_id;
+        // 3. Trim the excess storage which pops left in live objects. Every item reference is known by now, so any reference into a trimmed sequence can follow its item.
+        std::ranges::sort(item_ref_holders, std::less {}, [](const FastValue* ref_holder_p) { return ref_holder_p->to_ref_ptr(); });
+
+        for (auto& heap_cell : m_heap.get_objects()) {
+            if (heap_cell) {
+                heap_cell->trim_storage(item_ref_holders);
+            }
         }
+
+        // 4. If the sweep left the object table mostly holes, compact it before recounting live bytes.
+        [[maybe_unused]] const auto compacted = m_heap.try_compact();
+
+        m_heap.adapt_threshold();
     }
 
     void Engine::handle_make_str(int16_t dest_reg, int16_t str_obj_id) noexcept {
         const auto abs_reg_id = m_rbp + dest_reg;
 
+        /// NOTE: allocation safepoint- collect before the new object exists so that it can't be swept while unrooted.
+        if (m_heap.is_ripe()) {
+            try_mark_and_sweep();
+        }
+
+        const auto& literal_obj = m_heap.get_objects()[str_obj_id];
+
+        if (!literal_obj || literal_obj->get_tag() != ObjectTag::string) {
+            m_res = static_cast<int>(Utils::ExecStatus::mem_error);
+            return;
+        }
+
+        /// NOTE: The new string shares the literal's characters until it's mutated, so no per-character copy happens here.
         m_memory[abs_reg_id] = {
             m_heap.try_create_value<StringValue>(
-                m_heap.get_objects()[str_obj_id]->to_string()
+                static_cast<const StringValue&>(*literal_obj)
             ).get(),
             FVTag::string
         };
+        m_rft = std::max(m_rft, abs_reg_id);
 
         ++m_rip;
     }
@@ -271,10 +387,15 @@ namespace Minuet::Runtime::VM {
     void Engine::handle_make_seq(int16_t dest_reg) noexcept {
         const auto abs_reg_id = m_rbp + dest_reg;
 
+        if (m_heap.is_ripe()) {
+            try_mark_and_sweep();
+        }
+
         m_memory[abs_reg_id] = {
             m_heap.try_create_value<SequenceValue>().get(),
             FVTag::sequence,
         };
+        m_rft = std::max(m_rft, abs_reg_id);
 
         ++m_rip;
     }
@@ -293,7 +414,10 @@ namespace Minuet::Runtime::VM {
         auto src_value = src_value_opt.value();
 
         if (HeapValuePtr dest_obj_ref = m_memory[abs_dest_id].to_object_ptr(); dest_obj_ref) {
+            const auto old_score = dest_obj_ref->get_memory_score();
+
             dest_obj_ref->push_value(src_value);
+            m_heap.track_resize(old_score, dest_obj_ref->get_memory_score());
             ++m_rip;
         } else {
             m_res = static_cast<int>(Utils::ExecStatus::mem_error);
@@ -312,7 +436,10 @@ namespace Minuet::Runtime::VM {
             return;
         }
 
+        const auto old_score = src_obj_ptr->get_memory_score();
+
         m_memory[abs_dest_id] = src_obj_ptr->pop_value(pop_mode);
+        m_heap.track_resize(old_score, src_obj_ptr->get_memory_score());
 
         ++m_rip;
     }
@@ -329,6 +456,16 @@ namespace Minuet::Runtime::VM {
             return;
         }
 
+        /// NOTE: A dict gives a copy of the key's value, or a dud if the key is absent, just like a `dict_get`. A reference to its slot could dangle once the dict rehashes, and stores by key are a `seq_obj_set` anyway.
+        if (HeapValuePtr src_obj_ref = m_memory[abs_src_id].to_object_ptr(); src_obj_ref && src_obj_ref->get_tag() == ObjectTag::dict) {
+            const auto value_slot_p = static_cast<const DictValue*>(src_obj_ref)->find(pos_value_opt.value().deref());
+
+            m_memory[abs_dest_id] = (value_slot_p) ? *value_slot_p : FastValue {};
+            m_rft = std::max(m_rft, abs_dest_id);
+            ++m_rip;
+            return;
+        }
+
         const auto pos_i32_opt = pos_value_opt.value().to_scalar();
 
         if (!pos_i32_opt) {
@@ -339,8 +476,19 @@ namespace Minuet::Runtime::VM {
         const auto pos_i32 = pos_i32_opt.value();
 
         if (HeapValuePtr src_obj_ref = m_memory[abs_src_id].to_object_ptr(); src_obj_ref) {
-            if (auto item_opt = src_obj_ref->get_value(pos_i32); item_opt) {
-                m_memory[abs_dest_id] = {item_opt.value()};
+            /// NOTE: String characters and packed array items are plain bytes, so they're given by value instead of by reference.
+            if (src_obj_ref->get_tag() != ObjectTag::sequence) {
+                if (auto packed_opt = src_obj_ref->get_packed_value(pos_i32); packed_opt) {
+                    m_memory[abs_dest_id] = packed_opt.value();
+                    m_rft = std::max(m_rft, abs_dest_id);
+                    ++m_rip;
+                    return;
+                }
+            } else if (auto item_opt = src_obj_ref->get_value(pos_i32); item_opt) {
+                /// NOTE: Tuples are read-only (and may be shared preloaded constants), so their items are given by value instead of by an assignable reference.
+                m_memory[abs_dest_id] = (src_obj_ref->is_frozen())
+                    ? *item_opt.value()
+                    : FastValue {item_opt.value()};
                 ++m_rip;
                 return;
             }
@@ -349,6 +497,83 @@ namespace Minuet::Runtime::VM {
         m_res = static_cast<int>(Utils::ExecStatus::mem_error);
     }
 
+    void Engine::handle_seq_obj_get_unchecked(uint16_t metadata, int16_t dest, int16_t src_id, int16_t pos_reg) noexcept {
+        HeapValuePtr src_obj_ref = m_memory[m_rbp + src_id].to_object_ptr();
+
+        /// NOTE: The IR range analysis only proves positions against `len_of`, which only counts item positions for lists & tuples. Dicts, strings, and packed arrays still take the checked path.
+        if (!src_obj_ref || src_obj_ref->get_tag() != ObjectTag::sequence) {
+            handle_seq_obj_get(metadata, dest, src_id, pos_reg);
+            return;
+        }
+
+        const auto pos_value = m_memory[m_rbp + pos_reg];
+        auto& src_seq = static_cast<SequenceValue&>(*src_obj_ref);
+
+#ifndef NDEBUG
+        /// NOTE: Debug builds validate each proof against the checked path, which fails with its usual status should a proof ever be wrong.
+        if (const auto pos_opt = pos_value.to_scalar(); !pos_opt || pos_opt.value() < 0 || !src_seq.get_value(pos_opt.value())) {
+            handle_seq_obj_get(metadata, dest, src_id, pos_reg);
+            return;
+        }
+#endif
+
+        auto item_p = src_seq.get_value_unchecked(pos_value.to_scalar().value_or(0));
+
+        m_memory[m_rbp + dest] = (src_seq.is_frozen())
+            ? *item_p
+            : FastValue {item_p};
+        ++m_rip;
+    }
+
+    void Engine::handle_seq_obj_set(uint16_t metadata, int16_t obj_id, int16_t pos_id, int16_t value_id) noexcept {
+        const auto pos_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
+        const auto value_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
+        auto obj_value = m_memory[m_rbp + obj_id].deref();
+        HeapValuePtr obj_p = obj_value.to_object_ptr();
+
+        if (!obj_p) {
+            m_res = static_cast<int>(Utils::ExecStatus::arg_error);
+            return;
+        }
+
+        /// NOTE: A dict store by a computed key is just a `dict_set`, whose operands are laid out the same way.
+        if (obj_p->get_tag() == ObjectTag::dict) {
+            handle_dict_set(metadata, obj_id, pos_id, value_id);
+            return;
+        }
+
+        auto pos_opt = fetch_value(pos_mode, pos_id);
+        auto value_opt = fetch_value(value_mode, value_id);
+
+        if (!pos_opt || !value_opt) {
+            m_res = static_cast<int>(Utils::ExecStatus::arg_error);
+            return;
+        }
+
+        const auto pos_i32_opt = pos_opt.value().deref().to_scalar();
+
+        if (!pos_i32_opt) {
+            m_res = static_cast<int>(Utils::ExecStatus::arg_error);
+            return;
+        }
+
+        if (const auto pos_i32 = pos_i32_opt.value(); pos_i32 < 0 || pos_i32 >= obj_p->get_size()) {
+            m_res = static_cast<int>(Utils::ExecStatus::mem_error);
+            return;
+        }
+
+        /// NOTE: Storing a character may copy a string's shared text first.
+        const auto old_score = obj_p->get_memory_score();
+
+        if (!obj_p->set_value(value_opt.value().deref(), pos_i32_opt.value())) {
+            m_res = static_cast<int>(Utils::ExecStatus::arg_error);
+            return;
+        }
+
+        m_heap.track_resize(old_score, obj_p->get_memory_score());
+        ++m_rip;
+    }
+
     void Engine::handle_frz_seq_obj(int16_t dest) noexcept {
         const auto abs_dest_id = m_rbp + dest;
 
@@ -362,16 +587,189 @@ namespace Minuet::Runtime::VM {
         m_res = static_cast<int>(Utils::ExecStatus::mem_error);
     }
 
+    auto Engine::find_or_add_dict_slot(DictValue& dict, const FastValue& key) -> FastValue* {
+        if (auto value_slot_p = dict.find(key); value_slot_p) {
+            return value_slot_p;
+        }
+
+        auto stored_key = key;
+
+        if (key.tag() == FVTag::string) {
+            if (const auto key_str_p = static_cast<const StringValue*>(key.to_object_ptr()); !key_str_p->is_interned()) {
+                auto interned_key_p = m_heap.intern_string(key_str_p->view());
+
+                if (!interned_key_p) {
+                    return nullptr;
+                }
+
+                stored_key = interned_key_p->as_fast_value();
+            }
+        }
+
+        const auto old_score = dict.get_memory_score();
+        auto value_slot_p = dict.insert(stored_key, {});
+
+        m_heap.track_resize(old_score, dict.get_memory_score());
+
+        return value_slot_p;
+    }
+
+    void Engine::handle_make_dict(int16_t dest_reg) noexcept {
+        const auto abs_reg_id = m_rbp + dest_reg;
+
+        if (m_heap.is_ripe()) {
+            try_mark_and_sweep();
+        }
+
+        m_memory[abs_reg_id] = {
+            m_heap.try_create_value<DictValue>().get(),
+            FVTag::sequence,
+        };
+        m_rft = std::max(m_rft, abs_reg_id);
+
+        ++m_rip;
+    }
+
+    void Engine::handle_dict_get(uint16_t metadata, int16_t dest, int16_t dict_id, int16_t key_id) noexcept {
+        const auto abs_dest_id = m_rbp + dest;
+        const auto key_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
+
+        auto key_opt = fetch_value(key_mode, key_id);
+        const auto dict_obj_p = m_memory[m_rbp + dict_id].deref().to_object_ptr();
+
+        if (!key_opt || !dict_obj_p || dict_obj_p->get_tag() != ObjectTag::dict) {
+            m_res = static_cast<int>(Utils::ExecStatus::arg_error);
+            return;
+        }
+
+        /// NOTE: Absent keys give a dud without being added.
+        const auto value_slot_p = static_cast<const DictValue*>(dict_obj_p)->find(key_opt.value().deref());
+
+        m_memory[abs_dest_id] = (value_slot_p) ? *value_slot_p : FastValue {};
+        m_rft = std::max(m_rft, abs_dest_id);
+
+        ++m_rip;
+    }
+
+    void Engine::handle_dict_set(uint16_t metadata, int16_t dict_id, int16_t key_id, int16_t value_id) noexcept {
+        const auto key_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
+        const auto value_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
+
+        /// NOTE: allocation safepoint- an added string key may be interned as a new object.
+        if (m_heap.is_ripe()) {
+            try_mark_and_sweep();
+        }
+
+        auto key_opt = fetch_value(key_mode, key_id);
+        auto value_opt = fetch_value(value_mode, value_id);
+        auto dict_value = m_memory[m_rbp + dict_id].deref();
+        HeapValuePtr dict_obj_p = dict_value.to_object_ptr();
+
+        if (!key_opt || !value_opt || !dict_obj_p || dict_obj_p->get_tag() != ObjectTag::dict || dict_obj_p->is_frozen()) {
+            m_res = static_cast<int>(Utils::ExecStatus::arg_error);
+            return;
+        }
+
+        if (auto value_slot_p = find_or_add_dict_slot(static_cast<DictValue&>(*dict_obj_p), key_opt.value().deref()); value_slot_p) {
+            *value_slot_p = value_opt.value().deref();
+            ++m_rip;
+            return;
+        }
+
+        m_res = static_cast<int>(Utils::ExecStatus::mem_error);
+    }
+
     auto Engine::fetch_value(Code::ArgMode mode, int16_t id) noexcept -> std::optional<FastValue> {
         switch (mode) {
             case Code::ArgMode::constant: return m_const_view[id];
             case Code::ArgMode::reg: return m_memory[m_rbp + id];
+            /// NOTE: only preloaded literals are addressed this way, e.g dictionary keys, and they're never collected.
+            case Code::ArgMode::heap: return m_heap.get_objects()[id]->as_fast_value();
             case Code::ArgMode::stack:
-            case Code::ArgMode::heap:
             default: return {};
         }
     }
 
+    void Engine::handle_load_obj(int16_t dest, int16_t obj_id) noexcept {
+        const auto abs_dest_id = m_rbp + dest;
+        const auto& preloaded_obj = m_heap.get_objects()[obj_id];
+
+        if (!preloaded_obj) {
+            m_res = static_cast<int>(Utils::ExecStatus::mem_error);
+            return;
+        }
+
+        /// NOTE: Preloaded objects are never collected, so no safepoint is needed here.
+        m_memory[abs_dest_id] = preloaded_obj->as_fast_value();
+        m_rft = std::max(m_rft, abs_dest_id);
+
+        ++m_rip;
+    }
+
+    void Engine::handle_iter_init(uint16_t metadata, int16_t iter_reg, int16_t src_id) noexcept {
+        const auto abs_iter_id = m_rbp + iter_reg;
+        const auto src_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
+        auto src_value_opt = fetch_value(src_mode, src_id);
+
+        if (!src_value_opt || !src_value_opt.value().deref().to_object_ptr()) {
+            m_res = static_cast<int>(Utils::ExecStatus::arg_error);
+            return;
+        }
+
+        /// NOTE: The iterator keeps its own reference to the iterable, so reassigning the iterated variable in the loop can't affect it (or let the GC take it).
+        m_memory[abs_iter_id] = src_value_opt.value().deref();
+        m_memory[abs_iter_id + 1] = FastValue {0};
+        m_rft = std::max(m_rft, abs_iter_id + 1);
+
+        ++m_rip;
+    }
+
+    void Engine::handle_iter_next_or_jump(int16_t iter_reg, int16_t exit_ip, int16_t dest_reg) noexcept {
+        const auto abs_iter_id = m_rbp + iter_reg;
+        const auto abs_dest_id = m_rbp + dest_reg;
+        HeapValuePtr src_obj_p = m_memory[abs_iter_id].to_object_ptr();
+        auto& iter_pos_value = m_memory[abs_iter_id + 1];
+        auto iter_pos = static_cast<std::size_t>(iter_pos_value.to_scalar().value_or(0));
+        std::optional<FastValue> next_item_opt;
+
+        /// NOTE: The iterable's current size is checked on every step, so items added or removed by the loop's body never cause out-of-bounds reads.
+        switch (src_obj_p->get_tag()) {
+        case ObjectTag::sequence:
+            if (auto& src_seq = static_cast<SequenceValue&>(*src_obj_p); iter_pos < static_cast<std::size_t>(src_seq.get_size())) {
+                next_item_opt = *src_seq.get_value_unchecked(iter_pos);
+            }
+            break;
+        case ObjectTag::dict:
+            {
+                /// NOTE: Dicts give their keys in insertion order, skipping over the dud pairs of erased keys.
+                const auto dict_entries = src_obj_p->items();
+
+                while (iter_pos * 2 < dict_entries.size() && dict_entries[iter_pos * 2].is_none()) {
+                    ++iter_pos;
+                }
+
+                if (iter_pos * 2 < dict_entries.size()) {
+                    next_item_opt = dict_entries[iter_pos * 2];
+                }
+            }
+            break;
+        default:
+            next_item_opt = src_obj_p->get_packed_value(iter_pos);
+            break;
+        }
+
+        if (!next_item_opt) {
+            m_rip = exit_ip;
+            return;
+        }
+
+        m_memory[abs_dest_id] = next_item_opt.value();
+        m_rft = std::max(m_rft, abs_dest_id);
+        iter_pos_value = FastValue {static_cast<int>(iter_pos + 1)};
+
+        ++m_rip;
+    }
+
     void Engine::handle_load_const([[maybe_unused]] uint16_t metadata, int16_t dest, int16_t const_id) noexcept {
         auto temp_const = fetch_value(Code::ArgMode::constant, const_id);
 
@@ -477,6 +875,51 @@ namespace Minuet::Runtime::VM {
         }
     }
 
+    /// NOTE: The IR only emits this for `x / 2^k` where `x` is proven to be a non-negative `int32`, so only plain integers are shifted.
+    void Engine::handle_shr(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+        const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
+        const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
+        auto lhs_opt = fetch_value(lhs_mode, lhs);
+        auto rhs_opt = fetch_value(rhs_mode, rhs);
+
+        if (lhs_opt->tag() != FVTag::int32 || rhs_opt->tag() != FVTag::int32) {
+            m_res = static_cast<int>(Utils::ExecStatus::math_error);
+            return;
+        }
+
+        const auto shift_n = rhs_opt->to_scalar().value();
+
+        if (shift_n < 0 || shift_n > 31) {
+            m_res = static_cast<int>(Utils::ExecStatus::math_error);
+            return;
+        }
+
+        const auto real_mem_loc = m_rbp + dest;
+
+        m_memory[real_mem_loc] = FastValue {lhs_opt->to_scalar().value() >> shift_n};
+        m_rft = std::max(m_rft, real_mem_loc);
+        ++m_rip;
+    }
+
+    /// NOTE: The IR only emits this for `x % 2^k` where `x` is proven to be a non-negative `int32`, so only plain integers are masked.
+    void Engine::handle_bit_and(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+        const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
+        const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
+        auto lhs_opt = fetch_value(lhs_mode, lhs);
+        auto rhs_opt = fetch_value(rhs_mode, rhs);
+
+        if (lhs_opt->tag() != FVTag::int32 || rhs_opt->tag() != FVTag::int32) {
+            m_res = static_cast<int>(Utils::ExecStatus::math_error);
+            return;
+        }
+
+        const auto real_mem_loc = m_rbp + dest;
+
+        m_memory[real_mem_loc] = FastValue {lhs_opt->to_scalar().value() & rhs_opt->to_scalar().value()};
+        m_rft = std::max(m_rft, real_mem_loc);
+        ++m_rip;
+    }
+
     void Engine::handle_add(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
@@ -589,6 +1032,20 @@ namespace Minuet::Runtime::VM {
         ++m_rip;
     }
 
+    /**
+     * @brief Jumps to an absolute IP in the current chunk. Loop back-edges are marked by the emitter as GC safepoints, so a long-running loop can still collect garbage before its function returns.
+     *
+     * @param dest_ip
+     * @param safepoint_flag Nonzero if this jump is a loop back-edge.
+     */
+    void Engine::handle_jmp(int16_t dest_ip, int16_t safepoint_flag) noexcept {
+        if (safepoint_flag != 0 && m_heap.is_ripe()) {
+            try_mark_and_sweep();
+        }
+
+        m_rip = dest_ip;
+    }
+
     void Engine::handle_jmp_if(int16_t check_reg, int16_t dest_ip) noexcept {
         if (m_memory[m_rbp + check_reg]) {
             m_rip = dest_ip;
@@ -608,11 +1065,11 @@ namespace Minuet::Runtime::VM {
     /**
      * @brief Executes logic for a bytecode function call. Specified operations in `vm.md` under the `call` note are done. Only special registers of RES and RFV are preserved since the call frames already track special register-related values. The stack will pop-off properly where only those 2 special regs mentioned earlier are saved.
      *
-     * @param metadata
      * @param func_id
      * @param arg_count
+     * @param arg_base_reg The caller's register holding the 1st argument, which becomes the callee's base & result slot.
      */
-    void Engine::handle_call(int16_t func_id, int16_t arg_count) noexcept {
+    void Engine::handle_call(int16_t func_id, int16_t arg_count, int16_t arg_base_reg) noexcept {
         const auto old_rfi = m_rfi;
         const int16_t old_rip = m_rip + 1;
         const auto old_rbp = m_rbp;
@@ -631,12 +1088,17 @@ namespace Minuet::Runtime::VM {
 
         m_rfi = func_id;
         m_rip = 0;
-        m_rbp = m_rft - arg_count + 1;
+        m_rbp = old_rbp + arg_base_reg;
+        m_rft = std::max(m_rft, m_rbp + arg_count - 1);
     }
 
-    void Engine::handle_native_call(int16_t native_id, int16_t arg_count) noexcept {
+    void Engine::handle_native_call(int16_t native_id, int16_t arg_count, int16_t arg_base_reg) noexcept {
+        m_native_base = m_rbp + arg_base_reg;
         m_res = (m_native_funcs->data()[native_id](*this, arg_count)) ? ok_res_value : static_cast<int>(Utils::ExecStatus::op_error);
 
+        /// NOTE: Like a callee's registers after `ret`, the other argument slots are dead now. They're cleared since an argument may be an item reference, which a later `mov` into a reused slot would write through.
+        std::fill(m_memory.begin() + m_native_base + 1, m_memory.begin() + m_native_base + std::max(arg_count, static_cast<int16_t>(1)), FastValue {});
+
         ++m_rip;
     }
 
@@ -647,15 +1109,18 @@ namespace Minuet::Runtime::VM {
 
         m_memory[m_rbp] = std::move(ret_src_opt.value());
 
-        /// 2. Restore the caller's call state
+        /// NOTE: The callee's other registers are dead now, so they're cleared to keep stale references out of later GC root scans.
+        std::fill(m_memory.begin() + m_rbp + 1, m_memory.begin() + std::max(m_rft, m_rbp) + 1, FastValue {});
+
+        /// 2. Restore the caller's call state, keeping the result slot within the caller's frame top so it stays rooted.
         auto [caller_rfi, caller_rip, caller_rbp, caller_rft, caller_res] = *m_call_frame_ptr;
         --m_call_frame_ptr;
         --m_rrd;
 
+        m_rft = std::max(caller_rft, m_rbp);
         m_rfi = caller_rfi;
         m_rip = caller_rip;
         m_rbp = caller_rbp;
-        m_rft = caller_rft;
         m_res = caller_res;
 
         try_mark_and_sweep();
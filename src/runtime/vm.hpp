@@ -4,9 +4,12 @@
 #include <any>
 #include <cstdint>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "runtime/fast_value.hpp"
+#include "runtime/dict_value.hpp"
 #include "runtime/heap_storage.hpp"
 #include "runtime/bytecode.hpp"
 #include "runtime/natives.hpp"
@@ -14,6 +17,8 @@
 namespace Minuet::Runtime::VM {
     namespace Utils {
         struct EngineConfig {
+            HeapConfig heap_config;
+            std::string_view heap_snapshot_path; // empty if heap snapshots go to `stderr`
             int reg_buffer_limit;
             int16_t call_frame_max;
         };
@@ -52,19 +57,36 @@ namespace Minuet::Runtime::VM {
 
         void handle_native_fn_return(Runtime::FastValue&& result, [[maybe_unused]] int16_t arg_count) noexcept;
 
+        /// @brief Appends a JSON snapshot of the heap to the configured snapshot file, or to `stderr` if there's none.
+        [[nodiscard]] auto dump_heap_snapshot() -> bool;
+
     private:
+        [[nodiscard]] auto collect_gc_roots() -> std::vector<HeapValuePtr>;
+        [[nodiscard]] auto collect_item_refs() -> std::vector<FastValue*>;
+
         [[nodiscard]] auto fetch_value(Code::ArgMode mode, int16_t id) noexcept -> std::optional<Runtime::FastValue>;
 
         void try_mark_and_sweep();
 
+        /// @brief Gets a dict's value slot for a key, adding the key with a dud value if it's absent. Added string keys are interned first, so mutating the original string later can't corrupt the dict.
+        [[nodiscard]] auto find_or_add_dict_slot(DictValue& dict, const FastValue& key) -> FastValue*;
+
         void handle_make_str(int16_t dest_reg, int16_t str_obj_id) noexcept;
         void handle_make_seq(int16_t dest_reg) noexcept;
         void handle_seq_obj_push(uint16_t metadata, int16_t dest, int16_t src_id, int16_t mode) noexcept;
         void handle_seq_obj_pop(uint16_t metadata, int16_t dest, int16_t src_id, int16_t mode) noexcept;
         void handle_seq_obj_get(uint16_t metadata, int16_t dest, int16_t src_id, int16_t pos_value_id) noexcept;
+        void handle_seq_obj_get_unchecked(uint16_t metadata, int16_t dest, int16_t src_id, int16_t pos_reg) noexcept;
+        void handle_seq_obj_set(uint16_t metadata, int16_t obj_id, int16_t pos_id, int16_t value_id) noexcept;
         void handle_frz_seq_obj(int16_t dest) noexcept;
+        void handle_make_dict(int16_t dest_reg) noexcept;
+        void handle_dict_get(uint16_t metadata, int16_t dest, int16_t dict_id, int16_t key_id) noexcept;
+        void handle_dict_set(uint16_t metadata, int16_t dict_id, int16_t key_id, int16_t value_id) noexcept;
 
         void handle_load_const(uint16_t metadata, int16_t dest, int16_t const_id) noexcept;
+        void handle_load_obj(int16_t dest, int16_t obj_id) noexcept;
+        void handle_iter_init(uint16_t metadata, int16_t iter_reg, int16_t src_id) noexcept;
+        void handle_iter_next_or_jump(int16_t iter_reg, int16_t exit_ip, int16_t dest_reg) noexcept;
         void handle_mov(uint16_t metadata, int16_t dest, int16_t src) noexcept;
 
         void handle_neg(uint16_t metadata, int16_t dest) noexcept;
@@ -73,6 +95,8 @@ namespace Minuet::Runtime::VM {
         void handle_mul(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
         void handle_div(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
         void handle_mod(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+        void handle_shr(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+        void handle_bit_and(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
         void handle_add(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
         void handle_sub(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs);
 
@@ -83,15 +107,16 @@ namespace Minuet::Runtime::VM {
         void handle_cmp_gte(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
         void handle_cmp_lte(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
 
-        // void handle_jmp(int16_t dest_ip) noexcept;
+        void handle_jmp(int16_t dest_ip, int16_t safepoint_flag) noexcept;
         void handle_jmp_if(int16_t check_reg, int16_t dest_ip) noexcept;
         void handle_jmp_else(int16_t check_reg, int16_t dest_ip) noexcept;
-        void handle_call(int16_t func_id, int16_t arg_count) noexcept;
-        void handle_native_call(int16_t native_id, [[maybe_unused]] int16_t arg_count) noexcept;
+        void handle_call(int16_t func_id, int16_t arg_count, int16_t arg_base_reg) noexcept;
+        void handle_native_call(int16_t native_id, int16_t arg_count, int16_t arg_base_reg) noexcept;
         void handle_ret(uint16_t metadata, int16_t src_id) noexcept;
         // void handle_halt(int16_t metadata, int16_t src_id);
 
         HeapStorage m_heap;
+        std::string m_heap_snapshot_path;
         std::vector<Runtime::FastValue> m_memory;
         std::vector<Utils::CallFrame> m_call_frames;
 
@@ -107,6 +132,7 @@ namespace Minuet::Runtime::VM {
         int m_rbp;  // Contains the base point of the current register frame in memory
         int m_rft;  // Contains highest memory cell used
         int m_rsp;
+        int m_native_base; // Contains the absolute slot of the running native call's 1st argument & result
         int m_consts_n;
         int16_t m_rrd; // Counts 1-based recursion depth- 0 means done!
         uint8_t m_res;  // Contains execution status code
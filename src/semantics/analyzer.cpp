@@ -163,6 +163,27 @@ namespace Minuet::Semantics {
         };
     }
 
+    auto Analyzer::check_dictionary(const Syntax::Exprs::Dictionary& expr, const std::string& source) noexcept -> std::optional<SemanticItem> {
+        for (const auto& key_expr : expr.keys) {
+            if (!check_expr(key_expr, source).has_value()) {
+                return {};
+            }
+        }
+
+        for (const auto& value_expr : expr.values) {
+            if (!check_expr(value_expr, source).has_value()) {
+                return {};
+            }
+        }
+
+        return SemanticItem {
+            .extra = DudAttr {},
+            .entity_kind = Enums::EntityKinds::dictionary,
+            .value_group = Enums::ValueGroup::temporary,
+            .readonly = false,
+        };
+    }
+
     auto Analyzer::check_lambda(const Syntax::Exprs::Lambda& expr, const std::string& source) noexcept -> std::optional<SemanticItem> {
         report_error("Lambdas are currently unsupported.", source, expr.body->src_begin, expr.body->src_end);
 
@@ -257,7 +278,12 @@ namespace Minuet::Semantics {
 
                 has_special_access_case = true;
 
-                return (lhs_kind == EntityKinds::anything || lhs_kind == EntityKinds::sequence_fixed || lhs_kind == EntityKinds::sequence_flexible) && (rhs_kind == EntityKinds::anything || rhs_kind == EntityKinds::primitive);
+                /// NOTE: dicts (and unknown values which may be dicts) can also be keyed by strings or other objects.
+                if (lhs_kind == EntityKinds::anything || lhs_kind == EntityKinds::dictionary) {
+                    return rhs_kind != EntityKinds::callable;
+                }
+
+                return (lhs_kind == EntityKinds::sequence_fixed || lhs_kind == EntityKinds::sequence_flexible) && (rhs_kind == EntityKinds::anything || rhs_kind == EntityKinds::primitive);
             }
         })();
 
@@ -276,7 +302,7 @@ namespace Minuet::Semantics {
                 .extra = DudAttr {},
                 .entity_kind = EntityKinds::anything,
                 .value_group = Enums::ValueGroup::locator,
-                .readonly = false,
+                .readonly = lhs_info.entity_kind == EntityKinds::sequence_fixed,
             };
         }
 
@@ -318,6 +344,8 @@ namespace Minuet::Semantics {
             return check_literal(*literal_p, source);
         } else if (auto sequence_p = std::get_if<Syntax::Exprs::Sequence>(&expr_p->data); sequence_p) {
             return check_sequence(*sequence_p, source);
+        } else if (auto dictionary_p = std::get_if<Syntax::Exprs::Dictionary>(&expr_p->data); dictionary_p) {
+            return check_dictionary(*dictionary_p, source);
         } else if (auto lambda_p = std::get_if<Syntax::Exprs::Lambda>(&expr_p->data); lambda_p) {
             return check_lambda(*lambda_p, source);
         } else if (auto call_p = std::get_if<Syntax::Exprs::Call>(&expr_p->data); call_p) {
@@ -419,6 +447,37 @@ namespace Minuet::Semantics {
         return true;
     }
 
+    auto Analyzer::check_for(const Syntax::Stmts::For& stmt, const std::string& source) noexcept -> bool {
+        std::string item_name = source.substr(stmt.name.start, token_length(stmt.name));
+        const auto iterable_opt = check_expr(stmt.iterable, source);
+
+        if (!iterable_opt) {
+            return false;
+        }
+
+        if (const auto iterable_kind = iterable_opt.value().entity_kind; iterable_kind == Enums::EntityKinds::primitive || iterable_kind == Enums::EntityKinds::callable) {
+            report_error(stmt.name.line, std::format("Cannot iterate over a {} value in this for loop.", Enums::entity_kinds_to_sv(iterable_kind)));
+            return false;
+        }
+
+        // The item name only lives within the loop, so later loops may reuse it. Its items are copies, so it's read-only to avoid implying that assigning it updates the iterable.
+        if (!record_named_item(item_name, SemanticItem {
+            .extra = {},
+            .entity_kind = Enums::EntityKinds::anything,
+            .value_group = Enums::ValueGroup::locator,
+            .readonly = true,
+        })) {
+            report_error(stmt.name.line, std::format("Cannot redeclare variable name '{}' as a for loop item.", item_name));
+            return false;
+        }
+
+        const auto body_ok = check_stmt(stmt.body, source);
+
+        m_scopes.back().items.erase(item_name);
+
+        return body_ok;
+    }
+
     auto Analyzer::check_break([[maybe_unused]] const Syntax::Stmts::Break& stmt, [[maybe_unused]] const std::string& source) noexcept -> bool {
         return true;
     }
@@ -517,6 +576,8 @@ namespace Minuet::Semantics {
             return check_return(*ret_stmt_p, source);
         } else if (auto while_stmt_p = std::get_if<Syntax::Stmts::While>(&stmt_p->data); while_stmt_p) {
             return check_while(*while_stmt_p, source);
+        } else if (auto for_stmt_p = std::get_if<Syntax::Stmts::For>(&stmt_p->data); for_stmt_p) {
+            return check_for(*for_stmt_p, source);
         } else if (auto break_stmt_p = std::get_if<Syntax::Stmts::Break>(&stmt_p->data); break_stmt_p) {
             return check_break(*break_stmt_p, source);
         } else if (auto block_p = std::get_if<Syntax::Stmts::Block>(&stmt_p->data); block_p) {
@@ -34,12 +34,13 @@ namespace Minuet::Semantics {
     class Analyzer {
     private:
         /// Cross-lookup table for all 5 kinds by ops: access, negate, mul, div, mod, add, sub, equality, inequality, lesser, greater, at_most, at_least, assign... Compacts and hastens semantic checks for type-kinds by their valid operations.
-        static constexpr std::array<std::array<bool, 14>, 5> cm_table = {
+        static constexpr std::array<std::array<bool, 14>, 6> cm_table = {
             std::array<bool, 14> {true, true, true, true, true, true, true, true, true, true, true, true, true},
             std::array<bool, 14> {false, true, true, true, true, true, true, true, true, true, true, true, true}, // lookups for primitive kind
             {true, false, false, false, false, false, false, false, false, false, false, false, false, true}, // lookups for tuple kind
             {true, false, false, false, false, false, false, false, false, false, false, false, false, true}, // lookups for flexible kind
             {false, false, false, false, false, false, false, false, false, false, false, false, false, true}, // lookups for callable
+            {true, false, false, false, false, false, false, false, false, false, false, false, false, true}, // lookups for dict kind
         };
         std::vector<Scope> m_scopes;
         bool m_prepassing;
@@ -69,6 +70,7 @@ namespace Minuet::Semantics {
 
         [[nodiscard]] auto check_literal(const Syntax::Exprs::Literal& expr, const std::string& source) noexcept -> std::optional<SemanticItem>;
         [[nodiscard]] auto check_sequence(const Syntax::Exprs::Sequence& expr, const std::string& source) noexcept -> std::optional<SemanticItem>;
+        [[nodiscard]] auto check_dictionary(const Syntax::Exprs::Dictionary& expr, const std::string& source) noexcept -> std::optional<SemanticItem>;
         [[nodiscard]] auto check_lambda(const Syntax::Exprs::Lambda& expr, const std::string& source) noexcept -> std::optional<SemanticItem>;
         [[nodiscard]] auto check_call(const Syntax::Exprs::Call& expr, const std::string& source) noexcept -> std::optional<SemanticItem>;
         [[nodiscard]] auto check_unary(const Syntax::Exprs::Unary& expr, const std::string& source) noexcept -> std::optional<SemanticItem>;
@@ -83,6 +85,7 @@ namespace Minuet::Semantics {
         [[nodiscard]] auto check_if(const Syntax::Stmts::If& stmt, const std::string& source) noexcept -> bool;
         [[nodiscard]] auto check_return(const Syntax::Stmts::Return& stmt, const std::string& source) noexcept -> bool;
         [[nodiscard]] auto check_while(const Syntax::Stmts::While& stmt, const std::string& source) noexcept -> bool;
+        [[nodiscard]] auto check_for(const Syntax::Stmts::For& stmt, const std::string& source) noexcept -> bool;
         [[nodiscard]] auto check_break(const Syntax::Stmts::Break& stmt, const std::string& source) noexcept -> bool;
         [[nodiscard]] auto check_block(const Syntax::Stmts::Block& stmt, const std::string& source) noexcept -> bool;
         [[nodiscard]] auto check_function(const Syntax::Stmts::Function& stmt, const std::string& source) noexcept -> bool;
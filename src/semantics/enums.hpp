@@ -100,6 +100,7 @@ namespace Minuet::Semantics::Enums {
         sequence_fixed,
         sequence_flexible,
         callable,
+        dictionary,
     };
 
     [[nodiscard]] constexpr auto entity_kinds_to_sv(EntityKinds kinds) noexcept -> std::string_view {
@@ -108,6 +109,7 @@ namespace Minuet::Semantics::Enums {
             case EntityKinds::primitive: return "primitive";
             case EntityKinds::sequence_fixed: return "tuple";
             case EntityKinds::sequence_flexible: return "list";
+            case EntityKinds::dictionary: return "dict";
             case EntityKinds::callable: default: return "callable";
         }
     }
@@ -23,13 +23,14 @@ namespace Minuet::Syntax::Stmts {
     // struct MatchCase;
     struct Return;
     struct While;
+    struct For;
     struct Break;
     struct Block;
     struct Function;
     struct NativeStub;
     struct Import;
 
-    using StmtPtr = std::unique_ptr<StmtNode<ExprStmt, LocalDef, DetupDef, If, Return, While, Break, Block, Function, NativeStub, Import>>;
+    using StmtPtr = std::unique_ptr<StmtNode<ExprStmt, LocalDef, DetupDef, If, Return, While, For, Break, Block, Function, NativeStub, Import>>;
 }
 
 namespace Minuet::Syntax::Exprs {
@@ -37,13 +38,14 @@ namespace Minuet::Syntax::Exprs {
     struct ExprNode;
     struct Literal;
     struct Sequence;
+    struct Dictionary;
     struct Lambda;
     struct Call;
     struct Unary;
     struct Binary;
     struct Assign;
 
-    using ExprPtr = std::unique_ptr<ExprNode<Literal, Sequence, Lambda, Call, Unary, Binary, Assign>>;
+    using ExprPtr = std::unique_ptr<ExprNode<Literal, Sequence, Dictionary, Lambda, Call, Unary, Binary, Assign>>;
 
     struct Literal {
         Frontend::Lexicals::Token token;
@@ -54,6 +56,12 @@ namespace Minuet::Syntax::Exprs {
         bool is_tuple;
     };
 
+    /// NOTE: `keys[i]` maps to `values[i]`
+    struct Dictionary {
+        std::vector<ExprPtr> keys;
+        std::vector<ExprPtr> values;
+    };
+
     struct Lambda {
         std::vector<Frontend::Lexicals::Token> params;
         Stmts::StmtPtr body;
@@ -87,7 +95,7 @@ namespace Minuet::Syntax::Exprs {
         uint32_t src_end;
     };
 
-    using Expr = ExprNode<Literal, Sequence, Lambda, Call, Unary, Binary, Assign>;
+    using Expr = ExprNode<Literal, Sequence, Dictionary, Lambda, Call, Unary, Binary, Assign>;
 }
 
 #endif
@@ -17,6 +17,7 @@ namespace Minuet::Syntax::Stmts {
     // struct MatchCase;
     struct Return;
     struct While;
+    struct For;
     struct Break;
     struct Block;
     struct Function;
@@ -24,7 +25,7 @@ namespace Minuet::Syntax::Stmts {
     struct Import;
 
     // using StmtPtr = std::unique_ptr<StmtNode<ExprStmt, LocalDef, Match, MatchCase, Block, Function>>;
-    using StmtPtr = std::unique_ptr<StmtNode<ExprStmt, LocalDef, DetupDef, If, Return, While, Break, Block, Function, NativeStub, Import>>;
+    using StmtPtr = std::unique_ptr<StmtNode<ExprStmt, LocalDef, DetupDef, If, Return, While, For, Break, Block, Function, NativeStub, Import>>;
 
     struct ExprStmt {
         Exprs::ExprPtr expr;
@@ -55,6 +56,13 @@ namespace Minuet::Syntax::Stmts {
         Stmts::StmtPtr body;
     };
 
+    /// NOTE: represents a `for <name> in <iterable> <block>` loop over the items of a sequence, string, or packed array, or else the keys of a dict.
+    struct For {
+        Frontend::Lexicals::Token name;
+        Exprs::ExprPtr iterable;
+        Stmts::StmtPtr body;
+    };
+
     struct Break {};
 
     struct Block {
@@ -83,7 +91,7 @@ namespace Minuet::Syntax::Stmts {
         uint32_t src_end;
     };
 
-    using Stmt = StmtNode<ExprStmt, LocalDef, DetupDef, If, Return, While, Break, Block, Function, NativeStub, Import>;
+    using Stmt = StmtNode<ExprStmt, LocalDef, DetupDef, If, Return, While, For, Break, Block, Function, NativeStub, Import>;
 }
 
 #endif
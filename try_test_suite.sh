@@ -1,5 +1,5 @@
 handle_usage_and_exit() {
-    echo "USAGE:\n\n./try_test_suite.sh [help | run] [args...]\n\thelp []: prints usage information.\n\trun [neg | pos] [simple | unused]: runs the specified groups of test programs.\n";
+    echo "USAGE:\n\n./try_test_suite.sh [help | run] [args...]\n\thelp []: prints usage information.\n\trun [neg | pos] [simple | unused] [options...]: runs the specified groups of test programs, passing any options (e.g --opt-level=0) to each run.\n";
     exit $1;
 }
 
@@ -14,7 +14,7 @@ handle_suite_group() {
 
     for test_path in $tests
     do
-        ./build/src/minuetm run $test_path;
+        ./build/src/minuetm run "${@:3}" $test_path;
 
         if [[ $? -ne $check_status ]]; then
             echo "\033[1;31mFAILED on demo '$test_path'\033[0m";
@@ -34,8 +34,8 @@ handle_action() {
 
     if [[ $action = "help" ]]; then
         handle_usage_and_exit 0;
-    elif [[ $action = "run" && $argc -eq 3 ]]; then
-        handle_suite_group "$2" "$3"
+    elif [[ $action = "run" && $argc -ge 3 ]]; then
+        handle_suite_group "${@:2}"
     else
         handle_usage_and_exit 1;
     fi